@@ -1,4 +1,4 @@
-/* Copyright (c) 2020-2025, Arm Limited and Contributors
+/* Copyright (c) 2020-2026, Arm Limited and Contributors
  * Copyright (c) 2025, NVIDIA CORPORATION. All rights reserved.
  *
  * SPDX-License-Identifier: Apache-2.0
@@ -18,6 +18,7 @@
 
 #include "screenshot.h"
 
+#include <algorithm>
 #include <chrono>
 #include <iomanip>
 
@@ -29,9 +30,11 @@ namespace plugins
 Screenshot::Screenshot() :
     ScreenshotTags("Screenshot",
                    "Save a screenshot of a specific frame",
-                   {vkb::Hook::OnUpdate, vkb::Hook::OnAppStart, vkb::Hook::PostDraw},
+                   {vkb::Hook::OnUpdate, vkb::Hook::OnAppStart, vkb::Hook::OnAppClose, vkb::Hook::OnAppError, vkb::Hook::PostDraw},
                    {},
-                   {{"screenshot", "Take a screenshot at a given frame"}, {"screenshot-output", "Declare an output name for the image"}})
+                   {{"screenshot", "Take a screenshot at a given frame"},
+                    {"screenshot-output", "Declare an output name for the image"},
+                    {"screenshot-count", "Number of consecutive frames to capture, defaults to 1"}})
 {
 }
 
@@ -66,6 +69,19 @@ bool Screenshot::handle_option(std::deque<std::string> &arguments)
 		arguments.pop_front();
 		return true;
 	}
+	else if (option == "screenshot-count")
+	{
+		if (arguments.size() < 2)
+		{
+			LOGE("Option \"screenshot-count\" is missing the number of frames to capture!");
+			return false;
+		}
+		frame_count = std::max(static_cast<uint32_t>(std::stoul(arguments[1])), 1u);
+
+		arguments.pop_front();
+		arguments.pop_front();
+		return true;
+	}
 	return false;
 }
 
@@ -76,31 +92,66 @@ void Screenshot::on_update(float delta_time)
 
 void Screenshot::on_app_start(const std::string &name)
 {
+	// The readback of the previous app is released by the time its device is destroyed, see on_post_draw()
+	assert(!readback);
+
 	current_app_name = name;
 	current_frame    = 0;
 }
 
 void Screenshot::on_post_draw(vkb::rendering::RenderContextC &context)
 {
-	if (current_frame == frame_number)
+	if (current_frame == frame_number && !output_path_set)
 	{
-		if (!output_path_set)
-		{
-			// Create generic image path. <app name>-<current timestamp>.png
-			auto        timestamp = std::chrono::system_clock::now();
-			std::time_t now_tt    = std::chrono::system_clock::to_time_t(timestamp);
-			std::tm     tm        = *std::localtime(&now_tt);
+		// Create generic image path. <app name>-<current timestamp>.png
+		auto        timestamp = std::chrono::system_clock::now();
+		std::time_t now_tt    = std::chrono::system_clock::to_time_t(timestamp);
+		std::tm     tm        = *std::localtime(&now_tt);
 
-			char buffer[30];
-			strftime(buffer, sizeof(buffer), "%G-%m-%d---%H-%M-%S", &tm);
+		char buffer[30];
+		strftime(buffer, sizeof(buffer), "%G-%m-%d---%H-%M-%S", &tm);
 
-			std::stringstream stream;
-			stream << current_app_name << "-" << buffer;
+		std::stringstream stream;
+		stream << current_app_name << "-" << buffer;
 
-			output_path = stream.str();
+		output_path = stream.str();
+	}
+
+	if (current_frame >= frame_number && current_frame - frame_number < frame_count)
+	{
+		if (!readback)
+		{
+			readback = std::make_unique<vkb::rendering::FrameReadback>(context);
 		}
 
-		vkb::screenshot(context, output_path);
+		// Consecutive captures are told apart by their frame number
+		readback->capture(frame_count > 1 ? output_path + "-" + std::to_string(current_frame) : output_path);
+	}
+
+	if (readback)
+	{
+		if (current_frame >= frame_number && current_frame - frame_number + 1 >= frame_count)
+		{
+			// The last frame is captured, write the pending captures now,
+			// as the app may be replaced by the next one without being closed
+			readback.reset();
+		}
+		else
+		{
+			readback->collect();
+		}
 	}
 }
-}        // namespace plugins
\ No newline at end of file
+
+void Screenshot::on_app_close(const std::string &app_info)
+{
+	// Write the pending captures before the device is destroyed
+	readback.reset();
+}
+
+void Screenshot::on_app_error(const std::string &app_info)
+{
+	// The app is destroyed after a failure, drop the readback while its device is still alive
+	readback.reset();
+}
+}        // namespace plugins
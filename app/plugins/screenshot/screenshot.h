@@ -1,4 +1,4 @@
-/* Copyright (c) 2020-2025, Arm Limited and Contributors
+/* Copyright (c) 2020-2026, Arm Limited and Contributors
  * Copyright (c) 2025, NVIDIA CORPORATION. All rights reserved.
  *
  * SPDX-License-Identifier: Apache-2.0
@@ -20,6 +20,9 @@
 
 #include "filesystem/legacy.h"
 #include "platform/plugins/plugin_base.h"
+#include "rendering/frame_readback.h"
+
+#include <memory>
 
 namespace plugins
 {
@@ -31,8 +34,11 @@ using ScreenshotTags = vkb::PluginBase<Screenshot, vkb::tags::Passive>;
  * @brief Screenshot
  *
  * Capture a screen shot of the last rendered image at a given frame. The output can also be named
+ * A number of consecutive frames can be captured, their images are then suffixed with the frame number.
+ * The frames are read back and written to files asynchronously, so capturing every frame keeps the frame rate.
  *
  * Usage: vulkan_sample sample afbc --screenshot 1 --screenshot-output afbc-screenshot
+ *        vulkan_sample sample afbc --screenshot 1 --screenshot-count 100
  *
  */
 class Screenshot : public ScreenshotTags
@@ -45,15 +51,20 @@ class Screenshot : public ScreenshotTags
 	void on_update(float delta_time) override;
 	void on_app_start(const std::string &app_info) override;
 	void on_post_draw(vkb::rendering::RenderContextC &context) override;
+	void on_app_close(const std::string &app_info) override;
+	void on_app_error(const std::string &app_info) override;
 
 	bool handle_option(std::deque<std::string> &arguments) override;
 
   private:
 	uint32_t    current_frame = 0;
 	uint32_t    frame_number;
+	uint32_t    frame_count = 1;
 	std::string current_app_name;
 
 	bool        output_path_set = false;
 	std::string output_path;
+
+	std::unique_ptr<vkb::rendering::FrameReadback> readback;
 };
 }        // namespace plugins
\ No newline at end of file
@@ -53,6 +53,7 @@ class FileSystem
 	virtual std::vector<uint8_t> read_chunk(const Path &path, size_t offset, size_t count)      = 0;
 	virtual void                 write_file(const Path &path, const std::vector<uint8_t> &data) = 0;
 	virtual void                 remove(const Path &path)                                       = 0;
+	virtual void                 rename(const Path &from, const Path &to)                       = 0;
 
 	virtual void        set_external_storage_directory(const std::string &dir) = 0;
 	virtual const Path &external_storage_directory() const                     = 0;
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2025, Arm Limited and Contributors
+/* Copyright (c) 2019-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -138,5 +138,17 @@ void write_temp(const std::vector<uint8_t> &data, const std::string &filename);
  * @param row_stride The stride in bytes of a row of pixels
  */
 void write_image(const uint8_t *data, const std::string &filename, const uint32_t width, const uint32_t height, const uint32_t components, const uint32_t row_stride);
+
+/**
+ * @brief Helper to write the raw pixels of an image, with no header or compression, in permanent storage
+ *
+ * @param data       A pointer to the pixel data
+ * @param filename   The name of the image file without an extension
+ * @param width      The width of the image
+ * @param height     The height of the image
+ * @param components The number of bytes per element
+ * @param row_stride The stride in bytes of a row of pixels, the rows are written tightly packed
+ */
+void write_raw_image(const uint8_t *data, const std::string &filename, const uint32_t width, const uint32_t height, const uint32_t components, const uint32_t row_stride);
 }        // namespace fs
 }        // namespace vkb
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2025, Arm Limited and Contributors
+/* Copyright (c) 2019-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -137,5 +137,18 @@ void write_image(const uint8_t *data, const std::string &filename, const uint32_
 	stbi_write_png((path::get(path::Type::Screenshots) + filename + ".png").c_str(), width, height, components, data, row_stride);
 }
 
+void write_raw_image(const uint8_t *data, const std::string &filename, const uint32_t width, const uint32_t height, const uint32_t components, const uint32_t row_stride)
+{
+	const size_t row_size = static_cast<size_t>(width) * components;
+
+	std::vector<uint8_t> pixels(row_size * height);
+	for (uint32_t row = 0; row < height; ++row)
+	{
+		std::copy_n(data + static_cast<size_t>(row) * row_stride, row_size, pixels.begin() + row * row_size);
+	}
+
+	vkb::filesystem::get()->write_file(path::get(path::Type::Screenshots) + filename + ".raw", pixels);
+}
+
 }        // namespace fs
 }        // namespace vkb
@@ -140,6 +140,19 @@ void StdFileSystem::remove(const Path &path)
 	}
 }
 
+void StdFileSystem::rename(const Path &from, const Path &to)
+{
+	std::error_code ec;
+
+	// Replaces an existing file at the destination
+	std::filesystem::rename(from, to, ec);
+
+	if (ec)
+	{
+		throw std::runtime_error("Failed to rename file at path: " + from.string() + " to: " + to.string());
+	}
+}
+
 void StdFileSystem::set_external_storage_directory(const std::string &dir)
 {
 	_external_storage_directory = dir;
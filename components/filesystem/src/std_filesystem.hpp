@@ -49,6 +49,8 @@ class StdFileSystem final : public FileSystem
 
 	virtual void remove(const Path &path) override;
 
+	void rename(const Path &from, const Path &to) override;
+
 	virtual void set_external_storage_directory(const std::string &dir) override;
 
 	const Path &external_storage_directory() const override;
@@ -22,6 +22,10 @@
 #include "core/buffer.h"
 #include "core/device.h"
 
+#include <array>
+#include <bit>
+#include <unordered_map>
+
 namespace vkb
 {
 /**
@@ -293,7 +297,14 @@ vk::DeviceSize BufferBlock<bindingType>::determine_alignment(vk::BufferUsageFlag
  *
  * When a new frame starts, buffer blocks are returned: the offset is reset and contents are
  * overwritten. The minimum allocation size is 256 kb, if you ask for more you get a dedicated
- * buffer allocation.
+ * buffer allocation. Each RenderFrame owns its pools and only resets them once its fence is
+ * signaled, so the blocks of a pool behave as a ring fenced per frame in flight.
+ *
+ * Unused blocks are kept in free lists segregated by the log2 of their size, with a bitmask of
+ * the non-empty lists, so finding a block takes constant time. The largest unused block is handed
+ * out first, and every new block is twice as large as the previous one, up to max_block_growth
+ * times the block size. Frames with many allocations thus settle on a few large blocks instead
+ * of dozens of small ones.
  *
  * We re-use descriptor sets: we only need one for the corresponding buffer infos (and we only
  * have one VkBuffer per BufferBlock), then it is bound and we use dynamic offsets.
@@ -309,16 +320,35 @@ class BufferPool
 	BufferPool(
 	    vkb::core::Device<bindingType> &device, DeviceSizeType block_size, BufferUsageFlagsType usage, VmaMemoryUsage memory_usage = VMA_MEMORY_USAGE_CPU_TO_GPU);
 
+	/**
+	 * @brief Requests an unused block which can fit an allocation, building a new one if there is none
+	 * @param minimum_size The size of the allocation
+	 * @param minimal Whether the block must be exactly as large as the allocation
+	 * @return A block which is not used by any other request until the next reset
+	 */
 	BufferBlock<bindingType> &request_buffer_block(DeviceSizeType minimum_size, bool minimal = false);
 
 	void reset();
 
   private:
-	vkb::core::DeviceCpp                        &device;
-	std::vector<std::unique_ptr<BufferBlockCpp>> buffer_blocks;         /// List of blocks requested (need to be pointers in order to keep their address constant on vector resizing)
-	vk::DeviceSize                               block_size = 0;        /// Minimum size of the blocks
-	vk::BufferUsageFlags                         usage;
-	VmaMemoryUsage                               memory_usage{};
+	BufferBlockCpp &request_buffer_block_impl(vk::DeviceSize minimum_size, bool minimal);
+
+	/// @return The index of the free list holding unused blocks of the given size
+	static uint32_t size_class(vk::DeviceSize size);
+
+  private:
+	static constexpr vk::DeviceSize max_block_growth = 64;        /// Blocks grow up to this multiple of the block size
+
+	vkb::core::DeviceCpp                                             &device;
+	std::vector<std::unique_ptr<BufferBlockCpp>>                      buffer_blocks;              /// List of blocks requested (need to be pointers in order to keep their address constant on vector resizing)
+	std::array<std::vector<BufferBlockCpp *>, 64>                     free_blocks;                /// Unused blocks, segregated by the log2 of their size
+	uint64_t                                                          free_classes = 0;           /// Bit i is set if free_blocks[i] is not empty
+	std::unordered_map<vk::DeviceSize, std::vector<BufferBlockCpp *>> free_minimal_blocks;        /// Unused blocks built for a single allocation, by size
+	std::vector<std::pair<BufferBlockCpp *, bool>>                    used_blocks;                /// Blocks handed out since the last reset, and whether they are minimal
+	vk::DeviceSize                                                    block_size      = 0;        /// Minimum size of the blocks
+	vk::DeviceSize                                                    next_block_size = 0;        /// Size of the next block, doubling with every new block
+	vk::BufferUsageFlags                                              usage;
+	VmaMemoryUsage                                                    memory_usage{};
 };
 
 using BufferPoolC   = BufferPool<vkb::BindingType::C>;
@@ -329,37 +359,73 @@ BufferPool<bindingType>::BufferPool(vkb::core::Device<bindingType> &device,
                                     DeviceSizeType                  block_size,
                                     BufferUsageFlagsType            usage,
                                     VmaMemoryUsage                  memory_usage) :
-    device{reinterpret_cast<vkb::core::DeviceCpp &>(device)}, block_size{block_size}, usage{usage}, memory_usage{memory_usage}
+    device{reinterpret_cast<vkb::core::DeviceCpp &>(device)}, block_size{block_size}, next_block_size{block_size}, usage{usage}, memory_usage{memory_usage}
 {
 }
 
 template <vkb::BindingType bindingType>
 BufferBlock<bindingType> &BufferPool<bindingType>::request_buffer_block(DeviceSizeType minimum_size, bool minimal)
 {
-	// Find a block in the range of the blocks which can fit the minimum size
-	auto it = minimal ? std::ranges::find_if(buffer_blocks,
-	                                         [&minimum_size](auto const &buffer_block) { return (buffer_block->get_size() == minimum_size) && buffer_block->can_allocate(minimum_size); }) :
-	                    std::ranges::find_if(buffer_blocks,
-	                                         [&minimum_size](auto const &buffer_block) { return buffer_block->can_allocate(minimum_size); });
-
-	if (it == buffer_blocks.end())
+	if constexpr (bindingType == vkb::BindingType::Cpp)
 	{
-		LOGD("Building #{} buffer block ({})", buffer_blocks.size(), vk::to_string(usage));
+		return request_buffer_block_impl(minimum_size, minimal);
+	}
+	else
+	{
+		return reinterpret_cast<BufferBlockC &>(request_buffer_block_impl(static_cast<vk::DeviceSize>(minimum_size), minimal));
+	}
+}
 
-		vk::DeviceSize new_block_size = minimal ? minimum_size : std::max(block_size, minimum_size);
+template <vkb::BindingType bindingType>
+BufferBlockCpp &BufferPool<bindingType>::request_buffer_block_impl(vk::DeviceSize minimum_size, bool minimal)
+{
+	BufferBlockCpp *buffer_block = nullptr;
 
-		// Create a new block and get the iterator on it
-		it = buffer_blocks.emplace(buffer_blocks.end(), std::make_unique<BufferBlockCpp>(device, new_block_size, usage, memory_usage));
+	// Unused blocks are empty, so any of them at least as large as the minimum size fits
+	if (minimal)
+	{
+		auto it = free_minimal_blocks.find(minimum_size);
+		if (it != free_minimal_blocks.end() && !it->second.empty())
+		{
+			buffer_block = it->second.back();
+			it->second.pop_back();
+		}
 	}
-
-	if constexpr (bindingType == vkb::BindingType::Cpp)
+	else if (free_classes != 0)
 	{
-		return *it->get();
+		// Hand out the largest unused block, so that a frame fills as few blocks as possible
+		uint32_t largest = 63 - std::countl_zero(free_classes);
+		auto    &blocks  = free_blocks[largest];
+
+		if (blocks.back()->get_size() >= minimum_size)
+		{
+			buffer_block = blocks.back();
+			blocks.pop_back();
+
+			if (blocks.empty())
+			{
+				free_classes &= ~(uint64_t{1} << largest);
+			}
+		}
 	}
-	else
+
+	if (!buffer_block)
 	{
-		return reinterpret_cast<BufferBlockC &>(*it->get());
+		LOGD("Building #{} buffer block ({})", buffer_blocks.size(), vk::to_string(usage));
+
+		vk::DeviceSize new_block_size = minimal ? minimum_size : std::max(next_block_size, minimum_size);
+
+		if (!minimal)
+		{
+			next_block_size = std::min(next_block_size * 2, block_size * max_block_growth);
+		}
+
+		buffer_block = buffer_blocks.emplace_back(std::make_unique<BufferBlockCpp>(device, new_block_size, usage, memory_usage)).get();
 	}
+
+	used_blocks.emplace_back(buffer_block, minimal);
+
+	return *buffer_block;
 }
 
 template <vkb::BindingType bindingType>
@@ -368,10 +434,30 @@ void BufferPool<bindingType>::reset()
 	// Attention: Resetting the BufferPool is not supposed to clear the BufferBlocks, but just reset them!
 	//						The actual VkBuffers are used to hash the DescriptorSet in RenderFrame::request_descriptor_set.
 	//						Don't know (for now) how that works with resetted buffers!
-	for (auto &buffer_block : buffer_blocks)
+	for (auto &[buffer_block, minimal] : used_blocks)
 	{
 		buffer_block->reset();
+
+		if (minimal)
+		{
+			free_minimal_blocks[buffer_block->get_size()].push_back(buffer_block);
+		}
+		else
+		{
+			uint32_t index = size_class(buffer_block->get_size());
+			free_blocks[index].push_back(buffer_block);
+			free_classes |= uint64_t{1} << index;
+		}
 	}
+
+	used_blocks.clear();
+}
+
+template <vkb::BindingType bindingType>
+uint32_t BufferPool<bindingType>::size_class(vk::DeviceSize size)
+{
+	assert(size > 0 && "Buffer blocks cannot be empty");
+	return static_cast<uint32_t>(std::bit_width(size) - 1);
 }
 
 }        // namespace vkb
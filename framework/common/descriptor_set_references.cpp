@@ -0,0 +1,110 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "descriptor_set_references.h"
+
+namespace vkb
+{
+namespace
+{
+template <class Handle>
+void insert_reference(std::unordered_map<Handle, DescriptorSetReferences::Keys> &references, Handle handle, const ResourceKey &key)
+{
+	if (handle != VK_NULL_HANDLE)
+	{
+		references[handle].insert(&key);
+	}
+}
+
+template <class Handle>
+void erase_reference(std::unordered_map<Handle, DescriptorSetReferences::Keys> &references, Handle handle, const ResourceKey &key)
+{
+	auto it = references.find(handle);
+
+	if (it != references.end())
+	{
+		it->second.erase(&key);
+
+		if (it->second.empty())
+		{
+			references.erase(it);
+		}
+	}
+}
+
+template <class Handle>
+const DescriptorSetReferences::Keys *find_references(const std::unordered_map<Handle, DescriptorSetReferences::Keys> &references, Handle handle)
+{
+	auto it = references.find(handle);
+	return it != references.end() ? &it->second : nullptr;
+}
+}        // namespace
+
+void DescriptorSetReferences::insert(const ResourceKey &key, const BindingMap<VkDescriptorBufferInfo> &buffer_infos, const BindingMap<VkDescriptorImageInfo> &image_infos)
+{
+	for (auto &binding : buffer_infos)
+	{
+		for (auto &element : binding.second)
+		{
+			insert_reference(buffers, element.second.buffer, key);
+		}
+	}
+
+	for (auto &binding : image_infos)
+	{
+		for (auto &element : binding.second)
+		{
+			insert_reference(image_views, element.second.imageView, key);
+		}
+	}
+}
+
+void DescriptorSetReferences::erase(const ResourceKey &key, const BindingMap<VkDescriptorBufferInfo> &buffer_infos, const BindingMap<VkDescriptorImageInfo> &image_infos)
+{
+	for (auto &binding : buffer_infos)
+	{
+		for (auto &element : binding.second)
+		{
+			erase_reference(buffers, element.second.buffer, key);
+		}
+	}
+
+	for (auto &binding : image_infos)
+	{
+		for (auto &element : binding.second)
+		{
+			erase_reference(image_views, element.second.imageView, key);
+		}
+	}
+}
+
+void DescriptorSetReferences::clear()
+{
+	image_views.clear();
+	buffers.clear();
+}
+
+const DescriptorSetReferences::Keys *DescriptorSetReferences::find_image_view(VkImageView image_view) const
+{
+	return find_references(image_views, image_view);
+}
+
+const DescriptorSetReferences::Keys *DescriptorSetReferences::find_buffer(VkBuffer buffer) const
+{
+	return find_references(buffers, buffer);
+}
+}        // namespace vkb
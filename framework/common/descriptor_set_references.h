@@ -0,0 +1,70 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "common/resource_key.h"
+#include "common/vk_common.h"
+
+#include <unordered_map>
+#include <unordered_set>
+
+namespace vkb
+{
+/**
+ * @brief Reverse index from the image views and buffers written to the descriptor sets of the resource cache
+ *        to the keys of those descriptor sets.
+ *
+ * It lets the cache find the descriptor sets referring to a view or buffer without scanning all of them, when
+ * views are recreated with the swapchain or when a texture or buffer is destroyed. The keys are the ones stored
+ * in the map of descriptor sets, whose nodes never move. It must be accessed with the descriptor set mutex held.
+ */
+class DescriptorSetReferences
+{
+  public:
+	using Keys = std::unordered_set<const ResourceKey *>;
+
+	/**
+	 * @brief Adds the references of a descriptor set
+	 * @param key Key of the descriptor set in the cache
+	 * @param buffer_infos The buffers written to the descriptor set
+	 * @param image_infos The images written to the descriptor set
+	 */
+	void insert(const ResourceKey &key, const BindingMap<VkDescriptorBufferInfo> &buffer_infos, const BindingMap<VkDescriptorImageInfo> &image_infos);
+
+	/**
+	 * @brief Removes the references of a descriptor set, before its infos change or it is destroyed
+	 * @param key Key of the descriptor set in the cache
+	 * @param buffer_infos The buffers written to the descriptor set
+	 * @param image_infos The images written to the descriptor set
+	 */
+	void erase(const ResourceKey &key, const BindingMap<VkDescriptorBufferInfo> &buffer_infos, const BindingMap<VkDescriptorImageInfo> &image_infos);
+
+	void clear();
+
+	/// @return The keys of the descriptor sets referring to an image view, or nullptr if there are none
+	const Keys *find_image_view(VkImageView image_view) const;
+
+	/// @return The keys of the descriptor sets referring to a buffer, or nullptr if there are none
+	const Keys *find_buffer(VkBuffer buffer) const;
+
+  private:
+	std::unordered_map<VkImageView, Keys> image_views;
+
+	std::unordered_map<VkBuffer, Keys> buffers;
+};
+}        // namespace vkb
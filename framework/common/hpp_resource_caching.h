@@ -261,6 +261,92 @@ struct hash<vkb::rendering::RenderTargetCpp>
 
 namespace vkb
 {
+namespace
+{
+// The vulkan.hpp-based request arguments share the layout of their C counterparts, so their keys are built from those
+template <>
+inline void key_param<vk::PipelineCache>(ResourceKey & /*key*/, const vk::PipelineCache & /*value*/)
+{}
+
+template <>
+inline void key_param<vkb::core::HPPShaderSource>(ResourceKey &key, const vkb::core::HPPShaderSource &value)
+{
+	key_param(key, reinterpret_cast<vkb::ShaderSource const &>(value));
+}
+
+template <>
+inline void key_param<vkb::core::HPPShaderVariant>(ResourceKey &key, const vkb::core::HPPShaderVariant &value)
+{
+	key_param(key, reinterpret_cast<vkb::ShaderVariant const &>(value));
+}
+
+template <>
+inline void key_param<vkb::core::HPPDescriptorSetLayout>(ResourceKey &key, const vkb::core::HPPDescriptorSetLayout &value)
+{
+	key_param(key, reinterpret_cast<vkb::DescriptorSetLayout const &>(value));
+}
+
+template <>
+inline void key_param<vkb::core::HPPDescriptorPool>(ResourceKey &key, const vkb::core::HPPDescriptorPool &value)
+{
+	key_param(key, reinterpret_cast<vkb::DescriptorPool const &>(value));
+}
+
+template <>
+inline void key_param<vkb::core::HPPRenderPass>(ResourceKey &key, const vkb::core::HPPRenderPass &value)
+{
+	key_param(key, reinterpret_cast<vkb::RenderPass const &>(value));
+}
+
+template <>
+inline void key_param<std::vector<vkb::core::HPPShaderModule *>>(ResourceKey &key, const std::vector<vkb::core::HPPShaderModule *> &value)
+{
+	key_param(key, reinterpret_cast<std::vector<vkb::ShaderModule *> const &>(value));
+}
+
+template <>
+inline void key_param<std::vector<vkb::core::HPPShaderResource>>(ResourceKey &key, const std::vector<vkb::core::HPPShaderResource> &value)
+{
+	key_param(key, reinterpret_cast<std::vector<vkb::ShaderResource> const &>(value));
+}
+
+template <>
+inline void key_param<BindingMap<vk::DescriptorBufferInfo>>(ResourceKey &key, const BindingMap<vk::DescriptorBufferInfo> &value)
+{
+	key_param(key, reinterpret_cast<BindingMap<VkDescriptorBufferInfo> const &>(value));
+}
+
+template <>
+inline void key_param<BindingMap<vk::DescriptorImageInfo>>(ResourceKey &key, const BindingMap<vk::DescriptorImageInfo> &value)
+{
+	key_param(key, reinterpret_cast<BindingMap<VkDescriptorImageInfo> const &>(value));
+}
+
+template <>
+inline void key_param<std::vector<vkb::rendering::AttachmentCpp>>(ResourceKey &key, const std::vector<vkb::rendering::AttachmentCpp> &value)
+{
+	key_param(key, reinterpret_cast<std::vector<vkb::rendering::AttachmentC> const &>(value));
+}
+
+template <>
+inline void key_param<std::vector<vkb::common::HPPLoadStoreInfo>>(ResourceKey &key, const std::vector<vkb::common::HPPLoadStoreInfo> &value)
+{
+	key_param(key, reinterpret_cast<std::vector<vkb::LoadStoreInfo> const &>(value));
+}
+
+template <>
+inline void key_param<std::vector<vkb::core::HPPSubpassInfo>>(ResourceKey &key, const std::vector<vkb::core::HPPSubpassInfo> &value)
+{
+	key_param(key, reinterpret_cast<std::vector<vkb::SubpassInfo> const &>(value));
+}
+
+template <>
+inline void key_param<vkb::rendering::RenderTargetCpp>(ResourceKey &key, const vkb::rendering::RenderTargetCpp &value)
+{
+	key_param(key, reinterpret_cast<vkb::rendering::RenderTargetC const &>(value));
+}
+}        // namespace
+
 namespace common
 {
 /**
@@ -339,17 +425,16 @@ struct HPPRecordHelper<vkb::core::HPPGraphicsPipeline, A...>
 }        // namespace
 
 template <class T, class... A>
-T &request_resource(vkb::core::DeviceCpp          &device,
-                    vkb::HPPResourceRecord        *recorder,
-                    std::unordered_map<size_t, T> &resources,
+T &request_resource(vkb::core::DeviceCpp               &device,
+                    vkb::HPPResourceRecord             *recorder,
+                    std::unordered_map<ResourceKey, T> &resources,
                     A &...args)
 {
 	HPPRecordHelper<T, A...> record_helper;
 
-	size_t hash{0U};
-	hash_param(hash, args...);
+	ResourceKey key = make_resource_key(args...);
 
-	auto res_it = resources.find(hash);
+	auto res_it = resources.find(key);
 
 	if (res_it != resources.end())
 	{
@@ -369,7 +454,7 @@ T &request_resource(vkb::core::DeviceCpp          &device,
 #endif
 		T resource(device, args...);
 
-		auto res_ins_it = resources.emplace(hash, std::move(resource));
+		auto res_ins_it = resources.emplace(std::move(key), std::move(resource));
 
 		if (!res_ins_it.second)
 		{
@@ -0,0 +1,224 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "job_system.h"
+
+#include <algorithm>
+#include <exception>
+
+namespace vkb
+{
+namespace
+{
+// Job system and index of the worker running on this thread, if any
+thread_local const JobSystem *current_job_system = nullptr;
+thread_local size_t           current_worker     = 0;
+}        // namespace
+
+JobSystem::JobSystem(size_t thread_count)
+{
+	if (thread_count == 0)
+	{
+		thread_count = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	queues.reserve(thread_count);
+	for (size_t i = 0; i < thread_count; ++i)
+	{
+		queues.push_back(std::make_unique<JobQueue>());
+	}
+
+	workers.reserve(thread_count);
+	for (size_t i = 0; i < thread_count; ++i)
+	{
+		workers.emplace_back(&JobSystem::worker_loop, this, i);
+	}
+}
+
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard<std::mutex> lock(sleep_mutex);
+		stop = true;
+	}
+	wake_condition.notify_all();
+
+	for (auto &worker : workers)
+	{
+		worker.join();
+	}
+}
+
+JobSystem &JobSystem::get()
+{
+	static JobSystem job_system;
+	return job_system;
+}
+
+void JobSystem::parallel_for(size_t count, const std::function<void(size_t)> &func)
+{
+	if (count == 0)
+	{
+		return;
+	}
+
+	std::atomic<size_t> next_index{0};
+
+	// Every job takes indices until none are left, so the calling thread does all the work if the pool is busy
+	auto run_indices = [&]() {
+		for (size_t index = next_index.fetch_add(1); index < count; index = next_index.fetch_add(1))
+		{
+			func(index);
+		}
+	};
+
+	size_t job_count = std::min(count, workers.size()) - 1;
+
+	std::vector<std::future<void>> jobs;
+	jobs.reserve(job_count);
+
+	for (size_t i = 0; i < job_count; ++i)
+	{
+		jobs.push_back(submit(run_indices));
+	}
+
+	std::exception_ptr error;
+
+	try
+	{
+		run_indices();
+	}
+	catch (...)
+	{
+		error = std::current_exception();
+		next_index.store(count);
+	}
+
+	// Jobs which did not start yet return immediately, but they must run before the locals they refer to go away
+	for (auto &job : jobs)
+	{
+		try
+		{
+			wait(job);
+		}
+		catch (...)
+		{
+			if (!error)
+			{
+				error = std::current_exception();
+			}
+		}
+	}
+
+	if (error)
+	{
+		std::rethrow_exception(error);
+	}
+}
+
+size_t JobSystem::get_thread_count() const
+{
+	return workers.size();
+}
+
+void JobSystem::push(std::function<void()> &&job)
+{
+	size_t queue_index = current_job_system == this ? current_worker : next_queue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+
+	{
+		std::lock_guard<std::mutex> lock(queues[queue_index]->mutex);
+		queues[queue_index]->jobs.push_back(std::move(job));
+	}
+
+	{
+		// Taking the lock makes sure a worker about to sleep sees the new job
+		std::lock_guard<std::mutex> lock(sleep_mutex);
+		pending_count.fetch_add(1, std::memory_order_release);
+	}
+	wake_condition.notify_one();
+}
+
+bool JobSystem::run_pending_job()
+{
+	if (pending_count.load(std::memory_order_acquire) == 0)
+	{
+		return false;
+	}
+
+	size_t first = current_job_system == this ? current_worker : 0;
+
+	std::function<void()> job;
+
+	for (size_t i = 0; i < queues.size() && !job; ++i)
+	{
+		size_t queue_index = (first + i) % queues.size();
+		auto  &queue       = *queues[queue_index];
+
+		std::lock_guard<std::mutex> lock(queue.mutex);
+
+		if (queue.jobs.empty())
+		{
+			continue;
+		}
+
+		// Own jobs are taken from the back, as they are the most likely to be in the caches, others are stolen from the front
+		if (i == 0 && current_job_system == this)
+		{
+			job = std::move(queue.jobs.back());
+			queue.jobs.pop_back();
+		}
+		else
+		{
+			job = std::move(queue.jobs.front());
+			queue.jobs.pop_front();
+		}
+
+		pending_count.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	if (!job)
+	{
+		return false;
+	}
+
+	job();
+
+	return true;
+}
+
+void JobSystem::worker_loop(size_t worker_index)
+{
+	current_job_system = this;
+	current_worker     = worker_index;
+
+	while (true)
+	{
+		if (run_pending_job())
+		{
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(sleep_mutex);
+		wake_condition.wait(lock, [this]() { return stop || pending_count.load(std::memory_order_acquire) > 0; });
+
+		if (stop && pending_count.load(std::memory_order_acquire) == 0)
+		{
+			return;
+		}
+	}
+}
+}        // namespace vkb
@@ -0,0 +1,151 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace vkb
+{
+/**
+ * @brief A fixed set of worker threads running short jobs, shared by the whole framework.
+ *
+ * Every worker owns a queue of jobs: it runs the most recent job of its own queue first, and steals the oldest
+ * job of another queue when its own is empty. Jobs submitted from outside the pool are spread over the queues.
+ * The number of threads never exceeds the hardware concurrency, however many jobs are submitted.
+ *
+ * Threads waiting for jobs through wait() or parallel_for() run pending jobs meanwhile, so jobs may wait for
+ * other jobs without starving the pool.
+ */
+class JobSystem
+{
+  public:
+	/**
+	 * @param thread_count Number of worker threads, 0 to use one per hardware thread
+	 */
+	explicit JobSystem(size_t thread_count = 0);
+
+	JobSystem(const JobSystem &) = delete;
+
+	JobSystem(JobSystem &&) = delete;
+
+	~JobSystem();
+
+	JobSystem &operator=(const JobSystem &) = delete;
+
+	JobSystem &operator=(JobSystem &&) = delete;
+
+	/// @return The job system shared by the framework, created on first use
+	static JobSystem &get();
+
+	/**
+	 * @brief Schedules a job
+	 * @param job The function to run on a worker thread
+	 * @return A future holding the result of the job, which should be retrieved with wait()
+	 */
+	template <class F>
+	std::future<std::invoke_result_t<F>> submit(F &&job);
+
+	/**
+	 * @brief Runs pending jobs until a future is ready
+	 * @param future The future of a job
+	 * @return The result of the job
+	 */
+	template <class T>
+	T wait(std::future<T> &future);
+
+	/**
+	 * @brief Runs a function for every index in [0, count) on the pool and the calling thread, and waits for all of them
+	 * @param count Number of indices
+	 * @param func Function called with each index
+	 */
+	void parallel_for(size_t count, const std::function<void(size_t)> &func);
+
+	/// @return The number of worker threads
+	size_t get_thread_count() const;
+
+  private:
+	struct JobQueue
+	{
+		std::mutex                        mutex;
+		std::deque<std::function<void()>> jobs;
+	};
+
+	void push(std::function<void()> &&job);
+
+	/**
+	 * @brief Runs one pending job, from the queue of the calling worker first
+	 * @return False if there was no job to run
+	 */
+	bool run_pending_job();
+
+	void worker_loop(size_t worker_index);
+
+	std::vector<std::unique_ptr<JobQueue>> queues;
+
+	std::vector<std::thread> workers;
+
+	/// Number of jobs pushed and not yet taken by a thread
+	std::atomic<size_t> pending_count{0};
+
+	/// Queue receiving the next job submitted from outside the pool
+	std::atomic<size_t> next_queue{0};
+
+	std::mutex sleep_mutex;
+
+	std::condition_variable wake_condition;
+
+	bool stop{false};
+};
+
+template <class F>
+std::future<std::invoke_result_t<F>> JobSystem::submit(F &&job)
+{
+	using ResultType = std::invoke_result_t<F>;
+
+	auto task   = std::make_shared<std::packaged_task<ResultType()>>(std::forward<F>(job));
+	auto result = task->get_future();
+
+	push([task]() { (*task)(); });
+
+	return result;
+}
+
+template <class T>
+T JobSystem::wait(std::future<T> &future)
+{
+	while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+	{
+		if (!run_pending_job())
+		{
+			// The job is running on another thread
+			future.wait();
+		}
+	}
+
+	return future.get();
+}
+}        // namespace vkb
@@ -0,0 +1,178 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline_compile_queue.h"
+
+#include <algorithm>
+#include <exception>
+
+namespace vkb
+{
+PipelineCompileQueue::~PipelineCompileQueue()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stop = true;
+	}
+	work_condition.notify_one();
+
+	// The worker builds the queued pipelines before it stops
+	if (worker.joinable())
+	{
+		worker.join();
+	}
+}
+
+bool PipelineCompileQueue::push(const ResourceKey &key, std::function<void()> &&build)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	if (failed.count(key) > 0)
+	{
+		return false;
+	}
+
+	if (!pending.insert(key).second)
+	{
+		return true;
+	}
+
+	depth.fetch_add(1, std::memory_order_relaxed);
+
+	builds.emplace_back(key, std::move(build));
+
+	if (!worker.joinable())
+	{
+		worker = std::thread(&PipelineCompileQueue::worker_loop, this);
+	}
+
+	work_condition.notify_one();
+
+	return true;
+}
+
+void PipelineCompileQueue::worker_loop()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+
+	while (true)
+	{
+		work_condition.wait(lock, [this]() { return stop || !builds.empty(); });
+
+		if (builds.empty())
+		{
+			return;
+		}
+
+		auto [key, build] = std::move(builds.front());
+		builds.pop_front();
+
+		lock.unlock();
+
+		bool succeeded = true;
+
+		try
+		{
+			build();
+		}
+		catch (const std::exception &e)
+		{
+			LOGE("Failed to build a pipeline asynchronously: {}", e.what());
+			succeeded = false;
+		}
+
+		lock.lock();
+
+		pending.erase(key);
+		if (!succeeded)
+		{
+			failed.insert(key);
+		}
+
+		if (depth.fetch_sub(1, std::memory_order_relaxed) == 1)
+		{
+			idle_condition.notify_all();
+		}
+	}
+}
+
+size_t PipelineCompileQueue::get_depth() const
+{
+	return depth.load(std::memory_order_relaxed);
+}
+
+void PipelineCompileQueue::wait_idle()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	idle_condition.wait(lock, [this]() { return depth.load(std::memory_order_relaxed) == 0; });
+}
+
+void PipelineCompileQueue::clear()
+{
+	wait_idle();
+
+	std::lock_guard<std::mutex> lock(mutex);
+
+	failed.clear();
+	fallbacks.clear();
+}
+
+void PipelineCompileQueue::set_enabled(bool enable)
+{
+	enabled.store(enable, std::memory_order_relaxed);
+}
+
+bool PipelineCompileQueue::is_enabled() const
+{
+	return enabled.load(std::memory_order_relaxed);
+}
+
+void PipelineCompileQueue::register_fallback(VkPipelineLayout pipeline_layout, VkRenderPass render_pass, uint32_t subpass_index, VkPipeline pipeline)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	fallbacks[make_fallback_key(pipeline_layout, render_pass, subpass_index)] = pipeline;
+}
+
+VkPipeline PipelineCompileQueue::find_fallback(VkPipelineLayout pipeline_layout, VkRenderPass render_pass, uint32_t subpass_index) const
+{
+	ResourceKey key = make_fallback_key(pipeline_layout, render_pass, subpass_index);
+
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto it = fallbacks.find(key);
+	return it != fallbacks.end() ? it->second : VK_NULL_HANDLE;
+}
+
+bool PipelineCompileQueue::is_fallback(VkPipeline pipeline) const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	return std::any_of(fallbacks.begin(), fallbacks.end(), [pipeline](const auto &fallback) { return fallback.second == pipeline; });
+}
+
+ResourceKey PipelineCompileQueue::make_fallback_key(VkPipelineLayout pipeline_layout, VkRenderPass render_pass, uint32_t subpass_index)
+{
+	ResourceKey key;
+	key.append(pipeline_layout);
+	key.append(render_pass);
+	key.append(subpass_index);
+	key.finalize();
+
+	return key;
+}
+}        // namespace vkb
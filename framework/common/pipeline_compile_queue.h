@@ -0,0 +1,128 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "common/resource_key.h"
+#include "common/vk_common.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+namespace vkb
+{
+/**
+ * @brief Graphics pipelines of the resource cache being built on a worker thread, so that recording threads do not wait for them.
+ *
+ * The worker thread is owned by the queue rather than taken from the JobSystem: threads waiting for jobs of the JobSystem
+ * run other pending jobs meanwhile, so a render thread could otherwise end up building a pipeline in the middle of a frame.
+ * While asynchronous compilation is enabled, a command buffer requesting a graphics pipeline which is not in the cache yet
+ * queues its build here. Until it is built, draws using it are recorded with the fallback pipeline registered for its
+ * pipeline layout, render pass and subpass, or are skipped if there is none.
+ * The same pipeline is only queued once, and a pipeline whose build failed is not queued again, so that the caller
+ * builds it itself and reports the error.
+ */
+class PipelineCompileQueue
+{
+  public:
+	PipelineCompileQueue() = default;
+
+	PipelineCompileQueue(const PipelineCompileQueue &) = delete;
+
+	PipelineCompileQueue(PipelineCompileQueue &&) = delete;
+
+	~PipelineCompileQueue();
+
+	PipelineCompileQueue &operator=(const PipelineCompileQueue &) = delete;
+
+	PipelineCompileQueue &operator=(PipelineCompileQueue &&) = delete;
+
+	/**
+	 * @brief Queues the build of a pipeline on the worker thread, unless it is already queued
+	 * @param key Key of the pipeline in the resource cache
+	 * @param build Function building the pipeline and adding it to the resource cache
+	 * @return False if an earlier build of the pipeline failed
+	 */
+	bool push(const ResourceKey &key, std::function<void()> &&build);
+
+	/// @return The number of pipelines queued or being built
+	size_t get_depth() const;
+
+	/// @brief Waits for all queued builds
+	void wait_idle();
+
+	/// @brief Waits for all queued builds, and forgets the failed builds and the fallback pipelines
+	void clear();
+
+	/// @brief Enables or disables asynchronous compilation, disabled by default
+	void set_enabled(bool enabled);
+
+	bool is_enabled() const;
+
+	/**
+	 * @brief Registers the pipeline used by draws whose pipeline is being built
+	 *        It should only read vertex attributes which are read by all the pipelines it replaces
+	 */
+	void register_fallback(VkPipelineLayout pipeline_layout, VkRenderPass render_pass, uint32_t subpass_index, VkPipeline pipeline);
+
+	/// @return The fallback pipeline of a pipeline layout, render pass and subpass, or VK_NULL_HANDLE
+	VkPipeline find_fallback(VkPipelineLayout pipeline_layout, VkRenderPass render_pass, uint32_t subpass_index) const;
+
+	/// @return Whether a pipeline is registered as a fallback, in which case it must stay in the resource cache
+	bool is_fallback(VkPipeline pipeline) const;
+
+  private:
+	static ResourceKey make_fallback_key(VkPipelineLayout pipeline_layout, VkRenderPass render_pass, uint32_t subpass_index);
+
+	void worker_loop();
+
+	mutable std::mutex mutex;
+
+	/// Signaled when a build is queued, or when the worker should stop
+	std::condition_variable work_condition;
+
+	/// Signaled when the last queued build is done
+	std::condition_variable idle_condition;
+
+	std::atomic<bool> enabled{false};
+
+	std::atomic<size_t> depth{0};
+
+	/// Keys of the pipelines queued or being built
+	std::unordered_set<ResourceKey> pending;
+
+	/// Keys of the pipelines whose build threw an exception
+	std::unordered_set<ResourceKey> failed;
+
+	/// Builds waiting for the worker, in the order they were queued
+	std::deque<std::pair<ResourceKey, std::function<void()>>> builds;
+
+	/// Started by the first build queued
+	std::thread worker;
+
+	bool stop{false};
+
+	std::unordered_map<ResourceKey, VkPipeline> fallbacks;
+};
+}        // namespace vkb
@@ -0,0 +1,102 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace vkb
+{
+/**
+ * @brief Sorts items by a 64-bit key in ascending order, with a stable least significant digit radix sort
+ *
+ * The sort makes one pass per byte of the key, and skips the bytes which are equal in all keys.
+ * It allocates nothing once the scratch vector has grown to the size of the items, so both can be kept
+ * across frames to sort per-frame lists without allocating.
+ *
+ * @param items The items to sort
+ * @param scratch Storage for the passes, resized to the size of the items
+ * @param get_key Returns the 64-bit key of an item
+ */
+template <class T, class GetKey>
+void radix_sort(std::vector<T> &items, std::vector<T> &scratch, GetKey get_key)
+{
+	constexpr uint32_t digit_bits  = 8;
+	constexpr uint32_t digit_count = 1u << digit_bits;
+	constexpr uint32_t pass_count  = 64 / digit_bits;
+
+	const size_t count = items.size();
+	if (count < 2)
+	{
+		return;
+	}
+
+	// Histograms of all passes are computed in a single read of the keys
+	std::array<std::array<size_t, digit_count>, pass_count> histograms{};
+	for (const auto &item : items)
+	{
+		uint64_t key = get_key(item);
+		for (uint32_t pass = 0; pass < pass_count; pass++)
+		{
+			histograms[pass][(key >> (pass * digit_bits)) & (digit_count - 1)]++;
+		}
+	}
+
+	scratch.resize(count);
+
+	std::vector<T> *src = &items;
+	std::vector<T> *dst = &scratch;
+
+	for (uint32_t pass = 0; pass < pass_count; pass++)
+	{
+		auto &histogram = histograms[pass];
+
+		// All keys have the same digit, this pass would not move anything
+		uint64_t first_digit = (get_key((*src)[0]) >> (pass * digit_bits)) & (digit_count - 1);
+		if (histogram[first_digit] == count)
+		{
+			continue;
+		}
+
+		// Turn the histogram into the offsets where each digit starts
+		size_t offset = 0;
+		for (auto &digit_count_or_offset : histogram)
+		{
+			size_t digit_items    = digit_count_or_offset;
+			digit_count_or_offset = offset;
+			offset += digit_items;
+		}
+
+		for (auto &item : *src)
+		{
+			(*dst)[histogram[(get_key(item) >> (pass * digit_bits)) & (digit_count - 1)]++] = std::move(item);
+		}
+
+		std::swap(src, dst);
+	}
+
+	// An odd number of passes leaves the sorted items in the scratch storage
+	if (src != &items)
+	{
+		items.swap(scratch);
+	}
+}
+}        // namespace vkb
@@ -0,0 +1,742 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "common/resource_key.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace vkb
+{
+/**
+ * @brief Counters of the requests of one resource type in the resource cache
+ */
+struct ResourceCacheCounters
+{
+	/// Requests which found an existing object
+	std::atomic<uint64_t> hits{0};
+
+	/// Requests which had to build a new object
+	std::atomic<uint64_t> misses{0};
+
+	/// Requests which had to wait for another thread, either on the resource mutex or on an object being built
+	std::atomic<uint64_t> contended{0};
+
+	/// Objects removed by an eviction pass
+	std::atomic<uint64_t> evictions{0};
+
+	/// Objects currently in the cache
+	std::atomic<size_t> live_count{0};
+
+	/// Host memory held by the objects currently in the cache, an estimate which does not include device memory
+	std::atomic<size_t> bytes{0};
+};
+
+/**
+ * @brief Snapshot of the counters of one or more resource types
+ */
+struct ResourceCacheStats
+{
+	uint64_t hits{0};
+
+	uint64_t misses{0};
+
+	uint64_t contended{0};
+
+	uint64_t evictions{0};
+
+	size_t live_count{0};
+
+	size_t bytes{0};
+
+	/// Graphics pipelines queued or being built asynchronously
+	size_t pending_pipelines{0};
+};
+
+/**
+ * @brief Limits on the objects of one resource type, enforced by an eviction pass once per frame
+ */
+struct ResourceCacheLimit
+{
+	/// Objects unused for more frames than this are evicted, zero disables age-based eviction
+	uint32_t max_age{0};
+
+	/// Least recently used objects are evicted while there are more objects than this, zero means no limit
+	size_t max_count{0};
+};
+
+/**
+ * @brief Limits on the resource types of the resource cache which are evicted when unused.
+ *        The other resource types are shared by many objects and only removed when the cache is cleared.
+ */
+struct ResourceCacheBudget
+{
+	ResourceCacheLimit descriptor_sets{120, 0};
+
+	ResourceCacheLimit framebuffers{120, 0};
+
+	/// Pipelines are expensive to build again, so they are not evicted unless a limit is set
+	ResourceCacheLimit graphics_pipelines{};
+};
+
+/**
+ * @brief Lock-free index over the objects of one resource type in the resource cache.
+ *
+ * The objects themselves stay in the std::unordered_map of the ResourceCacheState, whose
+ * nodes never move. The index maps hashes to pointers to the entries of that map in an open
+ * addressing table of atomics, so lookups of existing objects do not take any lock. The full
+ * key of an entry is compared before it is returned, so two keys with the same 64-bit hash are
+ * never confused; they simply occupy consecutive slots.
+ * Each slot also holds the last frame its object was requested in, which the eviction pass uses
+ * to find objects which are no longer needed. A lookup racing with the growth of the table stamps
+ * the slot of the new table too, and the growth merges the stamps left on the previous table, so
+ * that no stamp is lost.
+ * Inserting and erasing must be done with the resource mutex held. When the table grows the
+ * previous one is retired, and kept alive until the next eviction pass or clear(), which run
+ * while no other thread uses the cache, or at least while no other thread builds objects of
+ * this type. Objects taken out of the cache outside of those are retired the same way, as a
+ * concurrent lookup may already have found them.
+ */
+template <class T>
+class ResourceCacheIndex
+{
+  public:
+	ResourceCacheIndex() = default;
+
+	ResourceCacheIndex(const ResourceCacheIndex &) = delete;
+
+	ResourceCacheIndex(ResourceCacheIndex &&) = delete;
+
+	ResourceCacheIndex &operator=(const ResourceCacheIndex &) = delete;
+
+	ResourceCacheIndex &operator=(ResourceCacheIndex &&) = delete;
+
+	using Entry = std::pair<const ResourceKey, T>;
+
+	using Node = typename std::unordered_map<ResourceKey, T>::node_type;
+
+	/**
+	 * @brief Looks up an object without taking any lock, and marks it as used in the current frame
+	 * @param key Key of the object
+	 * @return The object, or nullptr if it is not in the index
+	 */
+	T *find(const ResourceKey &key)
+	{
+		Table *current = table.load(std::memory_order_acquire);
+
+		if (!current)
+		{
+			return nullptr;
+		}
+
+		size_t hash = slot_hash(key);
+
+		Slot *slot = find_slot(*current, hash, key);
+
+		if (!slot)
+		{
+			return nullptr;
+		}
+
+		Entry *entry = slot->value.load(std::memory_order_acquire);
+
+		// The table may have been replaced while the slot was stamped, in which case grow() may have copied
+		// the previous stamp. Stamp the slot of the live table as well, so that evict() sees the object as used.
+		while (touch(*slot))
+		{
+			Table *live = table.load(std::memory_order_seq_cst);
+
+			if (live == current)
+			{
+				break;
+			}
+
+			current = live;
+			slot    = find_slot(*current, hash, key);
+
+			if (!slot)
+			{
+				// Taken out of the cache meanwhile
+				break;
+			}
+		}
+
+		return &entry->second;
+	}
+
+	/**
+	 * @brief Looks up an object without building it, counting a hit if it is found
+	 *        Used by requests which build missing objects later, the build then counts the miss
+	 * @param key Key of the object
+	 * @return The object, or nullptr if it is not in the index
+	 */
+	T *request_existing(const ResourceKey &key)
+	{
+		T *resource = find(key);
+
+		if (resource)
+		{
+			counters.hits.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		return resource;
+	}
+
+	/**
+	 * @brief Adds an object to the index, the resource mutex must be held
+	 * @param entry The entry of the object in the cache
+	 */
+	void insert(Entry &entry)
+	{
+		Table *current = table.load(std::memory_order_relaxed);
+
+		// Keep the load factor under one half, so that probing stays short
+		if (!current || (current->size + 1) * 2 > current->mask + 1)
+		{
+			current = grow(current ? (current->mask + 1) * 2 : initial_capacity);
+		}
+
+		insert(*current, slot_hash(entry.first), &entry, frame.load(std::memory_order_relaxed));
+
+		counters.live_count.fetch_add(1, std::memory_order_relaxed);
+		counters.bytes.fetch_add(entry_size(entry), std::memory_order_relaxed);
+	}
+
+	/**
+	 * @brief Removes an object from the index, the resource mutex must be held
+	 * @param key Key of the object
+	 */
+	void erase(const ResourceKey &key)
+	{
+		Table *current = table.load(std::memory_order_relaxed);
+
+		if (!current)
+		{
+			return;
+		}
+
+		size_t hash = slot_hash(key);
+
+		for (size_t i = hash & current->mask;; i = (i + 1) & current->mask)
+		{
+			Slot  &slot     = current->slots[i];
+			size_t slot_key = slot.key.load(std::memory_order_relaxed);
+
+			if (slot_key == empty_key)
+			{
+				return;
+			}
+
+			Entry *entry = slot.value.load(std::memory_order_relaxed);
+
+			if (slot_key == hash && entry && entry->first == key)
+			{
+				// Leave the hash in place, so that probing for other keys is not interrupted
+				slot.value.store(nullptr, std::memory_order_release);
+
+				counters.live_count.fetch_sub(1, std::memory_order_relaxed);
+				counters.bytes.fetch_sub(entry_size(*entry), std::memory_order_relaxed);
+				return;
+			}
+		}
+	}
+
+	/**
+	 * @brief Removes an object from the index and takes its node out of the cache, the resource mutex must be held.
+	 *        Lock-free lookups may already have found the entry, so the node must either go back into the cache
+	 *        or be passed to retire(), it must not be destroyed.
+	 * @param resources The objects of this type stored in the cache
+	 * @param it The object to take out
+	 * @return The node of the object
+	 */
+	Node extract(std::unordered_map<ResourceKey, T> &resources, typename std::unordered_map<ResourceKey, T>::iterator it)
+	{
+		erase(it->first);
+		return resources.extract(it);
+	}
+
+	/**
+	 * @brief Keeps a node taken out of the cache alive until the next eviction pass or clear(), the resource mutex must be held
+	 * @param node The node of the object
+	 */
+	void retire(Node &&node)
+	{
+		retired_nodes.push_back(std::move(node));
+	}
+
+	/**
+	 * @brief Removes all objects from the index
+	 *        No other thread may access the index at the same time
+	 */
+	void clear()
+	{
+		table.store(nullptr, std::memory_order_release);
+		tables.clear();
+		retired_nodes.clear();
+
+		counters.live_count.store(0, std::memory_order_relaxed);
+		counters.bytes.store(0, std::memory_order_relaxed);
+	}
+
+	/**
+	 * @brief Starts a new frame, objects requested from now on are marked as used in it
+	 *        No other thread may access the index at the same time
+	 */
+	void next_frame()
+	{
+		frame.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	/**
+	 * @return The current frame, which requested objects are marked as used in
+	 */
+	uint32_t get_frame() const
+	{
+		return frame.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * @brief Removes the objects exceeding a limit from the cache, least recently used first.
+	 *        No other thread may access the index at the same time.
+	 * @param resources The objects of this type stored in the cache
+	 * @param limit The limit to enforce
+	 * @param oldest_frame_in_flight Objects used in this frame or later are kept, as they may still be in use by the GPU
+	 * @param on_evict Function called with the entry of each object before it is destroyed
+	 * @return The number of evicted objects
+	 */
+	template <class EvictFunc>
+	size_t evict(std::unordered_map<ResourceKey, T> &resources, const ResourceCacheLimit &limit, uint32_t oldest_frame_in_flight, EvictFunc &&on_evict)
+	{
+		return evict(resources, limit, oldest_frame_in_flight, false, std::forward<EvictFunc>(on_evict), [](const Entry &) { return false; });
+	}
+
+	/**
+	 * @brief Removes the objects exceeding a limit from the cache, least recently used first.
+	 *        The resource mutex must be held. Other threads may only look up objects, if lookups_in_flight is set:
+	 *        the evicted nodes and the dropped tables are then retired, until a pass without lookups in flight.
+	 * @param resources The objects of this type stored in the cache
+	 * @param limit The limit to enforce
+	 * @param oldest_frame_in_flight Objects used in this frame or later are kept, as they may still be in use by the GPU
+	 * @param lookups_in_flight Whether other threads may be looking up objects meanwhile
+	 * @param on_evict Function called with the entry of each object before it is taken out of the cache
+	 * @param pinned Function returning whether the object of an entry must be kept in the cache
+	 * @return The number of evicted objects
+	 */
+	template <class EvictFunc, class PinnedFunc>
+	size_t evict(std::unordered_map<ResourceKey, T> &resources,
+	             const ResourceCacheLimit           &limit,
+	             uint32_t                            oldest_frame_in_flight,
+	             bool                                lookups_in_flight,
+	             EvictFunc                         &&on_evict,
+	             PinnedFunc                        &&pinned)
+	{
+		if (!lookups_in_flight)
+		{
+			// Lookups which found the nodes taken out of the cache during the last frame are over
+			retired_nodes.clear();
+		}
+
+		Table *current = table.load(std::memory_order_relaxed);
+
+		if (!current || (limit.max_age == 0 && limit.max_count == 0))
+		{
+			return 0;
+		}
+
+		uint32_t now = frame.load(std::memory_order_relaxed);
+
+		// Ages are compared rather than frame numbers, so that the frame counter may wrap around
+		uint32_t min_age = now - oldest_frame_in_flight + 1;
+
+		// Objects old enough to be evicted, as (age, slot) pairs
+		std::vector<std::pair<uint32_t, Slot *>> candidates;
+
+		for (size_t i = 0; i <= current->mask; ++i)
+		{
+			Slot &slot = current->slots[i];
+
+			if (slot.value.load(std::memory_order_relaxed))
+			{
+				uint32_t age = now - slot.last_used.load(std::memory_order_relaxed);
+
+				if (age >= min_age && !pinned(*slot.value.load(std::memory_order_relaxed)))
+				{
+					candidates.emplace_back(age, &slot);
+				}
+			}
+		}
+
+		// Oldest first
+		std::sort(candidates.begin(), candidates.end(), [](const auto &lhs, const auto &rhs) { return lhs.first > rhs.first; });
+
+		size_t excess = limit.max_count > 0 && resources.size() > limit.max_count ? resources.size() - limit.max_count : 0;
+
+		size_t evicted = 0;
+
+		for (auto &candidate : candidates)
+		{
+			if (excess == 0 && (limit.max_age == 0 || candidate.first <= limit.max_age))
+			{
+				break;
+			}
+
+			Entry *entry = candidate.second->value.load(std::memory_order_relaxed);
+			candidate.second->value.store(nullptr, std::memory_order_relaxed);
+
+			counters.live_count.fetch_sub(1, std::memory_order_relaxed);
+			counters.bytes.fetch_sub(entry_size(*entry), std::memory_order_relaxed);
+
+			on_evict(*entry);
+			if (lookups_in_flight)
+			{
+				retired_nodes.push_back(resources.extract(entry->first));
+			}
+			else
+			{
+				resources.erase(resources.find(entry->first));
+			}
+
+			excess = excess > 0 ? excess - 1 : 0;
+			++evicted;
+		}
+
+		if (evicted > 0)
+		{
+			counters.evictions.fetch_add(evicted, std::memory_order_relaxed);
+
+			// Drop the erased slots, and the tables retired since the last pass
+			size_t capacity = initial_capacity;
+			while (capacity < counters.live_count.load(std::memory_order_relaxed) * 4)
+			{
+				capacity *= 2;
+			}
+
+			grow(capacity);
+			if (!lookups_in_flight)
+			{
+				tables.erase(tables.begin(), tables.end() - 1);
+			}
+		}
+
+		return evicted;
+	}
+
+	/**
+	 * @brief Requests an object, building it if it is not in the cache yet.
+	 *        Hits take no lock. Misses take the resource mutex and, if build_unlocked is set, release it while
+	 *        building the object, so that different objects can be built concurrently. Other threads requesting
+	 *        the same object wait until it has been built.
+	 * @param key Key of the object
+	 * @param resource_mutex Mutex guarding the resources of this type
+	 * @param resources The objects of this type stored in the cache
+	 * @param build_unlocked Whether the object can be built without holding the resource mutex
+	 * @param build Function returning the new object
+	 * @param on_insert Function called with the entry of a new object, with the resource mutex held
+	 * @return The requested object
+	 */
+	template <class BuildFunc, class InsertFunc>
+	T &request(const ResourceKey &key, std::mutex &resource_mutex, std::unordered_map<ResourceKey, T> &resources, bool build_unlocked, BuildFunc &&build, InsertFunc &&on_insert)
+	{
+		if (T *resource = find(key))
+		{
+			counters.hits.fetch_add(1, std::memory_order_relaxed);
+			return *resource;
+		}
+
+		std::unique_lock<std::mutex> lock(resource_mutex, std::try_to_lock);
+
+		if (!lock.owns_lock())
+		{
+			counters.contended.fetch_add(1, std::memory_order_relaxed);
+			lock.lock();
+		}
+
+		// Another thread may be building the same object
+		if (pending.count(key) > 0)
+		{
+			counters.contended.fetch_add(1, std::memory_order_relaxed);
+			pending_built.wait(lock, [this, &key]() { return pending.count(key) == 0; });
+		}
+
+		// Another thread may have inserted the object meanwhile, this also marks it as used
+		if (T *resource = find(key))
+		{
+			counters.hits.fetch_add(1, std::memory_order_relaxed);
+			return *resource;
+		}
+
+		counters.misses.fetch_add(1, std::memory_order_relaxed);
+
+		typename std::unordered_map<ResourceKey, T>::iterator res_it;
+
+		if (build_unlocked)
+		{
+			pending.insert(key);
+			lock.unlock();
+
+			std::optional<T> resource;
+
+			try
+			{
+				resource.emplace(build());
+			}
+			catch (...)
+			{
+				lock.lock();
+				pending.erase(key);
+				pending_built.notify_all();
+				throw;
+			}
+
+			lock.lock();
+			pending.erase(key);
+			pending_built.notify_all();
+
+			res_it = resources.emplace(key, std::move(*resource)).first;
+		}
+		else
+		{
+			res_it = resources.emplace(key, build()).first;
+		}
+
+		insert(*res_it);
+
+		on_insert(*res_it);
+
+		return res_it->second;
+	}
+
+	const ResourceCacheCounters &get_counters() const
+	{
+		return counters;
+	}
+
+	/**
+	 * @brief Adds the counters of this index to a snapshot
+	 * @param stats The snapshot to add to
+	 */
+	void accumulate(ResourceCacheStats &stats) const
+	{
+		stats.hits += counters.hits.load(std::memory_order_relaxed);
+		stats.misses += counters.misses.load(std::memory_order_relaxed);
+		stats.contended += counters.contended.load(std::memory_order_relaxed);
+		stats.evictions += counters.evictions.load(std::memory_order_relaxed);
+		stats.live_count += counters.live_count.load(std::memory_order_relaxed);
+		stats.bytes += counters.bytes.load(std::memory_order_relaxed);
+	}
+
+  private:
+	static constexpr size_t empty_key = 0;
+
+	static constexpr size_t initial_capacity = 64;
+
+	struct Slot
+	{
+		std::atomic<size_t> key{empty_key};
+
+		std::atomic<Entry *> value{nullptr};
+
+		/// Frame the object was last requested in
+		std::atomic<uint32_t> last_used{0};
+	};
+
+	struct Table
+	{
+		explicit Table(size_t capacity) :
+		    mask{capacity - 1}, slots{new Slot[capacity]}
+		{}
+
+		size_t mask;
+
+		std::unique_ptr<Slot[]> slots;
+
+		/// Number of used slots, including erased ones
+		size_t size{0};
+	};
+
+	/// A hash of zero marks empty slots, keys with that hash are stored under another one, which is safe since full keys are compared
+	static size_t slot_hash(const ResourceKey &key)
+	{
+		size_t hash = key.get_hash();
+		return hash == empty_key ? 1 : hash;
+	}
+
+	static size_t entry_size(const Entry &entry)
+	{
+		return sizeof(Entry) + entry.first.get_heap_size();
+	}
+
+	/// @return The slot of an object in a table, or nullptr if it is not in the table
+	static Slot *find_slot(Table &target, size_t hash, const ResourceKey &key)
+	{
+		for (size_t i = hash & target.mask;; i = (i + 1) & target.mask)
+		{
+			Slot  &slot     = target.slots[i];
+			size_t slot_key = slot.key.load(std::memory_order_acquire);
+
+			if (slot_key == empty_key)
+			{
+				return nullptr;
+			}
+
+			if (slot_key == hash)
+			{
+				Entry *entry = slot.value.load(std::memory_order_acquire);
+
+				if (entry && entry->first == key)
+				{
+					return &slot;
+				}
+			}
+		}
+	}
+
+	/// @return Whether the slot was stamped, i.e. it was not marked as used in the current frame yet
+	bool touch(Slot &slot) const
+	{
+		uint32_t current_frame = frame.load(std::memory_order_relaxed);
+
+		// Avoid writing to the slot on every hit, so that its cache line is not bounced between threads
+		if (slot.last_used.load(std::memory_order_relaxed) == current_frame)
+		{
+			return false;
+		}
+
+		// Sequentially consistent with the publication of a new table and the merge of stamps in grow()
+		slot.last_used.store(current_frame, std::memory_order_seq_cst);
+		return true;
+	}
+
+	/// @return The more recent of two frames, in terms of age, so that the frame counter may wrap around
+	uint32_t most_recent(uint32_t lhs, uint32_t rhs) const
+	{
+		uint32_t now = frame.load(std::memory_order_relaxed);
+		return now - lhs < now - rhs ? lhs : rhs;
+	}
+
+	static void insert(Table &target, size_t key, Entry *value, uint32_t last_used)
+	{
+		for (size_t i = key & target.mask;; i = (i + 1) & target.mask)
+		{
+			Slot  &slot     = target.slots[i];
+			size_t slot_key = slot.key.load(std::memory_order_relaxed);
+
+			if (slot_key == key && !slot.value.load(std::memory_order_relaxed))
+			{
+				// Reuse a slot erased earlier
+				slot.last_used.store(last_used, std::memory_order_relaxed);
+				slot.value.store(value, std::memory_order_release);
+				return;
+			}
+
+			if (slot_key == empty_key)
+			{
+				// Publish the value before the key, readers finding the key then see the value
+				slot.last_used.store(last_used, std::memory_order_relaxed);
+				slot.value.store(value, std::memory_order_relaxed);
+				slot.key.store(key, std::memory_order_release);
+				++target.size;
+				return;
+			}
+		}
+	}
+
+	/// Moves the objects to a new table of the given capacity, the previous table is retired
+	Table *grow(size_t capacity)
+	{
+		Table *current = table.load(std::memory_order_relaxed);
+
+		auto new_table = std::make_unique<Table>(capacity);
+
+		if (current)
+		{
+			for (size_t i = 0; i <= current->mask; ++i)
+			{
+				Slot &slot = current->slots[i];
+
+				if (Entry *value = slot.value.load(std::memory_order_relaxed))
+				{
+					insert(*new_table, slot.key.load(std::memory_order_relaxed), value, slot.last_used.load(std::memory_order_relaxed));
+				}
+			}
+		}
+
+		table.store(new_table.get(), std::memory_order_seq_cst);
+
+		if (current)
+		{
+			// Lookups which did not see the new table yet may have stamped the slots of the previous one after
+			// they were copied, those stamps are merged now that any later lookup stamps the new table itself
+			for (size_t i = 0; i <= current->mask; ++i)
+			{
+				Slot &slot = current->slots[i];
+
+				if (Entry *value = slot.value.load(std::memory_order_relaxed))
+				{
+					Slot *new_slot = find_slot(*new_table, slot.key.load(std::memory_order_relaxed), value->first);
+					assert(new_slot);
+
+					// Lookups may stamp the new slot meanwhile, their stamp must not be overwritten by an older one
+					uint32_t last_used = slot.last_used.load(std::memory_order_seq_cst);
+					uint32_t expected  = new_slot->last_used.load(std::memory_order_relaxed);
+					while (most_recent(last_used, expected) != expected)
+					{
+						if (new_slot->last_used.compare_exchange_weak(expected, last_used, std::memory_order_relaxed))
+						{
+							break;
+						}
+					}
+				}
+			}
+		}
+
+		tables.push_back(std::move(new_table));
+
+		return tables.back().get();
+	}
+
+	std::atomic<Table *> table{nullptr};
+
+	/// Current and retired tables
+	std::vector<std::unique_ptr<Table>> tables;
+
+	/// Nodes taken out of the cache, kept alive for lookups which may still refer to them
+	std::vector<Node> retired_nodes;
+
+	/// Current frame, stamped on the slots of requested objects
+	std::atomic<uint32_t> frame{0};
+
+	/// Keys of the objects being built outside of the resource mutex
+	std::unordered_set<ResourceKey> pending;
+
+	std::condition_variable pending_built;
+
+	ResourceCacheCounters counters;
+};
+}        // namespace vkb
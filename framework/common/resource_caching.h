@@ -29,6 +29,9 @@
 #include "resource_record.h"
 
 #include "common/helpers.h"
+#include "common/resource_key.h"
+#include <algorithm>
+#include <string_view>
 #include <vulkan/vulkan_hash.hpp>
 
 namespace std
@@ -585,7 +588,7 @@ inline void hash_param(size_t & /*seed*/, const VkPipelineCache & /*value*/)
 template <>
 inline void hash_param<std::vector<uint8_t>>(size_t &seed, const std::vector<uint8_t> &value)
 {
-	hash_combine(seed, std::string{value.begin(), value.end()});
+	hash_combine(seed, std::string_view{reinterpret_cast<const char *>(value.data()), value.size()});
 }
 
 template <>
@@ -674,6 +677,245 @@ inline void hash_param(size_t &seed, const T &first_arg, const Args &...args)
 	hash_param(seed, args...);
 }
 
+/**
+ * @brief Appends a request argument to a resource key
+ *        Scalars, enums and handles are appended as they are, every other argument type
+ *        has a specialization appending the fields which identify the object
+ */
+template <typename T>
+inline void key_param(ResourceKey &key, const T &value)
+{
+	key.append(value);
+}
+
+template <>
+inline void key_param(ResourceKey & /*key*/, const VkPipelineCache & /*value*/)
+{}
+
+template <>
+inline void key_param<std::string>(ResourceKey &key, const std::string &value)
+{
+	key.append(value);
+}
+
+template <>
+inline void key_param<ShaderSource>(ResourceKey &key, const ShaderSource &value)
+{
+	// The id is only a std::hash of the source, so the text itself is part of the key
+	key.append(value.get_filename());
+	key.append(value.get_source());
+}
+
+template <>
+inline void key_param<ShaderVariant>(ResourceKey &key, const ShaderVariant &value)
+{
+	key.append(value.get_id());
+
+	// Sort the runtime array sizes so that the key does not depend on the map iteration order
+	std::vector<std::pair<std::string, size_t>> runtime_array_sizes{value.get_runtime_array_sizes().begin(),
+	                                                                value.get_runtime_array_sizes().end()};
+	std::sort(runtime_array_sizes.begin(), runtime_array_sizes.end());
+
+	key.append(runtime_array_sizes.size());
+	for (auto &runtime_array_size : runtime_array_sizes)
+	{
+		key.append(runtime_array_size.first);
+		key.append(runtime_array_size.second);
+	}
+}
+
+template <>
+inline void key_param<DescriptorSetLayout>(ResourceKey &key, const DescriptorSetLayout &value)
+{
+	key.append(value.get_handle());
+}
+
+template <>
+inline void key_param<DescriptorPool>(ResourceKey &key, const DescriptorPool &value)
+{
+	// There is one pool per descriptor set layout in the cache
+	key.append(value.get_descriptor_set_layout().get_handle());
+}
+
+template <>
+inline void key_param<RenderPass>(ResourceKey &key, const RenderPass &value)
+{
+	key.append(value.get_handle());
+}
+
+template <>
+inline void key_param<std::vector<ShaderModule *>>(ResourceKey &key, const std::vector<ShaderModule *> &value)
+{
+	key.append(value.size());
+	for (auto &shader_module : value)
+	{
+		// The id is only a std::hash of the SPIR-V, so the binary itself is part of the key
+		auto &spirv = shader_module->get_binary();
+		key.append(shader_module->get_stage());
+		key.append(shader_module->get_entry_point());
+		key.append(spirv.size());
+		key.append(spirv.data(), spirv.size() * sizeof(uint32_t));
+	}
+}
+
+template <>
+inline void key_param<std::vector<ShaderResource>>(ResourceKey &key, const std::vector<ShaderResource> &value)
+{
+	for (auto &resource : value)
+	{
+		if (resource.type == ShaderResourceType::Input ||
+		    resource.type == ShaderResourceType::Output ||
+		    resource.type == ShaderResourceType::PushConstant ||
+		    resource.type == ShaderResourceType::SpecializationConstant)
+		{
+			continue;
+		}
+
+		key.append(resource.set);
+		key.append(resource.binding);
+		key.append(resource.type);
+		key.append(resource.mode);
+	}
+}
+
+template <>
+inline void key_param<BindingMap<VkDescriptorBufferInfo>>(ResourceKey &key, const BindingMap<VkDescriptorBufferInfo> &value)
+{
+	key.append(value.size());
+	for (auto &binding_set : value)
+	{
+		key.append(binding_set.first);
+		key.append(binding_set.second.size());
+
+		for (auto &binding_element : binding_set.second)
+		{
+			key.append(binding_element.first);
+			key.append(binding_element.second.buffer);
+			key.append(binding_element.second.offset);
+			key.append(binding_element.second.range);
+		}
+	}
+}
+
+template <>
+inline void key_param<BindingMap<VkDescriptorImageInfo>>(ResourceKey &key, const BindingMap<VkDescriptorImageInfo> &value)
+{
+	key.append(value.size());
+	for (auto &binding_set : value)
+	{
+		key.append(binding_set.first);
+		key.append(binding_set.second.size());
+
+		for (auto &binding_element : binding_set.second)
+		{
+			key.append(binding_element.first);
+			key.append(binding_element.second.sampler);
+			key.append(binding_element.second.imageView);
+			key.append(binding_element.second.imageLayout);
+		}
+	}
+}
+
+template <>
+inline void key_param<std::vector<vkb::rendering::AttachmentC>>(ResourceKey &key, const std::vector<vkb::rendering::AttachmentC> &value)
+{
+	key.append(value.size());
+	for (auto &attachment : value)
+	{
+		key.append(attachment.format);
+		key.append(attachment.samples);
+		key.append(attachment.usage);
+		key.append(attachment.initial_layout);
+	}
+}
+
+template <>
+inline void key_param<std::vector<LoadStoreInfo>>(ResourceKey &key, const std::vector<LoadStoreInfo> &value)
+{
+	key.append(value.size());
+	for (auto &load_store_info : value)
+	{
+		key.append(load_store_info.load_op);
+		key.append(load_store_info.store_op);
+	}
+}
+
+template <>
+inline void key_param<std::vector<uint32_t>>(ResourceKey &key, const std::vector<uint32_t> &value)
+{
+	key.append(value.size());
+	key.append(value.data(), value.size() * sizeof(uint32_t));
+}
+
+template <>
+inline void key_param<std::vector<SubpassInfo>>(ResourceKey &key, const std::vector<SubpassInfo> &value)
+{
+	key.append(value.size());
+	for (auto &subpass_info : value)
+	{
+		key_param(key, subpass_info.input_attachments);
+		key_param(key, subpass_info.output_attachments);
+		key_param(key, subpass_info.color_resolve_attachments);
+		key.append(subpass_info.disable_depth_stencil_attachment);
+		key.append(subpass_info.depth_stencil_resolve_attachment);
+		key.append(subpass_info.depth_stencil_resolve_mode);
+	}
+}
+
+template <>
+inline void key_param<vkb::rendering::RenderTargetC>(ResourceKey &key, const vkb::rendering::RenderTargetC &value)
+{
+	key.append(value.get_views().size());
+	for (auto const &view : value.get_views())
+	{
+		key.append(view.get_handle());
+		key.append(view.get_image().get_handle());
+	}
+}
+
+template <>
+inline void key_param<vkb::rendering::PipelineStateCpp>(ResourceKey &key, const vkb::rendering::PipelineStateCpp &pipeline_state)
+{
+	vkb::rendering::append_to_key(key, pipeline_state.get_color_blend_state());
+	vkb::rendering::append_to_key(key, pipeline_state.get_depth_stencil_state());
+	vkb::rendering::append_to_key(key, pipeline_state.get_input_assembly_state());
+	vkb::rendering::append_to_key(key, pipeline_state.get_multisample_state());
+	vkb::rendering::append_to_key(key, &pipeline_state.get_pipeline_layout());
+	vkb::rendering::append_to_key(key, pipeline_state.get_rasterization_state());
+	// For graphics only
+	vkb::rendering::append_to_key(key, pipeline_state.get_render_pass());
+	vkb::rendering::append_to_key(key, pipeline_state.get_specialization_constant_state());
+	key.append(pipeline_state.get_subpass_index());
+	vkb::rendering::append_to_key(key, pipeline_state.get_vertex_input_state());
+	vkb::rendering::append_to_key(key, pipeline_state.get_viewport_state());
+}
+
+template <>
+inline void key_param<vkb::rendering::PipelineStateC>(ResourceKey &key, const vkb::rendering::PipelineStateC &pipeline_state)
+{
+	key_param(key, reinterpret_cast<vkb::rendering::PipelineStateCpp const &>(pipeline_state));
+}
+
+template <typename T, typename... Args>
+inline void key_param(ResourceKey &key, const T &first_arg, const Args &...args)
+{
+	key_param(key, first_arg);
+
+	key_param(key, args...);
+}
+
+/**
+ * @brief Builds the key of a resource from the arguments used to request it
+ */
+template <typename... Args>
+inline ResourceKey make_resource_key(const Args &...args)
+{
+	ResourceKey key;
+	key_param(key, args...);
+	key.finalize();
+	return key;
+}
+
 template <class T, class... A>
 struct RecordHelper
 {
@@ -746,15 +988,14 @@ struct RecordHelper<GraphicsPipeline, A...>
 template <class T, class... A>
 T &request_resource(vkb::core::DeviceC                 &device,
                     ResourceRecord                     *recorder,
-                    std::unordered_map<std::size_t, T> &resources,
+                    std::unordered_map<ResourceKey, T> &resources,
                     A &...args)
 {
 	RecordHelper<T, A...> record_helper;
 
-	std::size_t hash{0U};
-	hash_param(hash, args...);
+	ResourceKey key = make_resource_key(args...);
 
-	auto res_it = resources.find(hash);
+	auto res_it = resources.find(key);
 
 	if (res_it != resources.end())
 	{
@@ -774,7 +1015,7 @@ T &request_resource(vkb::core::DeviceC                 &device,
 #endif
 		T resource(device, args...);
 
-		auto res_ins_it = resources.emplace(hash, std::move(resource));
+		auto res_ins_it = resources.emplace(std::move(key), std::move(resource));
 
 		if (!res_ins_it.second)
 		{
@@ -0,0 +1,231 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "resource_key.h"
+
+namespace vkb
+{
+namespace
+{
+inline uint64_t rotl64(uint64_t x, int8_t r)
+{
+	return (x << r) | (x >> (64 - r));
+}
+
+inline uint64_t fmix64(uint64_t k)
+{
+	k ^= k >> 33;
+	k *= 0xff51afd7ed558ccdULL;
+	k ^= k >> 33;
+	k *= 0xc4ceb9fe1a85ec53ULL;
+	k ^= k >> 33;
+
+	return k;
+}
+
+inline uint64_t load64(const uint8_t *data)
+{
+	uint64_t value;
+	std::memcpy(&value, data, sizeof(uint64_t));
+	return value;
+}
+}        // namespace
+
+std::array<uint64_t, 2> hash128(const void *data, size_t size, uint64_t seed)
+{
+	const uint8_t *bytes  = static_cast<const uint8_t *>(data);
+	const size_t   blocks = size / 16;
+
+	uint64_t h1 = seed;
+	uint64_t h2 = seed;
+
+	const uint64_t c1 = 0x87c37b91114253d5ULL;
+	const uint64_t c2 = 0x4cf5ad432745937fULL;
+
+	for (size_t i = 0; i < blocks; ++i)
+	{
+		uint64_t k1 = load64(bytes + i * 16);
+		uint64_t k2 = load64(bytes + i * 16 + 8);
+
+		k1 *= c1;
+		k1 = rotl64(k1, 31);
+		k1 *= c2;
+		h1 ^= k1;
+
+		h1 = rotl64(h1, 27);
+		h1 += h2;
+		h1 = h1 * 5 + 0x52dce729;
+
+		k2 *= c2;
+		k2 = rotl64(k2, 33);
+		k2 *= c1;
+		h2 ^= k2;
+
+		h2 = rotl64(h2, 31);
+		h2 += h1;
+		h2 = h2 * 5 + 0x38495ab5;
+	}
+
+	// Tail, fewer than 16 bytes left
+	const uint8_t *tail = bytes + blocks * 16;
+
+	uint64_t k1 = 0;
+	uint64_t k2 = 0;
+
+	switch (size & 15)
+	{
+		case 15:
+			k2 ^= static_cast<uint64_t>(tail[14]) << 48;
+			[[fallthrough]];
+		case 14:
+			k2 ^= static_cast<uint64_t>(tail[13]) << 40;
+			[[fallthrough]];
+		case 13:
+			k2 ^= static_cast<uint64_t>(tail[12]) << 32;
+			[[fallthrough]];
+		case 12:
+			k2 ^= static_cast<uint64_t>(tail[11]) << 24;
+			[[fallthrough]];
+		case 11:
+			k2 ^= static_cast<uint64_t>(tail[10]) << 16;
+			[[fallthrough]];
+		case 10:
+			k2 ^= static_cast<uint64_t>(tail[9]) << 8;
+			[[fallthrough]];
+		case 9:
+			k2 ^= static_cast<uint64_t>(tail[8]);
+			k2 *= c2;
+			k2 = rotl64(k2, 33);
+			k2 *= c1;
+			h2 ^= k2;
+			[[fallthrough]];
+		case 8:
+			k1 ^= static_cast<uint64_t>(tail[7]) << 56;
+			[[fallthrough]];
+		case 7:
+			k1 ^= static_cast<uint64_t>(tail[6]) << 48;
+			[[fallthrough]];
+		case 6:
+			k1 ^= static_cast<uint64_t>(tail[5]) << 40;
+			[[fallthrough]];
+		case 5:
+			k1 ^= static_cast<uint64_t>(tail[4]) << 32;
+			[[fallthrough]];
+		case 4:
+			k1 ^= static_cast<uint64_t>(tail[3]) << 24;
+			[[fallthrough]];
+		case 3:
+			k1 ^= static_cast<uint64_t>(tail[2]) << 16;
+			[[fallthrough]];
+		case 2:
+			k1 ^= static_cast<uint64_t>(tail[1]) << 8;
+			[[fallthrough]];
+		case 1:
+			k1 ^= static_cast<uint64_t>(tail[0]);
+			k1 *= c1;
+			k1 = rotl64(k1, 31);
+			k1 *= c2;
+			h1 ^= k1;
+			break;
+		default:
+			break;
+	}
+
+	h1 ^= static_cast<uint64_t>(size);
+	h2 ^= static_cast<uint64_t>(size);
+
+	h1 += h2;
+	h2 += h1;
+
+	h1 = fmix64(h1);
+	h2 = fmix64(h2);
+
+	h1 += h2;
+	h2 += h1;
+
+	return {h1, h2};
+}
+
+void ResourceKey::append(const void *data, size_t size)
+{
+	const uint8_t *bytes = static_cast<const uint8_t *>(data);
+
+	if (heap_data.empty() && data_size + size <= inline_capacity)
+	{
+		std::memcpy(inline_data.data() + data_size, bytes, size);
+	}
+	else
+	{
+		if (heap_data.empty())
+		{
+			// Move to the heap the first time the key outgrows the inline storage
+			heap_data.reserve(2 * (data_size + size));
+			heap_data.assign(inline_data.begin(), inline_data.begin() + data_size);
+		}
+
+		heap_data.insert(heap_data.end(), bytes, bytes + size);
+	}
+
+	data_size += size;
+}
+
+void ResourceKey::append(const std::string &value)
+{
+	append(value.size());
+	append(value.data(), value.size());
+}
+
+void ResourceKey::finalize()
+{
+	hash = hash128(data(), data_size);
+}
+
+size_t ResourceKey::get_hash() const
+{
+	return static_cast<size_t>(hash[0]);
+}
+
+const std::array<uint64_t, 2> &ResourceKey::get_hash128() const
+{
+	return hash;
+}
+
+const uint8_t *ResourceKey::data() const
+{
+	return heap_data.empty() ? inline_data.data() : heap_data.data();
+}
+
+size_t ResourceKey::size() const
+{
+	return data_size;
+}
+
+size_t ResourceKey::get_heap_size() const
+{
+	return heap_data.capacity();
+}
+
+bool ResourceKey::operator==(const ResourceKey &other) const
+{
+	return hash == other.hash && data_size == other.data_size && std::memcmp(data(), other.data(), data_size) == 0;
+}
+
+bool ResourceKey::operator!=(const ResourceKey &other) const
+{
+	return !(*this == other);
+}
+}        // namespace vkb
@@ -0,0 +1,115 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace vkb
+{
+/**
+ * @brief Structural key of an object in the resource cache.
+ *
+ * The arguments used to create the object are written field by field into a compact byte blob,
+ * which is then hashed with a 128-bit hash. Two keys are only equal if their blobs are equal, so
+ * objects whose arguments happen to hash to the same value are never mistaken for each other.
+ * Small blobs are stored inline, avoiding a heap allocation for most lookups.
+ */
+class ResourceKey
+{
+  public:
+	ResourceKey() = default;
+
+	/**
+	 * @brief Appends raw bytes to the key
+	 *        The hash must be computed again with finalize() once all bytes are appended
+	 */
+	void append(const void *data, size_t size);
+
+	/**
+	 * @brief Appends a scalar, enum or handle to the key
+	 *        Structs must be appended field by field, so that padding bytes do not end up in the key
+	 */
+	template <class T>
+	void append(const T &value)
+	{
+		static_assert(std::is_scalar<T>::value, "Only scalars can be appended to a resource key, append structs field by field");
+		append(&value, sizeof(T));
+	}
+
+	void append(const std::string &value);
+
+	/// @brief Computes the hash of the bytes appended so far
+	void finalize();
+
+	/// @return The first 64 bits of the 128-bit hash, as used by hash tables
+	size_t get_hash() const;
+
+	const std::array<uint64_t, 2> &get_hash128() const;
+
+	const uint8_t *data() const;
+
+	size_t size() const;
+
+	/// @return The bytes allocated on the heap by a key which outgrew the inline storage
+	size_t get_heap_size() const;
+
+	bool operator==(const ResourceKey &other) const;
+
+	bool operator!=(const ResourceKey &other) const;
+
+  private:
+	static constexpr size_t inline_capacity = 96;
+
+	/// Bytes of the key while it fits in the inline storage
+	std::array<uint8_t, inline_capacity> inline_data{};
+
+	/// Bytes of the key once it outgrew the inline storage
+	std::vector<uint8_t> heap_data;
+
+	size_t data_size{0};
+
+	std::array<uint64_t, 2> hash{0, 0};
+};
+
+/**
+ * @brief 128-bit hash of a block of memory (MurmurHash3 x64 128)
+ * @param data The bytes to hash
+ * @param size The number of bytes
+ * @param seed Seed of the hash
+ * @return The two 64-bit halves of the hash
+ */
+std::array<uint64_t, 2> hash128(const void *data, size_t size, uint64_t seed = 0);
+}        // namespace vkb
+
+namespace std
+{
+template <>
+struct hash<vkb::ResourceKey>
+{
+	std::size_t operator()(const vkb::ResourceKey &key) const
+	{
+		return key.get_hash();
+	}
+};
+}        // namespace std
@@ -21,6 +21,7 @@
 #include <stdexcept>
 
 #include "core/command_buffer.h"
+#include "rendering/frame_readback.h"
 #include "rendering/render_frame.h"
 #include "scene_graph/components/material.h"
 #include "scene_graph/components/perspective_camera.h"
@@ -44,141 +45,10 @@ std::string get_extension(const std::string &uri)
 
 void screenshot(vkb::rendering::RenderContextC &render_context, const std::string &filename)
 {
-	assert(render_context.get_format() == VK_FORMAT_R8G8B8A8_UNORM ||
-	       render_context.get_format() == VK_FORMAT_B8G8R8A8_UNORM ||
-	       render_context.get_format() == VK_FORMAT_R8G8B8A8_SRGB ||
-	       render_context.get_format() == VK_FORMAT_B8G8R8A8_SRGB);
-
-	// We want the last completed frame since we don't want to be reading from an incomplete framebuffer
-	auto &frame = render_context.get_last_rendered_frame();
-	assert(!frame.get_render_target().get_views().empty());
-	auto &src_image_view = frame.get_render_target().get_views()[0];
-
-	auto width    = render_context.get_surface_extent().width;
-	auto height   = render_context.get_surface_extent().height;
-	auto dst_size = width * height * 4;
-
-	vkb::core::BufferC dst_buffer{render_context.get_device(),
-	                              dst_size,
-	                              VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-	                              VMA_MEMORY_USAGE_GPU_TO_CPU,
-	                              VMA_ALLOCATION_CREATE_MAPPED_BIT};
-
-	const auto &queue = render_context.get_device().get_queue_by_flags(VK_QUEUE_GRAPHICS_BIT, 0);
-
-	auto cmd_buf = render_context.get_device().get_command_pool().request_command_buffer();
-
-	cmd_buf->begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
-
-	// Enable destination buffer to be written to
-	{
-		BufferMemoryBarrier memory_barrier{};
-		memory_barrier.src_access_mask = 0;
-		memory_barrier.dst_access_mask = VK_ACCESS_TRANSFER_WRITE_BIT;
-		memory_barrier.src_stage_mask  = VK_PIPELINE_STAGE_TRANSFER_BIT;
-		memory_barrier.dst_stage_mask  = VK_PIPELINE_STAGE_TRANSFER_BIT;
-
-		cmd_buf->buffer_memory_barrier(dst_buffer, 0, dst_size, memory_barrier);
-	}
-
-	// Enable framebuffer image view to be read from
-	{
-		ImageMemoryBarrier memory_barrier{};
-		memory_barrier.old_layout     = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-		memory_barrier.new_layout     = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-		memory_barrier.src_stage_mask = VK_PIPELINE_STAGE_TRANSFER_BIT;
-		memory_barrier.dst_stage_mask = VK_PIPELINE_STAGE_TRANSFER_BIT;
-
-		cmd_buf->image_memory_barrier(src_image_view, memory_barrier);
-	}
-
-	// Check if framebuffer images are in a BGR format
-	auto bgr_formats = {VK_FORMAT_B8G8R8A8_SRGB, VK_FORMAT_B8G8R8A8_UNORM, VK_FORMAT_B8G8R8A8_SNORM};
-	bool swizzle     = std::ranges::find(bgr_formats, src_image_view.get_format()) != bgr_formats.end();
-
-	// Copy framebuffer image memory
-	VkBufferImageCopy image_copy_region{};
-	image_copy_region.bufferRowLength             = width;
-	image_copy_region.bufferImageHeight           = height;
-	image_copy_region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-	image_copy_region.imageSubresource.layerCount = 1;
-	image_copy_region.imageExtent.width           = width;
-	image_copy_region.imageExtent.height          = height;
-	image_copy_region.imageExtent.depth           = 1;
-
-	cmd_buf->copy_image_to_buffer(
-	    src_image_view.get_image(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, dst_buffer, {image_copy_region});
-
-	// Enable destination buffer to map memory
-	{
-		BufferMemoryBarrier memory_barrier{};
-		memory_barrier.src_access_mask = VK_ACCESS_TRANSFER_WRITE_BIT;
-		memory_barrier.dst_access_mask = VK_ACCESS_HOST_READ_BIT;
-		memory_barrier.src_stage_mask  = VK_PIPELINE_STAGE_TRANSFER_BIT;
-		memory_barrier.dst_stage_mask  = VK_PIPELINE_STAGE_HOST_BIT;
-
-		cmd_buf->buffer_memory_barrier(dst_buffer, 0, dst_size, memory_barrier);
-	}
-
-	// Revert back the framebuffer image view from transfer to present
-	{
-		ImageMemoryBarrier memory_barrier{};
-		memory_barrier.old_layout     = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-		memory_barrier.new_layout     = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-		memory_barrier.src_stage_mask = VK_PIPELINE_STAGE_TRANSFER_BIT;
-		memory_barrier.dst_stage_mask = VK_PIPELINE_STAGE_TRANSFER_BIT;
-
-		cmd_buf->image_memory_barrier(src_image_view, memory_barrier);
-	}
-
-	cmd_buf->end();
-
-	queue.submit(*cmd_buf, frame.get_fence_pool().request_fence());
-
-	queue.wait_idle();
-
-	auto raw_data = dst_buffer.map();
-
-	// Creates a pointer to the address of the first byte of the image data
-	// Replace the A component with 255 (remove transparency)
-	// If swapchain format is BGR, swapping the R and B components
-	uint8_t *data = raw_data;
-	if (swizzle)
-	{
-		for (size_t i = 0; i < height; ++i)
-		{
-			// Iterate over each pixel, swapping R and B components and writing the max value for alpha
-			for (size_t j = 0; j < width; ++j)
-			{
-				auto temp   = *(data + 2);
-				*(data + 2) = *(data);
-				*(data)     = temp;
-				*(data + 3) = 255;
-
-				// Get next pixel
-				data += 4;
-			}
-		}
-	}
-	else
-	{
-		for (size_t i = 0; i < height; ++i)
-		{
-			// Iterate over each pixel, writing the max value for alpha
-			for (size_t j = 0; j < width; ++j)
-			{
-				*(data + 3) = 255;
-
-				// Get next pixel
-				data += 4;
-			}
-		}
-	}
-
-	vkb::fs::write_image(raw_data, filename, width, height, 4, width * 4);
-
-	dst_buffer.unmap();
-}        // namespace vkb
+	vkb::rendering::FrameReadback readback{render_context, 1};
+	readback.capture(filename);
+	readback.flush();
+}
 
 std::string to_snake_case(const std::string &text)
 {
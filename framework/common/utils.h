@@ -52,6 +52,7 @@ std::string to_snake_case(const std::string &name);
 
 /**
  * @brief Takes a screenshot of the app by writing the swapchain image to file (slow function)
+ *        Waits for the copy and the file to be written, use a vkb::rendering::FrameReadback to capture frames without stalling
  * @param render_context The RenderContext to use
  * @param filename The name of the file to save the output to
  */
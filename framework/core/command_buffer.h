@@ -30,6 +30,8 @@
 #include "rendering/subpass.h"
 #include "resource_cache.h"
 
+#include <bit>
+
 namespace vkb
 {
 class QueryPool;
@@ -149,18 +151,40 @@ class CommandBuffer
 	void                   draw(uint32_t vertex_count, uint32_t instance_count, uint32_t first_vertex, uint32_t first_instance);
 	void                   draw_indexed(uint32_t index_count, uint32_t instance_count, uint32_t first_index, int32_t vertex_offset, uint32_t first_instance);
 	void                   draw_indexed_indirect(vkb::core::Buffer<bindingType> const &buffer, DeviceSizeType offset, uint32_t draw_count, uint32_t stride);
+	void                   draw_indexed_indirect_count(vkb::core::Buffer<bindingType> const &buffer,
+	                                                   DeviceSizeType                        offset,
+	                                                   vkb::core::Buffer<bindingType> const &count_buffer,
+	                                                   DeviceSizeType                        count_buffer_offset,
+	                                                   uint32_t                              max_draw_count,
+	                                                   uint32_t                              stride);
 	void                   end();
 	void                   end_query(QueryPoolType const &query_pool, uint32_t query);
 	void                   end_render_pass();
 	void                   execute_commands(vkb::core::CommandBuffer<bindingType> &secondary_command_buffer);
 	void                   execute_commands(std::vector<std::shared_ptr<vkb::core::CommandBuffer<bindingType>>> &secondary_command_buffers);
+	void                   fill_buffer(vkb::core::Buffer<bindingType> const &buffer, DeviceSizeType offset, DeviceSizeType size, uint32_t data);
 	CommandBufferLevelType get_level() const;
 	RenderPassType        &get_render_pass(vkb::rendering::RenderTarget<bindingType> const                          &render_target,
 	                                       std::vector<LoadStoreInfoType> const                                     &load_store_infos,
 	                                       std::vector<std::unique_ptr<vkb::rendering::Subpass<bindingType>>> const &subpasses);
 	void                   image_memory_barrier(ImageViewType const &image_view, ImageMemoryBarrierType const &memory_barrier) const;
 	void                   image_memory_barrier(vkb::rendering::RenderTarget<bindingType> &render_target, uint32_t view_index, ImageMemoryBarrierType const &memory_barrier) const;
-	void                   next_subpass();
+	void                   next_subpass(SubpassContentsType contents = {});
+
+	/**
+	 * @return The command pool the command buffer was allocated from
+	 */
+	vkb::core::CommandPool<bindingType> &get_command_pool();
+
+	/**
+	 * @return The pipeline state recorded so far, used by the next draw or dispatch
+	 */
+	vkb::rendering::PipelineState<bindingType> const &get_pipeline_state() const;
+
+	/**
+	 * @return The contents of the subpass being recorded, whether its commands are recorded inline or executed from secondary command buffers
+	 */
+	SubpassContentsType get_subpass_contents() const;
 
 	/**
 	 * @brief Records byte data into the command buffer to be pushed as push constants to each draw call
@@ -203,8 +227,9 @@ class CommandBuffer
   private:
 	/**
 	 * @brief Flushes the command buffer, pushing the new changes
+	 * @return False if the graphics pipeline is being built and has no fallback, the draw must then be skipped
 	 */
-	void flush(vk::PipelineBindPoint pipeline_bind_point);
+	bool flush(vk::PipelineBindPoint pipeline_bind_point);
 
 	/**
 	 * @brief Flush the push constant state
@@ -236,9 +261,19 @@ class CommandBuffer
 	                                                     vkb::common::HPPBufferMemoryBarrier const &memory_barrier);
 	void                      copy_buffer_impl(vkb::core::BufferCpp const &src_buffer, vkb::core::BufferCpp const &dst_buffer, vk::DeviceSize size);
 	void                      execute_commands_impl(std::vector<std::shared_ptr<vkb::core::CommandBuffer<vkb::BindingType::Cpp>>> &secondary_command_buffers);
-	void                      flush_impl(vkb::core::DeviceCpp &device, vk::PipelineBindPoint pipeline_bind_point);
+	bool                      flush_impl(vkb::core::DeviceCpp &device, vk::PipelineBindPoint pipeline_bind_point);
 	void                      flush_descriptor_state_impl(vk::PipelineBindPoint pipeline_bind_point);
-	void                      flush_pipeline_state_impl(vkb::core::DeviceCpp &device, vk::PipelineBindPoint pipeline_bind_point);
+
+	/**
+	 * @brief Calls a function with the buffer or image info of each resource of a set that matches a binding of its layout
+	 *        The offsets of dynamic buffers are moved from their buffer infos to the dynamic offsets
+	 */
+	template <typename Function>
+	void for_each_descriptor(vkb::core::HPPDescriptorSetLayout const &descriptor_set_layout,
+	                         vkb::HPPResourceSet const               &resource_set,
+	                         std::vector<uint32_t>                   &dynamic_offsets,
+	                         Function                               &&function);
+	bool                      flush_pipeline_state_impl(vkb::core::DeviceCpp &device, vk::PipelineBindPoint pipeline_bind_point);
 	vkb::core::HPPRenderPass &get_render_pass_impl(vkb::core::DeviceCpp                                           &device,
 	                                               vkb::rendering::RenderTargetCpp const                          &render_target,
 	                                               std::vector<vkb::common::HPPLoadStoreInfo> const               &load_store_infos,
@@ -250,7 +285,14 @@ class CommandBuffer
 	vkb::core::CommandPoolCpp                                              &command_pool;
 	vkb::core::HPPFramebuffer const                                        *current_framebuffer = nullptr;
 	vkb::core::HPPRenderPass const                                         *current_render_pass = nullptr;
-	std::unordered_map<uint32_t, vkb::core::HPPDescriptorSetLayout const *> descriptor_set_layout_binding_state;
+	std::array<vkb::core::HPPDescriptorSetLayout const *, vkb::HPPResourceBindingState::max_descriptor_sets> descriptor_set_layout_binding_state = {};
+	std::vector<vkb::DescriptorUpdateInfo>                                                                  descriptor_update_infos;
+
+	// Pipelines already bound while recording, by the hash of their state, so that switching back to a state skips the resource cache
+	// The states are not compared, see PipelineState::get_hash()
+	std::unordered_map<vkb::rendering::PipelineStateHash, vk::Pipeline, vkb::rendering::PipelineStateHasher> compute_pipelines;
+	std::unordered_map<vkb::rendering::PipelineStateHash, vk::Pipeline, vkb::rendering::PipelineStateHasher> graphics_pipelines;
+
 	vk::Extent2D                                                            last_framebuffer_extent = {};
 	vk::Extent2D                                                            last_render_area_extent = {};
 	const vk::CommandBufferLevel                                            level                   = {};
@@ -258,6 +300,7 @@ class CommandBuffer
 	vkb::rendering::PipelineStateCpp                                        pipeline_state          = {};
 	vkb::HPPResourceBindingState                                            resource_binding_state  = {};
 	std::vector<uint8_t>                                                    stored_push_constants   = {};
+	vk::SubpassContents                                                     subpass_contents        = vk::SubpassContents::eInline;
 
 	// If true, it becomes the responsibility of the caller to update ANY descriptor bindings
 	// that contain update after bind, as they wont be implicitly updated
@@ -354,8 +397,10 @@ inline void CommandBuffer<bindingType>::begin_impl(vk::CommandBufferUsageFlags
 	// Reset state
 	pipeline_state.reset();
 	resource_binding_state.reset();
-	descriptor_set_layout_binding_state.clear();
+	descriptor_set_layout_binding_state.fill(nullptr);
 	stored_push_constants.clear();
+	compute_pipelines.clear();
+	graphics_pipelines.clear();
 
 	vk::CommandBufferBeginInfo       begin_info{.flags = flags};
 	vk::CommandBufferInheritanceInfo inheritance;
@@ -372,6 +417,13 @@ inline void CommandBuffer<bindingType>::begin_impl(vk::CommandBufferUsageFlags
 		inheritance.subpass     = subpass_index;
 
 		begin_info.pInheritanceInfo = &inheritance;
+
+		// Pipelines are compiled for the inherited subpass, with one blend attachment per color output of it
+		pipeline_state.set_subpass_index(subpass_index);
+
+		auto blend_state = pipeline_state.get_color_blend_state();
+		blend_state.attachments.resize(current_render_pass->get_color_output_count(subpass_index));
+		pipeline_state.set_color_blend_state(blend_state);
 	}
 
 	this->get_resource().begin(begin_info);
@@ -400,7 +452,7 @@ inline void CommandBuffer<bindingType>::begin_render_pass(vkb::rendering::Render
 	// Reset state
 	pipeline_state.reset();
 	resource_binding_state.reset();
-	descriptor_set_layout_binding_state.clear();
+	descriptor_set_layout_binding_state.fill(nullptr);
 
 	auto &render_pass = get_render_pass(render_target, load_store_infos, subpasses);
 	auto &framebuffer = this->get_device().get_resource_cache().request_framebuffer(render_target, render_pass);
@@ -462,6 +514,7 @@ inline void CommandBuffer<bindingType>::begin_render_pass_impl(vkb::rendering::R
 	}
 
 	this->get_resource().beginRenderPass(begin_info, contents);
+	subpass_contents = contents;
 
 	// Update blend state attachments for first subpass
 	auto blend_state = pipeline_state.get_color_blend_state();
@@ -764,7 +817,10 @@ inline void CommandBuffer<bindingType>::dispatch_indirect(vkb::core::Buffer<bind
 template <vkb::BindingType bindingType>
 inline void CommandBuffer<bindingType>::draw(uint32_t vertex_count, uint32_t instance_count, uint32_t first_vertex, uint32_t first_instance)
 {
-	flush(vk::PipelineBindPoint::eGraphics);
+	if (!flush(vk::PipelineBindPoint::eGraphics))
+	{
+		return;
+	}
 	this->get_resource().draw(vertex_count, instance_count, first_vertex, first_instance);
 }
 
@@ -772,14 +828,20 @@ template <vkb::BindingType bindingType>
 inline void CommandBuffer<bindingType>::draw_indexed(
     uint32_t index_count, uint32_t instance_count, uint32_t first_index, int32_t vertex_offset, uint32_t first_instance)
 {
-	flush(vk::PipelineBindPoint::eGraphics);
+	if (!flush(vk::PipelineBindPoint::eGraphics))
+	{
+		return;
+	}
 	this->get_resource().drawIndexed(index_count, instance_count, first_index, vertex_offset, first_instance);
 }
 
 template <vkb::BindingType bindingType>
 inline void CommandBuffer<bindingType>::draw_indexed_indirect(vkb::core::Buffer<bindingType> const &buffer, DeviceSizeType offset, uint32_t draw_count, uint32_t stride)
 {
-	flush(vk::PipelineBindPoint::eGraphics);
+	if (!flush(vk::PipelineBindPoint::eGraphics))
+	{
+		return;
+	}
 	if constexpr (bindingType == vkb::BindingType::Cpp)
 	{
 		this->get_resource().drawIndexedIndirect(buffer.get_handle(), offset, draw_count, stride);
@@ -790,6 +852,47 @@ inline void CommandBuffer<bindingType>::draw_indexed_indirect(vkb::core::Buffer<
 	}
 }
 
+template <vkb::BindingType bindingType>
+inline void CommandBuffer<bindingType>::draw_indexed_indirect_count(vkb::core::Buffer<bindingType> const &buffer,
+                                                                    DeviceSizeType                        offset,
+                                                                    vkb::core::Buffer<bindingType> const &count_buffer,
+                                                                    DeviceSizeType                        count_buffer_offset,
+                                                                    uint32_t                              max_draw_count,
+                                                                    uint32_t                              stride)
+{
+	if (!flush(vk::PipelineBindPoint::eGraphics))
+	{
+		return;
+	}
+
+	vk::Buffer vk_buffer;
+	vk::Buffer vk_count_buffer;
+	if constexpr (bindingType == vkb::BindingType::Cpp)
+	{
+		vk_buffer       = buffer.get_handle();
+		vk_count_buffer = count_buffer.get_handle();
+	}
+	else
+	{
+		vk_buffer       = buffer.get_resource();
+		vk_count_buffer = count_buffer.get_resource();
+	}
+
+	// The core command of Vulkan 1.2 is not loaded on a Vulkan 1.1 device, which needs VK_KHR_draw_indirect_count instead
+	if (VULKAN_HPP_DEFAULT_DISPATCHER.vkCmdDrawIndexedIndirectCount)
+	{
+		this->get_resource().drawIndexedIndirectCount(
+		    vk_buffer, static_cast<vk::DeviceSize>(offset), vk_count_buffer, static_cast<vk::DeviceSize>(count_buffer_offset), max_draw_count, stride);
+	}
+	else
+	{
+		assert(this->get_device().is_extension_enabled(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME) &&
+		       "Drawing with an indirect count needs Vulkan 1.2 or the VK_KHR_draw_indirect_count extension");
+		this->get_resource().drawIndexedIndirectCountKHR(
+		    vk_buffer, static_cast<vk::DeviceSize>(offset), vk_count_buffer, static_cast<vk::DeviceSize>(count_buffer_offset), max_draw_count, stride);
+	}
+}
+
 template <vkb::BindingType bindingType>
 inline void CommandBuffer<bindingType>::end()
 {
@@ -815,6 +918,19 @@ inline void CommandBuffer<bindingType>::end_render_pass()
 	this->get_resource().endRenderPass();
 }
 
+template <vkb::BindingType bindingType>
+inline vkb::core::CommandPool<bindingType> &CommandBuffer<bindingType>::get_command_pool()
+{
+	if constexpr (bindingType == vkb::BindingType::Cpp)
+	{
+		return command_pool;
+	}
+	else
+	{
+		return reinterpret_cast<vkb::core::CommandPoolC &>(command_pool);
+	}
+}
+
 template <vkb::BindingType bindingType>
 inline typename CommandBuffer<bindingType>::CommandBufferLevelType CommandBuffer<bindingType>::get_level() const
 {
@@ -828,6 +944,32 @@ inline typename CommandBuffer<bindingType>::CommandBufferLevelType CommandBuffer
 	}
 }
 
+template <vkb::BindingType bindingType>
+inline vkb::rendering::PipelineState<bindingType> const &CommandBuffer<bindingType>::get_pipeline_state() const
+{
+	if constexpr (bindingType == vkb::BindingType::Cpp)
+	{
+		return pipeline_state;
+	}
+	else
+	{
+		return reinterpret_cast<vkb::rendering::PipelineStateC const &>(pipeline_state);
+	}
+}
+
+template <vkb::BindingType bindingType>
+inline typename CommandBuffer<bindingType>::SubpassContentsType CommandBuffer<bindingType>::get_subpass_contents() const
+{
+	if constexpr (bindingType == vkb::BindingType::Cpp)
+	{
+		return subpass_contents;
+	}
+	else
+	{
+		return static_cast<VkSubpassContents>(subpass_contents);
+	}
+}
+
 template <vkb::BindingType bindingType>
 inline void CommandBuffer<bindingType>::execute_commands(vkb::core::CommandBuffer<bindingType> &secondary_command_buffer)
 {
@@ -858,6 +1000,19 @@ inline void CommandBuffer<bindingType>::execute_commands_impl(std::vector<std::s
 	this->get_resource().executeCommands(sec_cmd_buf_handles);
 }
 
+template <vkb::BindingType bindingType>
+inline void CommandBuffer<bindingType>::fill_buffer(vkb::core::Buffer<bindingType> const &buffer, DeviceSizeType offset, DeviceSizeType size, uint32_t data)
+{
+	if constexpr (bindingType == vkb::BindingType::Cpp)
+	{
+		this->get_resource().fillBuffer(buffer.get_handle(), offset, size, data);
+	}
+	else
+	{
+		this->get_resource().fillBuffer(buffer.get_resource(), static_cast<vk::DeviceSize>(offset), static_cast<vk::DeviceSize>(size), data);
+	}
+}
+
 template <vkb::BindingType bindingType>
 inline typename vkb::core::CommandBuffer<bindingType>::RenderPassType &
     CommandBuffer<bindingType>::get_render_pass(vkb::rendering::RenderTarget<bindingType> const                          &render_target,
@@ -971,7 +1126,7 @@ inline void CommandBuffer<bindingType>::image_memory_barrier_impl(vkb::core::HPP
 }
 
 template <vkb::BindingType bindingType>
-inline void CommandBuffer<bindingType>::next_subpass()
+inline void CommandBuffer<bindingType>::next_subpass(SubpassContentsType contents)
 {
 	// Increment subpass index
 	pipeline_state.set_subpass_index(pipeline_state.get_subpass_index() + 1);
@@ -983,12 +1138,13 @@ inline void CommandBuffer<bindingType>::next_subpass()
 
 	// Reset descriptor sets
 	resource_binding_state.reset();
-	descriptor_set_layout_binding_state.clear();
+	descriptor_set_layout_binding_state.fill(nullptr);
 
 	// Clear stored push constants
 	stored_push_constants.clear();
 
-	this->get_resource().nextSubpass(vk::SubpassContents::eInline);
+	subpass_contents = static_cast<vk::SubpassContents>(contents);
+	this->get_resource().nextSubpass(subpass_contents);
 }
 
 template <vkb::BindingType bindingType>
@@ -1267,24 +1423,32 @@ inline void CommandBuffer<bindingType>::write_timestamp(PipelineStagFlagBitsType
 }
 
 template <vkb::BindingType bindingType>
-inline void CommandBuffer<bindingType>::flush(vk::PipelineBindPoint pipeline_bind_point)
+inline bool CommandBuffer<bindingType>::flush(vk::PipelineBindPoint pipeline_bind_point)
 {
 	if constexpr (bindingType == vkb::BindingType::Cpp)
 	{
-		flush_impl(this->get_device(), pipeline_bind_point);
+		return flush_impl(this->get_device(), pipeline_bind_point);
 	}
 	else
 	{
-		flush_impl(reinterpret_cast<vkb::core::DeviceCpp &>(this->get_device()), pipeline_bind_point);
+		return flush_impl(reinterpret_cast<vkb::core::DeviceCpp &>(this->get_device()), pipeline_bind_point);
 	}
 }
 
 template <vkb::BindingType bindingType>
-inline void CommandBuffer<bindingType>::flush_impl(vkb::core::DeviceCpp &device, vk::PipelineBindPoint pipeline_bind_point)
+inline bool CommandBuffer<bindingType>::flush_impl(vkb::core::DeviceCpp &device, vk::PipelineBindPoint pipeline_bind_point)
 {
-	flush_pipeline_state_impl(device, pipeline_bind_point);
+	if (!flush_pipeline_state_impl(device, pipeline_bind_point))
+	{
+		// The push constants belong to the skipped draw
+		stored_push_constants.clear();
+		return false;
+	}
+
 	flush_push_constants();
 	flush_descriptor_state_impl(pipeline_bind_point);
+
+	return true;
 }
 
 template <vkb::BindingType bindingType>
@@ -1294,180 +1458,286 @@ inline void CommandBuffer<bindingType>::flush_descriptor_state_impl(vk::Pipeline
 
 	const auto &pipeline_layout = pipeline_state.get_pipeline_layout();
 
-	std::unordered_set<uint32_t> update_descriptor_sets;
-
-	// Iterate over the shader sets to check if they have already been bound
-	// If they have, add the set so that the command buffer later updates it
+	// Bitmask of the sets which have already been bound with a different layout
+	// The command buffer has to update them for the current pipeline layout
+	uint32_t update_descriptor_sets = 0;
 	for (auto &set_it : pipeline_layout.get_shader_sets())
 	{
 		uint32_t descriptor_set_id = set_it.first;
+		assert(descriptor_set_id < descriptor_set_layout_binding_state.size() && "Descriptor set index is out of bounds");
 
-		auto descriptor_set_layout_it = descriptor_set_layout_binding_state.find(descriptor_set_id);
-
-		if (descriptor_set_layout_it != descriptor_set_layout_binding_state.end())
+		auto bound_descriptor_set_layout = descriptor_set_layout_binding_state[descriptor_set_id];
+		if (bound_descriptor_set_layout && bound_descriptor_set_layout->get_handle() != pipeline_layout.get_descriptor_set_layout(descriptor_set_id).get_handle())
 		{
-			if (descriptor_set_layout_it->second->get_handle() != pipeline_layout.get_descriptor_set_layout(descriptor_set_id).get_handle())
-			{
-				update_descriptor_sets.emplace(descriptor_set_id);
-			}
+			update_descriptor_sets |= 1u << descriptor_set_id;
 		}
 	}
 
 	// Validate that the bound descriptor set layouts exist in the pipeline layout
-	for (auto set_it = descriptor_set_layout_binding_state.begin(); set_it != descriptor_set_layout_binding_state.end();)
+	for (uint32_t descriptor_set_id = 0; descriptor_set_id < descriptor_set_layout_binding_state.size(); ++descriptor_set_id)
 	{
-		if (!pipeline_layout.has_descriptor_set_layout(set_it->first))
-		{
-			set_it = descriptor_set_layout_binding_state.erase(set_it);
-		}
-		else
+		if (descriptor_set_layout_binding_state[descriptor_set_id] && !pipeline_layout.has_descriptor_set_layout(descriptor_set_id))
 		{
-			++set_it;
+			descriptor_set_layout_binding_state[descriptor_set_id] = nullptr;
 		}
 	}
 
-	// Check if a descriptor set needs to be created
-	if (resource_binding_state.is_dirty() || !update_descriptor_sets.empty())
+	// Update the resource sets whose state changed, and the ones bound with a different layout
+	uint32_t resource_sets = resource_binding_state.get_dirty_sets() | (update_descriptor_sets & resource_binding_state.get_bound_sets());
+	if (resource_sets == 0)
+	{
+		return;
+	}
+
+	resource_binding_state.clear_dirty();
+
+	for (; resource_sets != 0; resource_sets &= resource_sets - 1)
 	{
-		resource_binding_state.clear_dirty();
+		uint32_t descriptor_set_id = std::countr_zero(resource_sets);
 
-		// Iterate over all of the resource sets bound by the command buffer
-		for (auto &resource_set_it : resource_binding_state.get_resource_sets())
+		// Skip resource set if a descriptor set layout doesn't exist for it
+		if (!pipeline_layout.has_descriptor_set_layout(descriptor_set_id))
 		{
-			uint32_t descriptor_set_id = resource_set_it.first;
-			auto    &resource_set      = resource_set_it.second;
+			continue;
+		}
 
-			// Don't update resource set if it's not in the update list OR its state hasn't changed
-			if (!resource_set.is_dirty() && (update_descriptor_sets.find(descriptor_set_id) == update_descriptor_sets.end()))
-			{
-				continue;
-			}
+		auto &descriptor_set_layout = pipeline_layout.get_descriptor_set_layout(descriptor_set_id);
+		auto &resource_set          = resource_binding_state.get_resource_sets()[descriptor_set_id];
 
-			// Clear dirty flag for resource set
-			resource_binding_state.clear_dirty(descriptor_set_id);
+		// Make descriptor set layout bound for current set
+		descriptor_set_layout_binding_state[descriptor_set_id] = &descriptor_set_layout;
 
-			// Skip resource set if a descriptor set layout doesn't exist for it
-			if (!pipeline_layout.has_descriptor_set_layout(descriptor_set_id))
-			{
-				continue;
-			}
+		std::vector<uint32_t> dynamic_offsets;
+		vk::DescriptorSet     descriptor_set_handle;
 
-			auto &descriptor_set_layout = pipeline_layout.get_descriptor_set_layout(descriptor_set_id);
+		// Write the descriptors into the flat array of the update template, if every descriptor of the layout is bound
+		bool use_update_template = !update_after_bind && descriptor_set_layout.get_update_template();
+		if (use_update_template)
+		{
+			descriptor_update_infos.assign(descriptor_set_layout.get_update_template_size(), {});
 
-			// Make descriptor set layout bound for current set
-			descriptor_set_layout_binding_state[descriptor_set_id] = &descriptor_set_layout;
+			uint32_t descriptor_count = 0;
+			bool     in_bounds        = true;
 
+			auto write_update_info = [&](vk::DescriptorSetLayoutBinding const &binding_info,
+			                             uint32_t                              array_element,
+			                             vk::DescriptorBufferInfo const       *buffer_info,
+			                             vk::DescriptorImageInfo const        *image_info) {
+				if (array_element >= binding_info.descriptorCount)
+				{
+					in_bounds = false;
+					return;
+				}
+
+				// Written field by field, so that the padding of the image infos stays zero and the array can be hashed
+				auto &descriptor_update_info = descriptor_update_infos[descriptor_set_layout.get_update_template_offset(binding_info.binding) + array_element];
+				if (buffer_info)
+				{
+					descriptor_update_info.buffer.buffer = static_cast<VkBuffer>(buffer_info->buffer);
+					descriptor_update_info.buffer.offset = buffer_info->offset;
+					descriptor_update_info.buffer.range  = buffer_info->range;
+				}
+				else
+				{
+					descriptor_update_info.image.sampler     = static_cast<VkSampler>(image_info->sampler);
+					descriptor_update_info.image.imageView   = static_cast<VkImageView>(image_info->imageView);
+					descriptor_update_info.image.imageLayout = static_cast<VkImageLayout>(image_info->imageLayout);
+				}
+				descriptor_count++;
+			};
+			for_each_descriptor(descriptor_set_layout, resource_set, dynamic_offsets, write_update_info);
+
+			if (in_bounds && descriptor_count == descriptor_update_infos.size())
+			{
+				descriptor_set_handle =
+				    command_pool.get_render_frame()->request_descriptor_set(descriptor_set_layout, descriptor_update_infos, command_pool.get_thread_index());
+			}
+			else
+			{
+				use_update_template = false;
+				dynamic_offsets.clear();
+			}
+		}
+
+		if (!use_update_template)
+		{
 			BindingMap<vk::DescriptorBufferInfo> buffer_infos;
 			BindingMap<vk::DescriptorImageInfo>  image_infos;
 
-			std::vector<uint32_t> dynamic_offsets;
+			auto write_info = [&](vk::DescriptorSetLayoutBinding const &binding_info,
+			                      uint32_t                              array_element,
+			                      vk::DescriptorBufferInfo const       *buffer_info,
+			                      vk::DescriptorImageInfo const        *image_info) {
+				if (buffer_info)
+				{
+					buffer_infos[binding_info.binding][array_element] = *buffer_info;
+				}
+				else
+				{
+					image_infos[binding_info.binding][array_element] = *image_info;
+				}
+			};
+			for_each_descriptor(descriptor_set_layout, resource_set, dynamic_offsets, write_info);
+
+			descriptor_set_handle = command_pool.get_render_frame()->request_descriptor_set(
+			    descriptor_set_layout, buffer_infos, image_infos, update_after_bind, command_pool.get_thread_index());
+		}
+
+		// Bind descriptor set
+		this->get_resource().bindDescriptorSets(pipeline_bind_point, pipeline_layout.get_handle(), descriptor_set_id, descriptor_set_handle, dynamic_offsets);
+	}
+}
+
+template <vkb::BindingType bindingType>
+template <typename Function>
+inline void CommandBuffer<bindingType>::for_each_descriptor(vkb::core::HPPDescriptorSetLayout const &descriptor_set_layout,
+                                                            vkb::HPPResourceSet const               &resource_set,
+                                                            std::vector<uint32_t>                   &dynamic_offsets,
+                                                            Function                               &&function)
+{
+	// Iterate over all resource bindings
+	for (auto &binding_it : resource_set.get_resource_bindings())
+	{
+		auto  binding_index     = binding_it.first;
+		auto &binding_resources = binding_it.second;
+
+		// Check if binding exists in the pipeline layout
+		auto binding_info = descriptor_set_layout.find_layout_binding(binding_index);
+		if (!binding_info)
+		{
+			continue;
+		}
+
+		bool has_descriptor = false;
 
-			// Iterate over all resource bindings
-			for (auto &binding_it : resource_set.get_resource_bindings())
+		// Iterate over all binding resources
+		for (auto &element_it : binding_resources)
+		{
+			auto  array_element = element_it.first;
+			auto &resource_info = element_it.second;
+
+			// Pointer references
+			auto &buffer     = resource_info.buffer;
+			auto &sampler    = resource_info.sampler;
+			auto &image_view = resource_info.image_view;
+
+			// Get buffer info
+			if (buffer != nullptr && vkb::common::is_buffer_descriptor_type(binding_info->descriptorType))
 			{
-				auto  binding_index     = binding_it.first;
-				auto &binding_resources = binding_it.second;
+				vk::DescriptorBufferInfo buffer_info{resource_info.buffer->get_handle(), resource_info.offset, resource_info.range};
 
-				// Check if binding exists in the pipeline layout
-				if (auto binding_info = descriptor_set_layout.get_layout_binding(binding_index))
+				if (vkb::common::is_dynamic_buffer_descriptor_type(binding_info->descriptorType))
 				{
-					// Iterate over all binding resources
-					for (auto &element_it : binding_resources)
-					{
-						auto  array_element = element_it.first;
-						auto &resource_info = element_it.second;
-
-						// Pointer references
-						auto &buffer     = resource_info.buffer;
-						auto &sampler    = resource_info.sampler;
-						auto &image_view = resource_info.image_view;
-
-						// Get buffer info
-						if (buffer != nullptr && vkb::common::is_buffer_descriptor_type(binding_info->descriptorType))
-						{
-							vk::DescriptorBufferInfo buffer_info{resource_info.buffer->get_handle(), resource_info.offset, resource_info.range};
-
-							if (vkb::common::is_dynamic_buffer_descriptor_type(binding_info->descriptorType))
-							{
-								dynamic_offsets.push_back(to_u32(buffer_info.offset));
-								buffer_info.offset = 0;
-							}
-
-							buffer_infos[binding_index][array_element] = buffer_info;
-						}
-
-						// Get image info
-						else if (image_view != nullptr || sampler != nullptr)
-						{
-							// Can be null for input attachments
-							vk::DescriptorImageInfo image_info{sampler ? sampler->get_handle() : nullptr, image_view->get_handle()};
-
-							if (image_view != nullptr)
-							{
-								// Add image layout info based on descriptor type
-								switch (binding_info->descriptorType)
-								{
-									case vk::DescriptorType::eCombinedImageSampler:
-										image_info.imageLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
-										break;
-									case vk::DescriptorType::eInputAttachment:
-										image_info.imageLayout = vkb::common::is_depth_format(image_view->get_format()) ? vk::ImageLayout::eDepthStencilReadOnlyOptimal : vk::ImageLayout::eShaderReadOnlyOptimal;
-										break;
-									case vk::DescriptorType::eStorageImage:
-										image_info.imageLayout = vk::ImageLayout::eGeneral;
-										break;
-									default:
-										continue;
-								}
-							}
-
-							image_infos[binding_index][array_element] = image_info;
-						}
-					}
-
-					assert((!update_after_bind || (buffer_infos.count(binding_index) > 0 || (image_infos.count(binding_index) > 0))) &&
-					       "binding index with no buffer or image infos can't be checked for adding to bindings_to_update");
+					dynamic_offsets.push_back(to_u32(buffer_info.offset));
+					buffer_info.offset = 0;
 				}
+
+				function(*binding_info, array_element, &buffer_info, nullptr);
+				has_descriptor = true;
 			}
 
-			vk::DescriptorSet descriptor_set_handle = command_pool.get_render_frame()->request_descriptor_set(
-			    descriptor_set_layout, buffer_infos, image_infos, update_after_bind, command_pool.get_thread_index());
+			// Get image info
+			else if (image_view != nullptr || sampler != nullptr)
+			{
+				// Can be null for input attachments
+				vk::DescriptorImageInfo image_info{sampler ? sampler->get_handle() : nullptr, image_view ? image_view->get_handle() : nullptr};
 
-			// Bind descriptor set
-			this->get_resource().bindDescriptorSets(pipeline_bind_point, pipeline_layout.get_handle(), descriptor_set_id, descriptor_set_handle, dynamic_offsets);
+				if (image_view != nullptr)
+				{
+					// Add image layout info based on descriptor type
+					switch (binding_info->descriptorType)
+					{
+						case vk::DescriptorType::eCombinedImageSampler:
+							image_info.imageLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+							break;
+						case vk::DescriptorType::eInputAttachment:
+							image_info.imageLayout = vkb::common::is_depth_format(image_view->get_format()) ? vk::ImageLayout::eDepthStencilReadOnlyOptimal : vk::ImageLayout::eShaderReadOnlyOptimal;
+							break;
+						case vk::DescriptorType::eStorageImage:
+							image_info.imageLayout = vk::ImageLayout::eGeneral;
+							break;
+						default:
+							continue;
+					}
+				}
+
+				function(*binding_info, array_element, nullptr, &image_info);
+				has_descriptor = true;
+			}
 		}
+
+		assert((!update_after_bind || has_descriptor) && "binding index with no buffer or image infos can't be checked for adding to bindings_to_update");
 	}
 }
 
 template <vkb::BindingType bindingType>
-inline void CommandBuffer<bindingType>::flush_pipeline_state_impl(vkb::core::DeviceCpp &device, vk::PipelineBindPoint pipeline_bind_point)
+inline bool CommandBuffer<bindingType>::flush_pipeline_state_impl(vkb::core::DeviceCpp &device, vk::PipelineBindPoint pipeline_bind_point)
 {
 	// Create a new pipeline only if the graphics state changed
 	if (!pipeline_state.is_dirty())
 	{
-		return;
+		return true;
 	}
 
-	pipeline_state.clear_dirty();
-
 	// Create and bind pipeline
+	vk::Pipeline pipeline;
 	if (pipeline_bind_point == vk::PipelineBindPoint::eGraphics)
 	{
 		pipeline_state.set_render_pass(*current_render_pass);
-		auto &pipeline = device.get_resource_cache().request_graphics_pipeline(pipeline_state);
 
-		this->get_resource().bindPipeline(pipeline_bind_point, pipeline.get_handle());
+		auto it = graphics_pipelines.find(pipeline_state.get_hash());
+		if (it == graphics_pipelines.end())
+		{
+			auto &resource_cache = device.get_resource_cache();
+
+			if (auto graphics_pipeline = resource_cache.request_graphics_pipeline_async(pipeline_state))
+			{
+				pipeline = graphics_pipeline->get_handle();
+				graphics_pipelines.emplace(pipeline_state.get_hash(), pipeline);
+			}
+			else
+			{
+				// The pipeline is being built, the state stays dirty so that the next draw looks for it again
+				pipeline = resource_cache.find_fallback_pipeline(pipeline_state);
+				if (!pipeline)
+				{
+					return false;
+				}
+
+				this->get_resource().bindPipeline(pipeline_bind_point, pipeline);
+				return true;
+			}
+		}
+		else
+		{
+			pipeline = it->second;
+		}
+
+		pipeline_state.clear_dirty();
 	}
 	else if (pipeline_bind_point == vk::PipelineBindPoint::eCompute)
 	{
-		auto &pipeline = device.get_resource_cache().request_compute_pipeline(pipeline_state);
+		pipeline_state.clear_dirty();
 
-		this->get_resource().bindPipeline(pipeline_bind_point, pipeline.get_handle());
+		auto it = compute_pipelines.find(pipeline_state.get_hash());
+		if (it == compute_pipelines.end())
+		{
+			pipeline = device.get_resource_cache().request_compute_pipeline(pipeline_state).get_handle();
+			compute_pipelines.emplace(pipeline_state.get_hash(), pipeline);
+		}
+		else
+		{
+			pipeline = it->second;
+		}
 	}
 	else
 	{
 		throw "Only graphics and compute pipeline bind points are supported now";
 	}
+
+	this->get_resource().bindPipeline(pipeline_bind_point, pipeline);
+
+	return true;
 }
 
 template <vkb::BindingType bindingType>
@@ -163,8 +163,8 @@ std::uint32_t DescriptorPool::find_available_pool(std::uint32_t search_index)
 		create_info.pPoolSizes    = pool_sizes.data();
 		create_info.maxSets       = pool_max_sets;
 
-		// We do not set FREE_DESCRIPTOR_SET_BIT as we do not need to free individual descriptor sets
-		create_info.flags = 0;
+		// Descriptor sets evicted from the resource cache are freed individually
+		create_info.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
 
 		// Check descriptor set layout and enable the required flags
 		auto &binding_flags = descriptor_set_layout->get_binding_flags();
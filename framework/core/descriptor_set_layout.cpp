@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2025, Arm Limited and Contributors
+/* Copyright (c) 2019-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -188,6 +188,12 @@ DescriptorSetLayout::DescriptorSetLayout(vkb::core::DeviceC                &devi
 	{
 		throw VulkanException{result, "Cannot create DescriptorSetLayout"};
 	}
+
+	// An update template writes every descriptor of its bindings, which update-after-bind bindings don't expect
+	if (std::ranges::all_of(binding_flags, [](VkDescriptorBindingFlagsEXT flags) { return flags == 0; }))
+	{
+		create_update_template();
+	}
 }
 
 DescriptorSetLayout::DescriptorSetLayout(DescriptorSetLayout &&other) :
@@ -199,13 +205,22 @@ DescriptorSetLayout::DescriptorSetLayout(DescriptorSetLayout &&other) :
     binding_flags{std::move(other.binding_flags)},
     bindings_lookup{std::move(other.bindings_lookup)},
     binding_flags_lookup{std::move(other.binding_flags_lookup)},
-    resources_lookup{std::move(other.resources_lookup)}
+    resources_lookup{std::move(other.resources_lookup)},
+    update_template{other.update_template},
+    update_template_offsets{std::move(other.update_template_offsets)},
+    update_template_size{other.update_template_size}
 {
-	other.handle = VK_NULL_HANDLE;
+	other.handle          = VK_NULL_HANDLE;
+	other.update_template = VK_NULL_HANDLE;
 }
 
 DescriptorSetLayout::~DescriptorSetLayout()
 {
+	if (update_template != VK_NULL_HANDLE)
+	{
+		vkDestroyDescriptorUpdateTemplate(device.get_handle(), update_template, nullptr);
+	}
+
 	// Destroy descriptor set layout
 	if (handle != VK_NULL_HANDLE)
 	{
@@ -245,6 +260,13 @@ std::unique_ptr<VkDescriptorSetLayoutBinding> DescriptorSetLayout::get_layout_bi
 	return std::make_unique<VkDescriptorSetLayoutBinding>(it->second);
 }
 
+const VkDescriptorSetLayoutBinding *DescriptorSetLayout::find_layout_binding(const uint32_t binding_index) const
+{
+	auto it = bindings_lookup.find(binding_index);
+
+	return it != bindings_lookup.end() ? &it->second : nullptr;
+}
+
 std::unique_ptr<VkDescriptorSetLayoutBinding> DescriptorSetLayout::get_layout_binding(const std::string &name) const
 {
 	auto it = resources_lookup.find(name);
@@ -274,4 +296,78 @@ const std::vector<ShaderModule *> &DescriptorSetLayout::get_shader_modules() con
 	return shader_modules;
 }
 
+VkDescriptorUpdateTemplate DescriptorSetLayout::get_update_template() const
+{
+	return update_template;
+}
+
+uint32_t DescriptorSetLayout::get_update_template_offset(const uint32_t binding_index) const
+{
+	return binding_index < update_template_offsets.size() ? update_template_offsets[binding_index] : ~0U;
+}
+
+uint32_t DescriptorSetLayout::get_update_template_size() const
+{
+	return update_template_size;
+}
+
+void DescriptorSetLayout::create_update_template()
+{
+	uint32_t descriptor_count = 0;
+	uint32_t max_binding      = 0;
+	for (auto &binding : bindings)
+	{
+		descriptor_count += binding.descriptorCount;
+		max_binding = std::max(max_binding, binding.binding);
+	}
+
+	if (descriptor_count == 0 || descriptor_count > max_update_template_size)
+	{
+		return;
+	}
+
+	update_template_offsets.assign(max_binding + 1, ~0U);
+
+	// Lay the descriptors of each binding out one after the other
+	std::vector<VkDescriptorUpdateTemplateEntry> entries;
+	entries.reserve(bindings.size());
+
+	uint32_t offset = 0;
+	for (auto &binding : bindings)
+	{
+		if (binding.descriptorCount == 0)
+		{
+			continue;
+		}
+
+		VkDescriptorUpdateTemplateEntry entry{};
+		entry.dstBinding      = binding.binding;
+		entry.dstArrayElement = 0;
+		entry.descriptorCount = binding.descriptorCount;
+		entry.descriptorType  = binding.descriptorType;
+		entry.offset          = offset * sizeof(DescriptorUpdateInfo);
+		entry.stride          = sizeof(DescriptorUpdateInfo);
+
+		entries.push_back(entry);
+
+		update_template_offsets[binding.binding] = offset;
+		offset += binding.descriptorCount;
+	}
+
+	VkDescriptorUpdateTemplateCreateInfo create_info{VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO};
+	create_info.descriptorUpdateEntryCount = to_u32(entries.size());
+	create_info.pDescriptorUpdateEntries   = entries.data();
+	create_info.templateType               = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+	create_info.descriptorSetLayout        = handle;
+
+	VkResult result = vkCreateDescriptorUpdateTemplate(device.get_handle(), &create_info, nullptr, &update_template);
+
+	if (result != VK_SUCCESS)
+	{
+		throw VulkanException{result, "Cannot create DescriptorUpdateTemplate"};
+	}
+
+	update_template_size = offset;
+}
+
 }        // namespace vkb
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2025, Arm Limited and Contributors
+/* Copyright (c) 2019-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -34,6 +34,16 @@ class Device;
 using DeviceC = Device<vkb::BindingType::C>;
 }        // namespace core
 
+/**
+ * @brief Data of a single descriptor written by a descriptor update template.
+ *        Every descriptor takes the same space, so the descriptors of a set are a flat array which can be hashed in one pass.
+ */
+union DescriptorUpdateInfo
+{
+	VkDescriptorBufferInfo buffer;
+	VkDescriptorImageInfo  image;
+};
+
 /**
  * @brief Caches DescriptorSet objects for the shader's set index.
  *        Creates a DescriptorPool to allocate the DescriptorSet objects
@@ -73,12 +83,33 @@ class DescriptorSetLayout
 
 	std::unique_ptr<VkDescriptorSetLayoutBinding> get_layout_binding(const std::string &name) const;
 
+	/// @return The layout binding at a binding index, or nullptr if there is none, without copying it
+	const VkDescriptorSetLayoutBinding *find_layout_binding(const uint32_t binding_index) const;
+
 	const std::vector<VkDescriptorBindingFlagsEXT> &get_binding_flags() const;
 
 	VkDescriptorBindingFlagsEXT get_layout_binding_flag(const uint32_t binding_index) const;
 
 	const std::vector<ShaderModule *> &get_shader_modules() const;
 
+	/**
+	 * @brief Update template writing all the descriptors of the layout from an array of DescriptorUpdateInfo
+	 * @return The template, or VK_NULL_HANDLE if the layout has update-after-bind bindings or too many descriptors
+	 */
+	VkDescriptorUpdateTemplate get_update_template() const;
+
+	/// @return Index of the first descriptor of a binding in the data of the update template, or ~0U if the binding isn't written by it
+	uint32_t get_update_template_offset(const uint32_t binding_index) const;
+
+	/// @return Number of descriptors written by the update template
+	uint32_t get_update_template_size() const;
+
+  private:
+	// Largest number of descriptors written with an update template, larger arrays are updated with descriptor writes
+	static constexpr uint32_t max_update_template_size = 64;
+
+	void create_update_template();
+
   private:
 	vkb::core::DeviceC &device;
 
@@ -97,5 +128,11 @@ class DescriptorSetLayout
 	std::unordered_map<std::string, uint32_t> resources_lookup;
 
 	std::vector<ShaderModule *> shader_modules;
+
+	VkDescriptorUpdateTemplate update_template{VK_NULL_HANDLE};
+
+	std::vector<uint32_t> update_template_offsets;
+
+	uint32_t update_template_size{0};
 };
 }        // namespace vkb
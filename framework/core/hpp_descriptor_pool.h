@@ -1,4 +1,4 @@
-/* Copyright (c) 2023-2025, NVIDIA CORPORATION. All rights reserved.
+/* Copyright (c) 2023-2026, NVIDIA CORPORATION. All rights reserved.
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -43,6 +43,11 @@ class HPPDescriptorPool : private vkb::DescriptorPool
 	    vkb::DescriptorPool(
 	        reinterpret_cast<vkb::core::DeviceC &>(device), reinterpret_cast<vkb::DescriptorSetLayout const &>(descriptor_set_layout), pool_size)
 	{}
+
+	vk::DescriptorSet allocate()
+	{
+		return static_cast<vk::DescriptorSet>(vkb::DescriptorPool::allocate());
+	}
 };
 }        // namespace core
 }        // namespace vkb
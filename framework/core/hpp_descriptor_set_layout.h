@@ -1,4 +1,4 @@
-/* Copyright (c) 2023-2025, NVIDIA CORPORATION. All rights reserved.
+/* Copyright (c) 2023-2026, NVIDIA CORPORATION. All rights reserved.
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -41,6 +41,8 @@ class HPPDescriptorSetLayout : private vkb::DescriptorSetLayout
 {
   public:
 	using vkb::DescriptorSetLayout::get_index;
+	using vkb::DescriptorSetLayout::get_update_template_offset;
+	using vkb::DescriptorSetLayout::get_update_template_size;
 
   public:
 	HPPDescriptorSetLayout(vkb::core::DeviceCpp                            &device,
@@ -70,6 +72,16 @@ class HPPDescriptorSetLayout : private vkb::DescriptorSetLayout
 		    reinterpret_cast<vk::DescriptorSetLayoutBinding *>(vkb::DescriptorSetLayout::get_layout_binding(name).release()));
 	}
 
+	vk::DescriptorSetLayoutBinding const *find_layout_binding(const uint32_t binding_index) const
+	{
+		return reinterpret_cast<vk::DescriptorSetLayoutBinding const *>(vkb::DescriptorSetLayout::find_layout_binding(binding_index));
+	}
+
+	vk::DescriptorUpdateTemplate get_update_template() const
+	{
+		return static_cast<vk::DescriptorUpdateTemplate>(vkb::DescriptorSetLayout::get_update_template());
+	}
+
 	vk::DescriptorBindingFlagsEXT get_layout_binding_flag(const uint32_t binding_index) const
 	{
 		return static_cast<vk::DescriptorBindingFlagsEXT>(vkb::DescriptorSetLayout::get_layout_binding_flag(binding_index));
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019, Sascha Willems
+/* Copyright (c) 2019-2026, Sascha Willems
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -19,6 +19,39 @@
 
 namespace vkb
 {
+void PackedBounds::clear()
+{
+	center_x.clear();
+	center_y.clear();
+	center_z.clear();
+	extent_x.clear();
+	extent_y.clear();
+	extent_z.clear();
+}
+
+void PackedBounds::push_back(const glm::vec3 &min, const glm::vec3 &max)
+{
+	glm::vec3 center = (min + max) * 0.5f;
+	glm::vec3 extent = (max - min) * 0.5f;
+
+	center_x.push_back(center.x);
+	center_y.push_back(center.y);
+	center_z.push_back(center.z);
+	extent_x.push_back(extent.x);
+	extent_y.push_back(extent.y);
+	extent_z.push_back(extent.z);
+}
+
+glm::vec3 PackedBounds::get_center(size_t index) const
+{
+	return {center_x[index], center_y[index], center_z[index]};
+}
+
+size_t PackedBounds::size() const
+{
+	return center_x.size();
+}
+
 void Frustum::update(const glm::mat4 &matrix)
 {
 	planes[LEFT].x = matrix[0].w + matrix[0].x;
@@ -69,6 +102,38 @@ bool Frustum::check_sphere(glm::vec3 pos, float radius)
 	}
 	return true;
 }
+
+void Frustum::check_boxes(const PackedBounds &bounds, std::vector<uint8_t> &visible) const
+{
+	const size_t count = bounds.size();
+
+	visible.assign(count, 1);
+
+	const float *center_x = bounds.center_x.data();
+	const float *center_y = bounds.center_y.data();
+	const float *center_z = bounds.center_z.data();
+	const float *extent_x = bounds.extent_x.data();
+	const float *extent_y = bounds.extent_y.data();
+	const float *extent_z = bounds.extent_z.data();
+	uint8_t     *result   = visible.data();
+
+	// Test all boxes against one plane at a time: the inner loop is branchless over contiguous arrays,
+	// which lets the compiler vectorize it for the SIMD unit of the target
+	for (const auto &plane : planes)
+	{
+		const glm::vec3 abs_normal = glm::abs(glm::vec3(plane));
+
+		for (size_t i = 0; i < count; i++)
+		{
+			// Signed distance of the center, and projection of the extent on the plane normal
+			float distance = plane.x * center_x[i] + plane.y * center_y[i] + plane.z * center_z[i] + plane.w;
+			float radius   = abs_normal.x * extent_x[i] + abs_normal.y * extent_y[i] + abs_normal.z * extent_z[i];
+
+			result[i] &= static_cast<uint8_t>(distance + radius >= 0.0f);
+		}
+	}
+}
+
 const std::array<glm::vec4, 6> &Frustum::get_planes() const
 {
 	return planes;
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2024, Sascha Willems
+/* Copyright (c) 2019-2026, Sascha Willems
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -18,6 +18,8 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
+#include <vector>
 
 #include "common/error.h"
 
@@ -35,6 +37,33 @@ enum Side
 	FRONT  = 5
 };
 
+/**
+ * @brief Axis aligned bounding boxes stored as a structure of arrays, so that they can be tested
+ *        against a plane over contiguous floats
+ */
+struct PackedBounds
+{
+	std::vector<float> center_x;
+	std::vector<float> center_y;
+	std::vector<float> center_z;
+	std::vector<float> extent_x;
+	std::vector<float> extent_y;
+	std::vector<float> extent_z;
+
+	void clear();
+
+	/**
+	 * @brief Appends a box
+	 * @param min The minimum corner of the box
+	 * @param max The maximum corner of the box
+	 */
+	void push_back(const glm::vec3 &min, const glm::vec3 &max);
+
+	glm::vec3 get_center(size_t index) const;
+
+	size_t size() const;
+};
+
 /**
  * @brief Represents a matrix by extracting its planes. Responsible for doing
  * intersection tests
@@ -55,6 +84,14 @@ class Frustum
 	 */
 	bool check_sphere(glm::vec3 pos, float radius);
 
+	/**
+	 * @brief Checks which boxes intersect the Frustum
+	 *        Boxes are only rejected when fully outside of a plane, so a few boxes near the corners are kept while outside
+	 * @param bounds The boxes to check
+	 * @param visible Set to 1 for each box which intersects the Frustum, 0 otherwise
+	 */
+	void check_boxes(const PackedBounds &bounds, std::vector<uint8_t> &visible) const;
+
 	const std::array<glm::vec4, 6> &get_planes() const;
 
   private:
@@ -19,6 +19,7 @@
 #define TINYGLTF_IMPLEMENTATION
 #include "gltf_loader.h"
 
+#include <deque>
 #include <future>
 #include <limits>
 #include <queue>
@@ -26,6 +27,7 @@
 #include "common/error.h"
 
 #include "common/glm_common.h"
+#include "common/job_system.h"
 #include <glm/gtc/type_ptr.hpp>
 
 #include <core/util/profiling.hpp>
@@ -494,6 +496,16 @@ std::unique_ptr<sg::SubMesh> GLTFLoader::read_model_from_file(const std::string
 	return std::move(load_model(index, storage_buffer, additional_buffer_usage_flags));
 }
 
+void GLTFLoader::set_packed_geometry(bool packed)
+{
+	packed_geometry = packed;
+}
+
+void GLTFLoader::set_decoded_image_cache(bool enabled)
+{
+	decoded_image_cache = enabled;
+}
+
 vkb::scene_graph::SceneC GLTFLoader::load_scene(int scene_index, VkBufferUsageFlags additional_buffer_usage_flags)
 {
 	PROFILE_SCOPE("Process Scene");
@@ -552,29 +564,61 @@ vkb::scene_graph::SceneC GLTFLoader::load_scene(int scene_index, VkBufferUsageFl
 	// Load images
 	auto image_count = to_u32(model.images.size());
 
-	std::vector<std::future<std::unique_ptr<sg::Image>>> image_component_futures;
-	for (size_t image_index = 0; image_index < image_count; image_index++)
-	{
-		image_component_futures.push_back(std::async(
-		    [this, image_index]() {
-			    auto image = parse_image(model.images[image_index]);
+	// Images are decoded on the job system, a bounded number of them ahead of the upload to keep memory footprint low
+	auto  &job_system         = JobSystem::get();
+	size_t max_decodes_ahead  = 2 * job_system.get_thread_count();
+	size_t next_decoded_image = 0;
 
-			    LOGI("Loaded gltf image #{} ({})", image_index, model.images[image_index].uri.c_str());
+	std::vector<std::future<std::unique_ptr<sg::Image>>> image_component_futures(image_count);
 
-			    return image;
-		    }));
-	}
+	auto decode_images_ahead = [&](size_t uploaded_count) {
+		for (; next_decoded_image < image_count && next_decoded_image < uploaded_count + max_decodes_ahead; next_decoded_image++)
+		{
+			image_component_futures[next_decoded_image] = job_system.submit(
+			    [this, image_index = next_decoded_image]() {
+				    auto image = parse_image(model.images[image_index]);
+
+				    LOGI("Loaded gltf image #{} ({})", image_index, model.images[image_index].uri.c_str());
+
+				    return image;
+			    });
+		}
+	};
+
+	decode_images_ahead(0);
 
 	std::vector<std::unique_ptr<sg::Image>> image_components;
 
+	// A batch of image uploads submitted to the GPU, its staging buffers are released once its fence is signaled
+	struct UploadBatch
+	{
+		VkFence                         fence{VK_NULL_HANDLE};
+		std::vector<vkb::core::BufferC> staging_buffers;
+	};
+
 	// Upload images to GPU. We do this in batches of 64MB of data to avoid needing
 	// double the amount of memory (all the images and all the corresponding buffers).
 	// This helps keep memory footprint lower which is helpful on smaller devices.
+	// Up to two batches are in flight, so that the next batch is staged while the previous one is copied.
+	const size_t            max_batches_in_flight = 2;
+	std::deque<UploadBatch> batches_in_flight;
+
+	auto &queue = device.get_queue_by_flags(VK_QUEUE_GRAPHICS_BIT, 0);
+
 	size_t image_index = 0;
 	while (image_index < image_count)
 	{
-		std::vector<vkb::core::BufferC> transient_buffers;
+		if (batches_in_flight.size() == max_batches_in_flight)
+		{
+			// Wait for the oldest batch only, the most recent one keeps copying meanwhile
+			auto &oldest_batch = batches_in_flight.front();
+			VK_CHECK(vkWaitForFences(device.get_handle(), 1, &oldest_batch.fence, VK_TRUE, std::numeric_limits<uint64_t>::max()));
+			batches_in_flight.pop_front();
+		}
+
+		UploadBatch batch;
 
+		// Every batch records its own command buffer, the pool is only reset once all batches completed
 		auto command_buffer = device.get_command_pool().request_command_buffer();
 
 		command_buffer->begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT, 0);
@@ -585,7 +629,9 @@ vkb::scene_graph::SceneC GLTFLoader::load_scene(int scene_index, VkBufferUsageFl
 		while (image_index < image_count && batch_size < 64 * 1024 * 1024)
 		{
 			// Wait for this image to complete loading, then stage for upload
-			image_components.push_back(image_component_futures[image_index].get());
+			image_components.push_back(job_system.wait(image_component_futures[image_index]));
+
+			decode_images_ahead(image_index + 1);
 
 			auto &image = image_components[image_index];
 
@@ -595,33 +641,32 @@ vkb::scene_graph::SceneC GLTFLoader::load_scene(int scene_index, VkBufferUsageFl
 
 			upload_image_to_gpu(*command_buffer, stage_buffer, *image);
 
-			transient_buffers.push_back(std::move(stage_buffer));
+			batch.staging_buffers.push_back(std::move(stage_buffer));
 
 			image_index++;
 		}
 
 		command_buffer->end();
 
-		auto &queue = device.get_queue_by_flags(VK_QUEUE_GRAPHICS_BIT, 0);
-
-		queue.submit(*command_buffer, device.get_fence_pool().request_fence());
+		batch.fence = device.get_fence_pool().request_fence();
 
-		device.get_fence_pool().wait();
-		device.get_fence_pool().reset();
-		device.get_command_pool().reset_pool();
-		device.wait_idle();
+		queue.submit(*command_buffer, batch.fence);
 
-		// Remove the staging buffers for the batch we just processed
-		transient_buffers.clear();
+		batches_in_flight.push_back(std::move(batch));
 	}
 
+	device.get_fence_pool().wait();
+	device.get_fence_pool().reset();
+	device.get_command_pool().reset_pool();
+
+	// Remove the staging buffers of the last batches
+	batches_in_flight.clear();
+
 	scene.set_components(std::move(image_components));
 
 	auto elapsed_time = timer.stop();
 
-	auto thread_count = std::thread::hardware_concurrency();
-	thread_count      = thread_count == 0 ? 1 : thread_count;
-	LOGI("Time spent loading images: {} seconds across {} threads.", vkb::to_string(elapsed_time), thread_count);
+	LOGI("Time spent loading images: {} seconds across {} threads.", vkb::to_string(elapsed_time), job_system.get_thread_count());
 
 	// Load textures
 	auto images                  = scene.get_components<sg::Image>();
@@ -727,6 +772,19 @@ vkb::scene_graph::SceneC GLTFLoader::load_scene(int scene_index, VkBufferUsageFl
 	// Load meshes
 	auto materials = scene.get_components<sg::PBRMaterial>();
 
+	// With packed geometry, vertex attributes are gathered per attribute name into streams shared by all submeshes
+	struct PackedStream
+	{
+		uint32_t                   stride;
+		std::vector<uint8_t>       data;
+		std::vector<sg::SubMesh *> submeshes;
+	};
+
+	std::unordered_map<std::string, PackedStream> packed_streams;
+	std::vector<uint8_t>                          packed_indices;
+	std::vector<sg::SubMesh *>                    packed_indexed_submeshes;
+	uint32_t                                      packed_vertex_count = 0;
+
 	for (auto &gltf_mesh : model.meshes)
 	{
 		PROFILE_SCOPE("Processing Mesh");
@@ -740,6 +798,29 @@ vkb::scene_graph::SceneC GLTFLoader::load_scene(int scene_index, VkBufferUsageFl
 			auto submesh_name = fmt::format("'{}' mesh, primitive #{}", gltf_mesh.name, i_primitive);
 			auto submesh      = std::make_unique<sg::SubMesh>(std::move(submesh_name));
 
+			// A primitive can only be packed if each of its attributes has the stride of the stream it goes to,
+			// otherwise it keeps buffers of its own
+			bool   packed                 = packed_geometry;
+			size_t primitive_vertex_count = 0;
+			for (auto &attribute : gltf_primitive.attributes)
+			{
+				std::string attrib_name = attribute.first;
+				std::transform(attrib_name.begin(), attrib_name.end(), attrib_name.begin(), ::tolower);
+
+				auto stream_it = packed_streams.find(attrib_name);
+				if (stream_it != packed_streams.end() && stream_it->second.stride != get_attribute_stride(&model, attribute.second))
+				{
+					packed = false;
+				}
+
+				primitive_vertex_count = std::max(primitive_vertex_count, get_attribute_size(&model, attribute.second));
+			}
+
+			if (packed)
+			{
+				submesh->vertex_offset = static_cast<int32_t>(packed_vertex_count);
+			}
+
 			for (auto &attribute : gltf_primitive.attributes)
 			{
 				std::string attrib_name = attribute.first;
@@ -753,15 +834,27 @@ vkb::scene_graph::SceneC GLTFLoader::load_scene(int scene_index, VkBufferUsageFl
 					submesh->vertices_count = to_u32(model.accessors[attribute.second].count);
 				}
 
-				vkb::core::BufferC buffer{device,
-				                          vertex_data.size(),
-				                          VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | additional_buffer_usage_flags,
-				                          VMA_MEMORY_USAGE_CPU_TO_GPU};
-				buffer.update(vertex_data);
-				buffer.set_debug_name(fmt::format("'{}' mesh, primitive #{}: '{}' vertex buffer",
-				                                  gltf_mesh.name, i_primitive, attrib_name));
+				if (packed)
+				{
+					auto &stream = packed_streams.try_emplace(attrib_name, PackedStream{to_u32(get_attribute_stride(&model, attribute.second))}).first->second;
 
-				submesh->vertex_buffers.insert(std::make_pair(attrib_name, std::move(buffer)));
+					// Streams the previous submeshes did not fill are padded, so that all streams share the same vertex offsets
+					stream.data.resize(static_cast<size_t>(packed_vertex_count) * stream.stride);
+					stream.data.insert(stream.data.end(), vertex_data.begin(), vertex_data.end());
+					stream.submeshes.push_back(submesh.get());
+				}
+				else
+				{
+					vkb::core::BufferC buffer{device,
+					                          vertex_data.size(),
+					                          VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | additional_buffer_usage_flags,
+					                          VMA_MEMORY_USAGE_CPU_TO_GPU};
+					buffer.update(vertex_data);
+					buffer.set_debug_name(fmt::format("'{}' mesh, primitive #{}: '{}' vertex buffer",
+					                                  gltf_mesh.name, i_primitive, attrib_name));
+
+					submesh->vertex_buffers.insert(std::make_pair(attrib_name, std::move(buffer)));
+				}
 
 				sg::VertexAttribute attrib;
 				attrib.format = get_attribute_format(&model, attribute.second);
@@ -796,14 +889,30 @@ vkb::scene_graph::SceneC GLTFLoader::load_scene(int scene_index, VkBufferUsageFl
 						break;
 				}
 
-				submesh->index_buffer = std::make_unique<vkb::core::BufferC>(device,
-				                                                             index_data.size(),
-				                                                             VK_BUFFER_USAGE_INDEX_BUFFER_BIT | additional_buffer_usage_flags,
-				                                                             VMA_MEMORY_USAGE_GPU_TO_CPU);
-				submesh->index_buffer->set_debug_name(fmt::format("'{}' mesh, primitive #{}: index buffer",
-				                                                  gltf_mesh.name, i_primitive));
+				if (packed)
+				{
+					// All packed submeshes share a single 32-bit index buffer
+					if (submesh->index_type == VK_INDEX_TYPE_UINT16)
+					{
+						index_data = convert_underlying_data_stride(index_data, 2, 4);
+					}
+					submesh->index_type  = VK_INDEX_TYPE_UINT32;
+					submesh->first_index = to_u32(packed_indices.size() / sizeof(uint32_t));
 
-				submesh->index_buffer->update(index_data);
+					packed_indices.insert(packed_indices.end(), index_data.begin(), index_data.end());
+					packed_indexed_submeshes.push_back(submesh.get());
+				}
+				else
+				{
+					submesh->index_buffer = std::make_unique<vkb::core::BufferC>(device,
+					                                                             index_data.size(),
+					                                                             VK_BUFFER_USAGE_INDEX_BUFFER_BIT | additional_buffer_usage_flags,
+					                                                             VMA_MEMORY_USAGE_GPU_TO_CPU);
+					submesh->index_buffer->set_debug_name(fmt::format("'{}' mesh, primitive #{}: index buffer",
+					                                                  gltf_mesh.name, i_primitive));
+
+					submesh->index_buffer->update(index_data);
+				}
 			}
 			else
 			{
@@ -820,6 +929,11 @@ vkb::scene_graph::SceneC GLTFLoader::load_scene(int scene_index, VkBufferUsageFl
 				submesh->set_material(*materials[gltf_primitive.material]);
 			}
 
+			if (packed)
+			{
+				packed_vertex_count += to_u32(primitive_vertex_count);
+			}
+
 			mesh->add_submesh(*submesh);
 
 			scene.add_component(std::move(submesh));
@@ -828,6 +942,71 @@ vkb::scene_graph::SceneC GLTFLoader::load_scene(int scene_index, VkBufferUsageFl
 		scene.add_component(std::move(mesh));
 	}
 
+	if (!packed_streams.empty() || !packed_indices.empty())
+	{
+		// Upload the packed geometry to device local memory
+		auto &queue = device.get_queue_by_flags(VK_QUEUE_GRAPHICS_BIT, 0);
+
+		auto command_buffer = device.get_command_pool().request_command_buffer();
+
+		command_buffer->begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+
+		std::vector<vkb::core::BufferC> transient_buffers;
+
+		auto upload = [&](const std::vector<uint8_t> &data, VkBufferUsageFlags usage, VkAccessFlags dst_access_mask, const std::string &debug_name) {
+			vkb::core::BufferC stage_buffer = vkb::core::BufferC::create_staging_buffer(device, data);
+
+			auto buffer = std::make_shared<vkb::core::BufferC>(device,
+			                                                   data.size(),
+			                                                   usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT | additional_buffer_usage_flags,
+			                                                   VMA_MEMORY_USAGE_GPU_ONLY);
+			buffer->set_debug_name(debug_name);
+
+			command_buffer->copy_buffer(stage_buffer, *buffer, data.size());
+
+			BufferMemoryBarrier memory_barrier;
+			memory_barrier.src_access_mask = VK_ACCESS_TRANSFER_WRITE_BIT;
+			memory_barrier.dst_access_mask = dst_access_mask;
+			memory_barrier.src_stage_mask  = VK_PIPELINE_STAGE_TRANSFER_BIT;
+			memory_barrier.dst_stage_mask  = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+			command_buffer->buffer_memory_barrier(*buffer, 0, VK_WHOLE_SIZE, memory_barrier);
+
+			transient_buffers.push_back(std::move(stage_buffer));
+
+			return buffer;
+		};
+
+		for (auto &[attrib_name, stream] : packed_streams)
+		{
+			// Pad the end of the stream too, so that every submesh reads within the buffer
+			stream.data.resize(static_cast<size_t>(packed_vertex_count) * stream.stride);
+
+			auto buffer = upload(stream.data, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT,
+			                     fmt::format("packed '{}' vertex buffer", attrib_name));
+
+			for (auto *submesh : stream.submeshes)
+			{
+				submesh->shared_vertex_buffers[attrib_name] = buffer;
+			}
+		}
+
+		if (!packed_indices.empty())
+		{
+			auto buffer = upload(packed_indices, VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_ACCESS_INDEX_READ_BIT, "packed index buffer");
+
+			for (auto *submesh : packed_indexed_submeshes)
+			{
+				submesh->shared_index_buffer = buffer;
+			}
+		}
+
+		command_buffer->end();
+
+		queue.submit(*command_buffer, device.get_fence_pool().request_fence());
+
+		LOGI("Packed geometry: {} vertices in {} streams, {} indices", packed_vertex_count, packed_streams.size(), packed_indices.size() / sizeof(uint32_t));
+	}
+
 	device.get_fence_pool().wait();
 	device.get_fence_pool().reset();
 	device.get_command_pool().reset_pool();
@@ -1478,7 +1657,14 @@ std::unique_ptr<sg::Image> GLTFLoader::parse_image(tinygltf::Image &gltf_image)
 	{
 		// Load image from uri
 		auto image_uri = model_path + "/" + gltf_image.uri;
-		image          = sg::Image::load(gltf_image.name, image_uri, vkb::sg::Image::Unknown);
+		if (decoded_image_cache)
+		{
+			image = sg::Image::load_cached(gltf_image.name, image_uri, vkb::sg::Image::Unknown);
+		}
+		else
+		{
+			image = sg::Image::load(gltf_image.name, image_uri, vkb::sg::Image::Unknown);
+		}
 	}
 
 	// Check whether the format is supported by the GPU
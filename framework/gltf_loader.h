@@ -92,6 +92,21 @@ class GLTFLoader
 	 */
 	std::unique_ptr<sg::SubMesh> read_model_from_file(const std::string &file_name, uint32_t index, bool storage_buffer = false, VkBufferUsageFlags additional_buffer_usage_flags = 0);
 
+	/**
+	 * @brief Selects how read_scene_from_file stores the geometry of the scene
+	 * @param packed If true, the vertex attributes and indices of all submeshes are packed into a few shared device local
+	 *               buffers, and each submesh records its offsets into them. This lets consecutive draws share bindings.
+	 *               If false, each submesh owns its own buffers.
+	 */
+	void set_packed_geometry(bool packed);
+
+	/**
+	 * @brief Selects whether read_scene_from_file reads PNG and JPEG images back from the on-disk cache of decoded images
+	 * @param enabled If true, images are loaded with sg::Image::load_cached, which writes the decoded texels of each image
+	 *                to the cache directory the first time it is loaded. If false, images are always decoded.
+	 */
+	void set_decoded_image_cache(bool enabled);
+
   protected:
 	virtual std::unique_ptr<vkb::scene_graph::NodeC> parse_node(const tinygltf::Node &gltf_node, size_t index) const;
 
@@ -142,6 +157,12 @@ class GLTFLoader
 	/// The extensions that the GLTFLoader can load mapped to whether they should be enabled or not
 	static std::unordered_map<std::string, bool> supported_extensions;
 
+	/// Whether the geometry of loaded scenes is packed into shared buffers
+	bool packed_geometry{false};
+
+	/// Whether decoded images are read from and written to the on-disk cache
+	bool decoded_image_cache{false};
+
   private:
 	vkb::scene_graph::SceneC load_scene(int scene_index = -1, VkBufferUsageFlags additional_buffer_usage_flags = 0);
 
@@ -35,6 +35,9 @@ class HPPGLTFLoader : private vkb::GLTFLoader
 	    GLTFLoader(reinterpret_cast<vkb::core::DeviceC &>(device))
 	{}
 
+	using vkb::GLTFLoader::set_decoded_image_cache;
+	using vkb::GLTFLoader::set_packed_geometry;
+
 	std::unique_ptr<vkb::scene_graph::components::HPPSubMesh> read_model_from_file(
 	    const std::string &file_name, uint32_t index, bool storage_buffer = false, vk::BufferUsageFlags additional_buffer_usage_flags = {})
 	{
@@ -1,4 +1,4 @@
-/* Copyright (c) 2023-2025, NVIDIA CORPORATION. All rights reserved.
+/* Copyright (c) 2023-2026, NVIDIA CORPORATION. All rights reserved.
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -62,7 +62,10 @@ class HPPResourceBindingState : private vkb::ResourceBindingState
 {
   public:
 	using vkb::ResourceBindingState::clear_dirty;
+	using vkb::ResourceBindingState::get_bound_sets;
+	using vkb::ResourceBindingState::get_dirty_sets;
 	using vkb::ResourceBindingState::is_dirty;
+	using vkb::ResourceBindingState::max_descriptor_sets;
 	using vkb::ResourceBindingState::reset;
 
   public:
@@ -92,9 +95,9 @@ class HPPResourceBindingState : private vkb::ResourceBindingState
 		vkb::ResourceBindingState::bind_input(reinterpret_cast<vkb::core::ImageView const &>(image_view), set, binding, array_element);
 	}
 
-	const std::unordered_map<uint32_t, vkb::HPPResourceSet> &get_resource_sets()
+	const std::array<vkb::HPPResourceSet, max_descriptor_sets> &get_resource_sets()
 	{
-		return reinterpret_cast<std::unordered_map<uint32_t, vkb::HPPResourceSet> const &>(vkb::ResourceBindingState::get_resource_sets());
+		return reinterpret_cast<std::array<vkb::HPPResourceSet, max_descriptor_sets> const &>(vkb::ResourceBindingState::get_resource_sets());
 	}
 };
 }        // namespace vkb
@@ -17,11 +17,15 @@
 
 #pragma once
 
+#include "common/descriptor_set_references.h"
+#include "common/pipeline_compile_queue.h"
+#include "common/resource_cache_index.h"
 #include "core/hpp_descriptor_set.h"
 #include "core/hpp_framebuffer.h"
 #include "core/hpp_pipeline.h"
 #include "core/hpp_pipeline_layout.h"
 #include "core/hpp_render_pass.h"
+#include "filesystem/filesystem.hpp"
 #include "hpp_resource_record.h"
 #include "hpp_resource_replay.h"
 #include <vulkan/vulkan.hpp>
@@ -52,15 +56,32 @@ using RenderTargetCpp = RenderTarget<vkb::BindingType::Cpp>;
  */
 struct HPPResourceCacheState
 {
-	std::unordered_map<std::size_t, vkb::core::HPPShaderModule>        shader_modules;
-	std::unordered_map<std::size_t, vkb::core::HPPPipelineLayout>      pipeline_layouts;
-	std::unordered_map<std::size_t, vkb::core::HPPDescriptorSetLayout> descriptor_set_layouts;
-	std::unordered_map<std::size_t, vkb::core::HPPDescriptorPool>      descriptor_pools;
-	std::unordered_map<std::size_t, vkb::core::HPPRenderPass>          render_passes;
-	std::unordered_map<std::size_t, vkb::core::HPPGraphicsPipeline>    graphics_pipelines;
-	std::unordered_map<std::size_t, vkb::core::HPPComputePipeline>     compute_pipelines;
-	std::unordered_map<std::size_t, vkb::core::HPPDescriptorSet>       descriptor_sets;
-	std::unordered_map<std::size_t, vkb::core::HPPFramebuffer>         framebuffers;
+	std::unordered_map<ResourceKey, vkb::core::HPPShaderModule>        shader_modules;
+	std::unordered_map<ResourceKey, vkb::core::HPPPipelineLayout>      pipeline_layouts;
+	std::unordered_map<ResourceKey, vkb::core::HPPDescriptorSetLayout> descriptor_set_layouts;
+	std::unordered_map<ResourceKey, vkb::core::HPPDescriptorPool>      descriptor_pools;
+	std::unordered_map<ResourceKey, vkb::core::HPPRenderPass>          render_passes;
+	std::unordered_map<ResourceKey, vkb::core::HPPGraphicsPipeline>    graphics_pipelines;
+	std::unordered_map<ResourceKey, vkb::core::HPPComputePipeline>     compute_pipelines;
+	std::unordered_map<ResourceKey, vkb::core::HPPDescriptorSet>       descriptor_sets;
+	std::unordered_map<ResourceKey, vkb::core::HPPFramebuffer>         framebuffers;
+	DescriptorSetReferences                                            descriptor_set_references;
+};
+
+/**
+ * @brief vulkan.hpp version of the vkb::ResourceCacheIndexState struct
+ */
+struct HPPResourceCacheIndexState
+{
+	ResourceCacheIndex<vkb::core::HPPShaderModule>        shader_modules;
+	ResourceCacheIndex<vkb::core::HPPPipelineLayout>      pipeline_layouts;
+	ResourceCacheIndex<vkb::core::HPPDescriptorSetLayout> descriptor_set_layouts;
+	ResourceCacheIndex<vkb::core::HPPDescriptorPool>      descriptor_pools;
+	ResourceCacheIndex<vkb::core::HPPRenderPass>          render_passes;
+	ResourceCacheIndex<vkb::core::HPPGraphicsPipeline>    graphics_pipelines;
+	ResourceCacheIndex<vkb::core::HPPComputePipeline>     compute_pipelines;
+	ResourceCacheIndex<vkb::core::HPPDescriptorSet>       descriptor_sets;
+	ResourceCacheIndex<vkb::core::HPPFramebuffer>         framebuffers;
 };
 
 /**
@@ -81,7 +102,17 @@ class HPPResourceCache
 	void                               clear();
 	void                               clear_framebuffers();
 	void                               clear_pipelines();
+	void                               evict(uint32_t oldest_frame_in_flight);
+	vk::Pipeline                       find_fallback_pipeline(vkb::rendering::PipelineStateCpp const &pipeline_state) const;
+	const ResourceCacheBudget         &get_budget() const;
 	const HPPResourceCacheState       &get_internal_state() const;
+	const HPPResourceCacheIndexState  &get_index_state() const;
+	size_t                             get_pipeline_compile_queue_depth() const;
+	ResourceCacheStats                 get_stats() const;
+	void                               invalidate_descriptor_sets(const std::vector<vk::ImageView> &image_views, const std::vector<vk::Buffer> &buffers = {});
+	bool                               load_pipeline_cache(const vkb::filesystem::Path &path);
+	uint32_t                           next_frame();
+	void                               register_fallback_pipeline(vkb::rendering::PipelineStateCpp &pipeline_state);
 	vkb::core::HPPComputePipeline     &request_compute_pipeline(vkb::rendering::PipelineStateCpp &pipeline_state);
 	vkb::core::HPPDescriptorSet       &request_descriptor_set(vkb::core::HPPDescriptorSetLayout          &descriptor_set_layout,
 	                                                          const BindingMap<vk::DescriptorBufferInfo> &buffer_infos,
@@ -91,13 +122,18 @@ class HPPResourceCache
 	                                                                 const std::vector<vkb::core::HPPShaderResource> &set_resources);
 	vkb::core::HPPFramebuffer         &request_framebuffer(const vkb::rendering::RenderTargetCpp &render_target, const vkb::core::HPPRenderPass &render_pass);
 	vkb::core::HPPGraphicsPipeline    &request_graphics_pipeline(vkb::rendering::PipelineStateCpp &pipeline_state);
+	vkb::core::HPPGraphicsPipeline    *request_graphics_pipeline_async(vkb::rendering::PipelineStateCpp &pipeline_state);
 	vkb::core::HPPPipelineLayout      &request_pipeline_layout(const std::vector<vkb::core::HPPShaderModule *> &shader_modules);
 	vkb::core::HPPRenderPass          &request_render_pass(const std::vector<vkb::rendering::AttachmentCpp> &attachments,
 	                                                       const std::vector<vkb::common::HPPLoadStoreInfo> &load_store_infos,
 	                                                       const std::vector<vkb::core::HPPSubpassInfo>     &subpasses);
 	vkb::core::HPPShaderModule        &request_shader_module(
 	           vk::ShaderStageFlagBits stage, const vkb::core::HPPShaderSource &glsl_source, const vkb::core::HPPShaderVariant &shader_variant = {});
+	void                 save_pipeline_cache(const vkb::filesystem::Path &path);
 	std::vector<uint8_t> serialize();
+	void                 serialize_to_file(const vkb::filesystem::Path &path);
+	void                 set_async_pipeline_compilation(bool enabled);
+	void                 set_budget(const ResourceCacheBudget &budget);
 	void                 set_pipeline_cache(vk::PipelineCache pipeline_cache);
 
 	/// @brief Update those descriptor sets referring to old views
@@ -105,21 +141,29 @@ class HPPResourceCache
 	/// @param new_views New image views to be referred
 	void update_descriptor_sets(const std::vector<vkb::core::HPPImageView> &old_views, const std::vector<vkb::core::HPPImageView> &new_views);
 
+	void wait_pipeline_compilations();
 	void warmup(const std::vector<uint8_t> &data);
+	bool warmup_from_file(const vkb::filesystem::Path &path);
 
   private:
-	vkb::core::DeviceCpp  &device;
-	vkb::HPPResourceRecord recorder                    = {};
-	vkb::HPPResourceReplay replayer                    = {};
-	vk::PipelineCache      pipeline_cache              = nullptr;
-	HPPResourceCacheState  state                       = {};
-	std::mutex             descriptor_set_mutex        = {};
-	std::mutex             pipeline_layout_mutex       = {};
-	std::mutex             shader_module_mutex         = {};
-	std::mutex             descriptor_set_layout_mutex = {};
-	std::mutex             graphics_pipeline_mutex     = {};
-	std::mutex             render_pass_mutex           = {};
-	std::mutex             compute_pipeline_mutex      = {};
-	std::mutex             framebuffer_mutex           = {};
+	vkb::core::DeviceCpp      &device;
+	vkb::HPPResourceRecord     recorder                    = {};
+	vkb::HPPResourceReplay     replayer                    = {};
+	vk::PipelineCache          pipeline_cache              = nullptr;
+	HPPResourceCacheState      state                       = {};
+	std::mutex                 descriptor_set_mutex        = {};
+	std::mutex                 pipeline_layout_mutex       = {};
+	std::mutex                 shader_module_mutex         = {};
+	std::mutex                 descriptor_set_layout_mutex = {};
+	std::mutex                 graphics_pipeline_mutex     = {};
+	std::mutex                 render_pass_mutex           = {};
+	std::mutex                 compute_pipeline_mutex      = {};
+	std::mutex                 framebuffer_mutex           = {};
+	HPPResourceCacheIndexState index_state                 = {};
+	ResourceCacheBudget        budget                      = {};
+	bool                       owns_pipeline_cache         = false;
+
+	// Last member, so that its destructor waits for the pipelines being built before the rest of the cache is destroyed
+	PipelineCompileQueue pipeline_compile_queue;
 };
 }        // namespace vkb
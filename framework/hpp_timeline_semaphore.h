@@ -0,0 +1,54 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "timeline_semaphore.h"
+#include <vulkan/vulkan.hpp>
+
+namespace vkb
+{
+namespace core
+{
+template <vkb::BindingType bindingType>
+class Device;
+using DeviceCpp = Device<vkb::BindingType::Cpp>;
+}        // namespace core
+
+/**
+ * @brief facade class around vkb::TimelineSemaphore, providing a vulkan.hpp-based interface
+ *
+ * See vkb::TimelineSemaphore for documentation
+ */
+class HPPTimelineSemaphore : private vkb::TimelineSemaphore
+{
+  public:
+	using vkb::TimelineSemaphore::get_last_value;
+	using vkb::TimelineSemaphore::is_signaled;
+	using vkb::TimelineSemaphore::request_value;
+	using vkb::TimelineSemaphore::wait;
+
+	HPPTimelineSemaphore(vkb::core::DeviceCpp &device) :
+	    vkb::TimelineSemaphore(reinterpret_cast<vkb::core::DeviceC &>(device))
+	{}
+
+	vk::Semaphore get_handle() const
+	{
+		return static_cast<vk::Semaphore>(vkb::TimelineSemaphore::get_handle());
+	}
+};
+}        // namespace vkb
@@ -0,0 +1,261 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "rendering/frame_readback.h"
+
+#include "common/job_system.h"
+#include "core/command_buffer.h"
+#include "filesystem/legacy.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace vkb
+{
+namespace rendering
+{
+FrameReadback::FrameReadback(vkb::rendering::RenderContextC &render_context, uint32_t ring_size) :
+    render_context{render_context},
+    command_pool{render_context.get_device(), render_context.get_device().get_queue_by_flags(VK_QUEUE_GRAPHICS_BIT, 0).get_family_index()},
+    slots(std::max(ring_size, 1u))
+{
+	VkFenceCreateInfo create_info{VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
+
+	for (auto &slot : slots)
+	{
+		VK_CHECK(vkCreateFence(render_context.get_device().get_handle(), &create_info, nullptr, &slot.fence));
+		slot.command_buffer = command_pool.request_command_buffer();
+	}
+
+	// Create the screenshots directory now, rather than from several jobs at once
+	vkb::fs::path::get(vkb::fs::path::Type::Screenshots);
+}
+
+FrameReadback::~FrameReadback()
+{
+	flush();
+
+	for (auto &slot : slots)
+	{
+		vkDestroyFence(render_context.get_device().get_handle(), slot.fence, nullptr);
+	}
+}
+
+void FrameReadback::capture(const std::string &filename, ReadbackFormat format)
+{
+	assert(render_context.get_format() == VK_FORMAT_R8G8B8A8_UNORM ||
+	       render_context.get_format() == VK_FORMAT_B8G8R8A8_UNORM ||
+	       render_context.get_format() == VK_FORMAT_R8G8B8A8_SRGB ||
+	       render_context.get_format() == VK_FORMAT_B8G8R8A8_SRGB);
+
+	// We want the last completed frame since we don't want to be reading from an incomplete framebuffer
+	auto &frame = render_context.get_last_rendered_frame();
+	assert(!frame.get_render_target().get_views().empty());
+	auto &src_image_view = frame.get_render_target().get_views()[0];
+
+	Slot &slot = acquire_slot();
+
+	slot.filename = filename;
+	slot.format   = format;
+	slot.width    = render_context.get_surface_extent().width;
+	slot.height   = render_context.get_surface_extent().height;
+	slot.sequence = next_sequence++;
+
+	// Check if framebuffer images are in a BGR format
+	auto bgr_formats = {VK_FORMAT_B8G8R8A8_SRGB, VK_FORMAT_B8G8R8A8_UNORM, VK_FORMAT_B8G8R8A8_SNORM};
+	slot.swizzle     = std::ranges::find(bgr_formats, src_image_view.get_format()) != bgr_formats.end();
+
+	// The buffers are kept across captures, and only created again when the surface is resized
+	VkDeviceSize dst_size = static_cast<VkDeviceSize>(slot.width) * slot.height * 4;
+	if (!slot.buffer || slot.buffer->get_size() != dst_size)
+	{
+		slot.buffer = std::make_unique<vkb::core::BufferC>(render_context.get_device(),
+		                                                   dst_size,
+		                                                   VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+		                                                   VMA_MEMORY_USAGE_GPU_TO_CPU,
+		                                                   VMA_ALLOCATION_CREATE_MAPPED_BIT);
+	}
+
+	record_copy(slot, src_image_view);
+
+	VK_CHECK(vkResetFences(render_context.get_device().get_handle(), 1, &slot.fence));
+
+	const auto &queue = render_context.get_device().get_queue_by_flags(VK_QUEUE_GRAPHICS_BIT, 0);
+	queue.submit(*slot.command_buffer, slot.fence);
+
+	slot.state = SlotState::Copying;
+}
+
+void FrameReadback::collect()
+{
+	for (auto &slot : slots)
+	{
+		if (slot.state == SlotState::Copying && vkGetFenceStatus(render_context.get_device().get_handle(), slot.fence) == VK_SUCCESS)
+		{
+			start_writing(slot);
+		}
+
+		if (slot.state == SlotState::Writing && slot.written.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+		{
+			slot.written.get();
+			slot.state = SlotState::Free;
+		}
+	}
+}
+
+void FrameReadback::flush()
+{
+	for (auto &slot : slots)
+	{
+		wait(slot);
+	}
+}
+
+size_t FrameReadback::get_pending_count() const
+{
+	return std::ranges::count_if(slots, [](const Slot &slot) { return slot.state != SlotState::Free; });
+}
+
+FrameReadback::Slot &FrameReadback::acquire_slot()
+{
+	collect();
+
+	auto free_slot = std::ranges::find_if(slots, [](const Slot &slot) { return slot.state == SlotState::Free; });
+	if (free_slot != slots.end())
+	{
+		return *free_slot;
+	}
+
+	// All the captures are in flight, wait for the oldest one only
+	auto &oldest_slot = *std::ranges::min_element(slots, {}, &Slot::sequence);
+	wait(oldest_slot);
+
+	return oldest_slot;
+}
+
+void FrameReadback::record_copy(Slot &slot, vkb::core::ImageView const &src_image_view)
+{
+	auto &command_buffer = *slot.command_buffer;
+
+	command_buffer.reset(vkb::CommandBufferResetMode::ResetIndividually);
+	command_buffer.begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+
+	// Enable framebuffer image view to be read from, once the frame is done writing it
+	{
+		ImageMemoryBarrier memory_barrier{};
+		memory_barrier.old_layout      = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+		memory_barrier.new_layout      = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+		memory_barrier.src_access_mask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+		memory_barrier.dst_access_mask = VK_ACCESS_TRANSFER_READ_BIT;
+		memory_barrier.src_stage_mask  = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+		memory_barrier.dst_stage_mask  = VK_PIPELINE_STAGE_TRANSFER_BIT;
+
+		command_buffer.image_memory_barrier(src_image_view, memory_barrier);
+	}
+
+	// Copy framebuffer image memory
+	VkBufferImageCopy image_copy_region{};
+	image_copy_region.bufferRowLength             = slot.width;
+	image_copy_region.bufferImageHeight           = slot.height;
+	image_copy_region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+	image_copy_region.imageSubresource.layerCount = 1;
+	image_copy_region.imageExtent.width           = slot.width;
+	image_copy_region.imageExtent.height          = slot.height;
+	image_copy_region.imageExtent.depth           = 1;
+
+	command_buffer.copy_image_to_buffer(src_image_view.get_image(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, *slot.buffer, {image_copy_region});
+
+	// Make the copy visible to the host once the fence is signaled
+	{
+		BufferMemoryBarrier memory_barrier{};
+		memory_barrier.src_access_mask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		memory_barrier.dst_access_mask = VK_ACCESS_HOST_READ_BIT;
+		memory_barrier.src_stage_mask  = VK_PIPELINE_STAGE_TRANSFER_BIT;
+		memory_barrier.dst_stage_mask  = VK_PIPELINE_STAGE_HOST_BIT;
+
+		command_buffer.buffer_memory_barrier(*slot.buffer, 0, slot.buffer->get_size(), memory_barrier);
+	}
+
+	// Revert back the framebuffer image view from transfer to present
+	{
+		ImageMemoryBarrier memory_barrier{};
+		memory_barrier.old_layout     = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+		memory_barrier.new_layout     = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+		memory_barrier.src_stage_mask = VK_PIPELINE_STAGE_TRANSFER_BIT;
+		memory_barrier.dst_stage_mask = VK_PIPELINE_STAGE_TRANSFER_BIT;
+
+		command_buffer.image_memory_barrier(src_image_view, memory_barrier);
+	}
+
+	command_buffer.end();
+}
+
+void FrameReadback::start_writing(Slot &slot)
+{
+	// The job reads the persistently mapped buffer directly, the slot is not reused until the file is written
+	uint8_t       *data     = slot.buffer->get_mapped_data();
+	uint32_t       width    = slot.width;
+	uint32_t       height   = slot.height;
+	bool           swizzle  = slot.swizzle;
+	ReadbackFormat format   = slot.format;
+	std::string    filename = slot.filename;
+
+	slot.written = vkb::JobSystem::get().submit([data, width, height, swizzle, format, filename]() {
+		// Replace the A component with 255 (remove transparency)
+		// If swapchain format is BGR, swapping the R and B components
+		uint8_t *pixel = data;
+		for (size_t i = 0; i < static_cast<size_t>(width) * height; ++i)
+		{
+			if (swizzle)
+			{
+				std::swap(pixel[0], pixel[2]);
+			}
+			pixel[3] = 255;
+
+			// Get next pixel
+			pixel += 4;
+		}
+
+		if (format == ReadbackFormat::Raw)
+		{
+			vkb::fs::write_raw_image(data, filename, width, height, 4, width * 4);
+		}
+		else
+		{
+			vkb::fs::write_image(data, filename, width, height, 4, width * 4);
+		}
+	});
+
+	slot.state = SlotState::Writing;
+}
+
+void FrameReadback::wait(Slot &slot)
+{
+	if (slot.state == SlotState::Copying)
+	{
+		VK_CHECK(vkWaitForFences(render_context.get_device().get_handle(), 1, &slot.fence, VK_TRUE, std::numeric_limits<uint64_t>::max()));
+		start_writing(slot);
+	}
+
+	if (slot.state == SlotState::Writing)
+	{
+		vkb::JobSystem::get().wait(slot.written);
+		slot.state = SlotState::Free;
+	}
+}
+}        // namespace rendering
+}        // namespace vkb
@@ -0,0 +1,133 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "core/buffer.h"
+#include "core/command_pool.h"
+#include "rendering/render_context.h"
+
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace vkb
+{
+namespace rendering
+{
+/**
+ * @brief File formats the frames read back by a FrameReadback are written in
+ */
+enum class ReadbackFormat
+{
+	Png,
+	Raw        // Tightly packed RGBA8 pixels, with no header
+};
+
+/**
+ * @brief Reads back rendered frames from the GPU and writes them to files without stalling the render thread.
+ *
+ * capture() records a copy of the last rendered swapchain image into one of a ring of persistently mapped
+ * readback buffers and submits it with a fence, without waiting for it. collect(), called once per frame,
+ * hands the buffers whose fence has signaled to the JobSystem, where the pixels are converted to RGBA and
+ * written to the screenshots directory. A buffer is reused once its file has been written, so with a ring
+ * of N buffers the copy of a frame is collected up to N frames later. capture() only waits when all the
+ * buffers are in use.
+ */
+class FrameReadback
+{
+  public:
+	/**
+	 * @param render_context The render context whose frames are read back
+	 * @param ring_size Number of readback buffers, that is the number of captures in flight
+	 */
+	FrameReadback(vkb::rendering::RenderContextC &render_context, uint32_t ring_size = 3);
+
+	FrameReadback(const FrameReadback &) = delete;
+
+	FrameReadback(FrameReadback &&) = delete;
+
+	~FrameReadback();
+
+	FrameReadback &operator=(const FrameReadback &) = delete;
+
+	FrameReadback &operator=(FrameReadback &&) = delete;
+
+	/**
+	 * @brief Records and submits the copy of the last rendered frame, it must be called between frames
+	 * @param filename The name of the file to write, without an extension, relative to the screenshots directory
+	 * @param format The format of the file
+	 */
+	void capture(const std::string &filename, ReadbackFormat format = ReadbackFormat::Png);
+
+	/**
+	 * @brief Starts writing the files of the copies done by the GPU and frees the buffers of the files written, without waiting
+	 */
+	void collect();
+
+	/**
+	 * @brief Waits until all the captures are written to their files
+	 */
+	void flush();
+
+	/// @return The number of captures not written to their files yet
+	size_t get_pending_count() const;
+
+  private:
+	enum class SlotState
+	{
+		Free,
+		Copying,
+		Writing
+	};
+
+	struct Slot
+	{
+		std::unique_ptr<vkb::core::BufferC>        buffer;
+		std::shared_ptr<vkb::core::CommandBufferC> command_buffer;
+		VkFence                                    fence = VK_NULL_HANDLE;
+		SlotState                                  state = SlotState::Free;
+		std::future<void>                          written;
+		std::string                                filename;
+		ReadbackFormat                             format  = ReadbackFormat::Png;
+		uint32_t                                   width   = 0;
+		uint32_t                                   height  = 0;
+		bool                                       swizzle = false;
+
+		/// Order of the capture, used to wait for the oldest one when all the slots are in use
+		uint64_t sequence = 0;
+	};
+
+	Slot &acquire_slot();
+
+	void record_copy(Slot &slot, vkb::core::ImageView const &src_image_view);
+
+	void start_writing(Slot &slot);
+
+	void wait(Slot &slot);
+
+	vkb::rendering::RenderContextC &render_context;
+
+	vkb::core::CommandPoolC command_pool;
+
+	std::vector<Slot> slots;
+
+	uint64_t next_sequence = 0;
+};
+}        // namespace rendering
+}        // namespace vkb
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "common/resource_key.h"
 #include "core/hpp_pipeline_layout.h"
 #include "core/hpp_render_pass.h"
 #include "core/pipeline_layout.h"
@@ -497,6 +498,140 @@ inline void SpecializationConstantState::set_specialization_constant_state(const
 
 //==============================================================================
 
+/// 128-bit hash of a pipeline state, identifying the pipeline it creates
+using PipelineStateHash = std::array<uint64_t, 2>;
+
+struct PipelineStateHasher
+{
+	size_t operator()(PipelineStateHash const &hash) const
+	{
+		return static_cast<size_t>(hash[0]);
+	}
+};
+
+/**
+ * @brief Functions appending the fields of the parts of a pipeline state to a key, shared by the hashes of the pipeline state and the keys of the resource cache
+ */
+inline void append_to_key(ResourceKey &key, vkb::rendering::ColorBlendStateCpp const &color_blend_state)
+{
+	key.append(color_blend_state.logic_op);
+	key.append(color_blend_state.logic_op_enable);
+	key.append(color_blend_state.attachments.size());
+	for (auto const &attachment : color_blend_state.attachments)
+	{
+		key.append(attachment.blend_enable);
+		key.append(attachment.src_color_blend_factor);
+		key.append(attachment.dst_color_blend_factor);
+		key.append(attachment.color_blend_op);
+		key.append(attachment.src_alpha_blend_factor);
+		key.append(attachment.dst_alpha_blend_factor);
+		key.append(attachment.alpha_blend_op);
+		key.append(static_cast<VkColorComponentFlags>(attachment.color_write_mask));
+	}
+}
+
+inline void append_to_key(ResourceKey &key, vkb::rendering::StencilOpStateCpp const &stencil_op_state)
+{
+	key.append(stencil_op_state.fail_op);
+	key.append(stencil_op_state.pass_op);
+	key.append(stencil_op_state.depth_fail_op);
+	key.append(stencil_op_state.compare_op);
+}
+
+inline void append_to_key(ResourceKey &key, vkb::rendering::DepthStencilStateCpp const &depth_stencil_state)
+{
+	key.append(depth_stencil_state.depth_test_enable);
+	key.append(depth_stencil_state.depth_write_enable);
+	key.append(depth_stencil_state.depth_compare_op);
+	key.append(depth_stencil_state.depth_bounds_test_enable);
+	key.append(depth_stencil_state.stencil_test_enable);
+	append_to_key(key, depth_stencil_state.front);
+	append_to_key(key, depth_stencil_state.back);
+}
+
+inline void append_to_key(ResourceKey &key, vkb::rendering::InputAssemblyStateCpp const &input_assembly_state)
+{
+	key.append(input_assembly_state.topology);
+	key.append(input_assembly_state.primitive_restart_enable);
+}
+
+inline void append_to_key(ResourceKey &key, vkb::rendering::MultisampleStateCpp const &multisample_state)
+{
+	key.append(multisample_state.rasterization_samples);
+	key.append(multisample_state.sample_shading_enable);
+	key.append(multisample_state.min_sample_shading);
+	key.append(multisample_state.sample_mask);
+	key.append(multisample_state.alpha_to_coverage_enable);
+	key.append(multisample_state.alpha_to_one_enable);
+}
+
+inline void append_to_key(ResourceKey &key, vkb::core::HPPPipelineLayout const *pipeline_layout)
+{
+	key.append(pipeline_layout ? static_cast<VkPipelineLayout>(pipeline_layout->get_handle()) : VK_NULL_HANDLE);
+	if (pipeline_layout)
+	{
+		key.append(pipeline_layout->get_shader_modules().size());
+		for (auto const &shader_module : pipeline_layout->get_shader_modules())
+		{
+			key.append(shader_module->get_id());
+		}
+	}
+}
+
+inline void append_to_key(ResourceKey &key, vkb::rendering::RasterizationStateCpp const &rasterization_state)
+{
+	key.append(rasterization_state.depth_clamp_enable);
+	key.append(rasterization_state.rasterizer_discard_enable);
+	key.append(rasterization_state.polygon_mode);
+	key.append(static_cast<VkCullModeFlags>(rasterization_state.cull_mode));
+	key.append(rasterization_state.front_face);
+	key.append(rasterization_state.depth_bias_enable);
+}
+
+inline void append_to_key(ResourceKey &key, vkb::core::HPPRenderPass const *render_pass)
+{
+	key.append(render_pass ? static_cast<VkRenderPass>(render_pass->get_handle()) : VK_NULL_HANDLE);
+}
+
+inline void append_to_key(ResourceKey &key, vkb::rendering::SpecializationConstantState const &specialization_constant_state)
+{
+	auto const &specialization_constants = specialization_constant_state.get_specialization_constant_state();
+	key.append(specialization_constants.size());
+	for (auto const &constant : specialization_constants)
+	{
+		key.append(constant.first);
+		key.append(constant.second.size());
+		key.append(constant.second.data(), constant.second.size());
+	}
+}
+
+inline void append_to_key(ResourceKey &key, vkb::rendering::VertexInputStateCpp const &vertex_input_state)
+{
+	key.append(vertex_input_state.attributes.size());
+	for (auto const &attribute : vertex_input_state.attributes)
+	{
+		key.append(attribute.location);
+		key.append(attribute.binding);
+		key.append(attribute.format);
+		key.append(attribute.offset);
+	}
+	key.append(vertex_input_state.bindings.size());
+	for (auto const &binding : vertex_input_state.bindings)
+	{
+		key.append(binding.binding);
+		key.append(binding.stride);
+		key.append(binding.inputRate);
+	}
+}
+
+inline void append_to_key(ResourceKey &key, vkb::rendering::ViewportState const &viewport_state)
+{
+	key.append(viewport_state.viewport_count);
+	key.append(viewport_state.scissor_count);
+}
+
+//==============================================================================
+
 template <BindingType bindingType>
 class PipelineState
 {
@@ -504,9 +639,20 @@ class PipelineState
 	using RenderPassType     = typename std::conditional<bindingType == BindingType::Cpp, vkb::core::HPPRenderPass, vkb::RenderPass>::type;
 
   public:
+	PipelineState();
+
 	void                                                   clear_dirty();
 	vkb::rendering::ColorBlendState<bindingType> const    &get_color_blend_state() const;
 	vkb::rendering::DepthStencilState<bindingType> const  &get_depth_stencil_state() const;
+
+	/**
+	 * @brief Hash of the whole state, identifying the pipeline it creates
+	 *        The hash of each part of the state is updated when that part changes, so this only combines them
+	 * @remarks The hash is 128 bits wide, so lookups keyed by it alone, like the pipelines memoized by a command buffer,
+	 *          treat two states with the same hash as equal. A collision between the few states of a command buffer is
+	 *          too unlikely to be worth comparing the states themselves.
+	 */
+	PipelineStateHash const                               &get_hash() const;
 	vkb::rendering::InputAssemblyState<bindingType> const &get_input_assembly_state() const;
 	vkb::rendering::MultisampleState<bindingType> const   &get_multisample_state() const;
 	PipelineLayoutType const                              &get_pipeline_layout() const;
@@ -531,6 +677,35 @@ class PipelineState
 	void                                                   set_viewport_state(vkb::rendering::ViewportState const &viewport_state);
 
   private:
+	/// The parts of the state, each with its own hash
+	enum StatePart : uint32_t
+	{
+		ColorBlend,
+		DepthStencil,
+		InputAssembly,
+		Multisample,
+		PipelineLayout,
+		Rasterization,
+		RenderPass,
+		SpecializationConstants,
+		SubpassIndex,
+		VertexInput,
+		Viewport,
+		StatePartCount
+	};
+
+  private:
+	/// Selects the constructor which leaves the part hashes empty
+	struct NoHashes
+	{};
+
+	explicit PipelineState(NoHashes);
+
+	/// @return The hash of each part of a default constructed state, computed once
+	static std::array<PipelineStateHash, StatePartCount> const &get_default_part_hashes();
+
+	PipelineStateHash compute_part_hash(StatePart part) const;
+
 	void set_color_blend_state_impl(vkb::rendering::ColorBlendStateCpp const &color_blend_state);
 	void set_depth_stencil_state_impl(vkb::rendering::DepthStencilStateCpp const &depth_stencil_state);
 	void set_input_assembly_state_impl(vkb::rendering::InputAssemblyStateCpp const &input_assembly_state);
@@ -539,6 +714,7 @@ class PipelineState
 	void set_render_pass_impl(vkb::core::HPPRenderPass const &new_render_pass);
 	void set_rasterization_state_impl(vkb::rendering::RasterizationStateCpp const &rasterization_state);
 	void set_vertex_input_state_impl(vkb::rendering::VertexInputStateCpp const &new_vertex_input_state);
+	void update_hash(StatePart part);
 
   private:
 	vkb::rendering::ColorBlendStateCpp          color_blend_state             = {};
@@ -553,11 +729,40 @@ class PipelineState
 	uint32_t                                    subpass_index                 = 0U;
 	vkb::rendering::VertexInputStateCpp         vertex_input_state            = {};
 	vkb::rendering::ViewportState               viewport_state                = {};
+
+	std::array<PipelineStateHash, StatePartCount> part_hashes  = {};
+	mutable PipelineStateHash                     hash         = {};
+	mutable bool                                  hash_updated = false;
 };
 
 using PipelineStateC   = PipelineState<vkb::BindingType::C>;
 using PipelineStateCpp = PipelineState<vkb::BindingType::Cpp>;
 
+template <BindingType bindingType>
+inline PipelineState<bindingType>::PipelineState() :
+    part_hashes{get_default_part_hashes()}
+{}
+
+template <BindingType bindingType>
+inline PipelineState<bindingType>::PipelineState(NoHashes)
+{}
+
+template <BindingType bindingType>
+inline std::array<PipelineStateHash, PipelineState<bindingType>::StatePartCount> const &PipelineState<bindingType>::get_default_part_hashes()
+{
+	static std::array<PipelineStateHash, StatePartCount> const default_part_hashes = []() {
+		PipelineState                                 default_state{NoHashes{}};
+		std::array<PipelineStateHash, StatePartCount> hashes;
+		for (uint32_t part = 0; part < StatePartCount; part++)
+		{
+			hashes[part] = default_state.compute_part_hash(static_cast<StatePart>(part));
+		}
+		return hashes;
+	}();
+
+	return default_part_hashes;
+}
+
 template <BindingType bindingType>
 void PipelineState<bindingType>::clear_dirty()
 {
@@ -591,6 +796,18 @@ inline vkb::rendering::DepthStencilState<bindingType> const &PipelineState<bindi
 	}
 }
 
+template <BindingType bindingType>
+inline PipelineStateHash const &PipelineState<bindingType>::get_hash() const
+{
+	if (!hash_updated)
+	{
+		hash         = hash128(part_hashes.data(), sizeof(part_hashes));
+		hash_updated = true;
+	}
+
+	return hash;
+}
+
 template <BindingType bindingType>
 inline vkb::rendering::InputAssemblyState<bindingType> const &PipelineState<bindingType>::get_input_assembly_state() const
 {
@@ -708,6 +925,12 @@ inline void PipelineState<bindingType>::reset()
 	depth_stencil_state  = {};
 	color_blend_state    = {};
 	subpass_index        = {0U};
+
+	// The viewport state is kept, and so is its hash
+	PipelineStateHash viewport_hash = part_hashes[Viewport];
+	part_hashes                     = get_default_part_hashes();
+	part_hashes[Viewport]           = viewport_hash;
+	hash_updated                    = false;
 }
 
 template <BindingType bindingType>
@@ -730,6 +953,7 @@ void PipelineState<bindingType>::set_color_blend_state_impl(vkb::rendering::Colo
 	{
 		color_blend_state = new_color_blend_state;
 		dirty             = true;
+		update_hash(ColorBlend);
 	}
 }
 
@@ -753,6 +977,7 @@ void PipelineState<bindingType>::set_depth_stencil_state_impl(vkb::rendering::De
 	{
 		depth_stencil_state = new_depth_stencil_state;
 		dirty               = true;
+		update_hash(DepthStencil);
 	}
 }
 
@@ -776,6 +1001,7 @@ inline void PipelineState<bindingType>::set_input_assembly_state_impl(vkb::rende
 	{
 		input_assembly_state = new_input_assembly_state;
 		dirty                = true;
+		update_hash(InputAssembly);
 	}
 }
 
@@ -799,6 +1025,7 @@ inline void PipelineState<bindingType>::set_multisample_state_impl(vkb::renderin
 	{
 		multisample_state = new_multisample_state;
 		dirty             = true;
+		update_hash(Multisample);
 	}
 }
 
@@ -822,6 +1049,7 @@ inline void PipelineState<bindingType>::set_pipeline_layout_impl(vkb::core::HPPP
 	{
 		pipeline_layout = &new_pipeline_layout;
 		dirty           = true;
+		update_hash(PipelineLayout);
 	}
 }
 
@@ -845,6 +1073,7 @@ inline void PipelineState<bindingType>::set_rasterization_state_impl(vkb::render
 	{
 		rasterization_state = new_rasterization_state;
 		dirty               = true;
+		update_hash(Rasterization);
 	}
 }
 
@@ -868,18 +1097,24 @@ inline void PipelineState<bindingType>::set_render_pass_impl(vkb::core::HPPRende
 	{
 		render_pass = &new_render_pass;
 		dirty       = true;
+		update_hash(RenderPass);
 	}
 }
 
 template <BindingType bindingType>
 inline void PipelineState<bindingType>::set_specialization_constant(uint32_t constant_id, std::vector<uint8_t> const &data)
 {
-	specialization_constant_state.set_constant(constant_id, data);
+	auto const &constants = specialization_constant_state.get_specialization_constant_state();
+	auto        constant  = constants.find(constant_id);
 
-	if (specialization_constant_state.is_dirty())
+	if (constant != constants.end() && constant->second == data)
 	{
-		dirty = true;
+		return;
 	}
+
+	specialization_constant_state.set_constant(constant_id, data);
+	dirty = true;
+	update_hash(SpecializationConstants);
 }
 
 template <BindingType bindingType>
@@ -889,6 +1124,7 @@ inline void PipelineState<bindingType>::set_subpass_index(uint32_t new_subpass_i
 	{
 		subpass_index = new_subpass_index;
 		dirty         = true;
+		update_hash(SubpassIndex);
 	}
 }
 
@@ -912,6 +1148,7 @@ inline void PipelineState<bindingType>::set_vertex_input_state_impl(vkb::renderi
 	{
 		vertex_input_state = new_vertex_input_state;
 		dirty              = true;
+		update_hash(VertexInput);
 	}
 }
 
@@ -922,8 +1159,65 @@ inline void PipelineState<bindingType>::set_viewport_state(vkb::rendering::Viewp
 	{
 		viewport_state = new_viewport_state;
 		dirty          = true;
+		update_hash(Viewport);
 	}
 }
+
+template <BindingType bindingType>
+inline PipelineStateHash PipelineState<bindingType>::compute_part_hash(StatePart part) const
+{
+	ResourceKey key;
+
+	switch (part)
+	{
+		case ColorBlend:
+			append_to_key(key, color_blend_state);
+			break;
+		case DepthStencil:
+			append_to_key(key, depth_stencil_state);
+			break;
+		case InputAssembly:
+			append_to_key(key, input_assembly_state);
+			break;
+		case Multisample:
+			append_to_key(key, multisample_state);
+			break;
+		case PipelineLayout:
+			append_to_key(key, pipeline_layout);
+			break;
+		case Rasterization:
+			append_to_key(key, rasterization_state);
+			break;
+		case RenderPass:
+			append_to_key(key, render_pass);
+			break;
+		case SpecializationConstants:
+			append_to_key(key, specialization_constant_state);
+			break;
+		case SubpassIndex:
+			key.append(subpass_index);
+			break;
+		case VertexInput:
+			append_to_key(key, vertex_input_state);
+			break;
+		case Viewport:
+			append_to_key(key, viewport_state);
+			break;
+		default:
+			break;
+	}
+
+	key.finalize();
+
+	return key.get_hash128();
+}
+
+template <BindingType bindingType>
+inline void PipelineState<bindingType>::update_hash(StatePart part)
+{
+	part_hashes[part] = compute_part_hash(part);
+	hash_updated      = false;
+}
 }        // namespace rendering
 
 }        // namespace vkb
@@ -106,6 +106,8 @@ void PostProcessingComputePass::transition_images(vkb::core::CommandBufferC &com
 	auto &shader_module   = resource_cache.request_shader_module(VK_SHADER_STAGE_COMPUTE_BIT, cs_source, cs_variant);
 	auto &pipeline_layout = resource_cache.request_pipeline_layout({&shader_module});
 
+	std::vector<const core::ImageView *> read_images;
+
 	for (const auto &sampled : sampled_images)
 	{
 		if (const uint32_t *attachment = sampled.second.get_target_attachment())
@@ -116,6 +118,9 @@ void PostProcessingComputePass::transition_images(vkb::core::CommandBufferC &com
 				sampled_rt = &default_render_target;
 			}
 
+			assert(*attachment < sampled_rt->get_views().size());
+			read_images.push_back(&sampled_rt->get_views()[*attachment]);
+
 			if (sampled_rt->get_layout(*attachment) == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
 			{
 				// No-op
@@ -131,13 +136,16 @@ void PostProcessingComputePass::transition_images(vkb::core::CommandBufferC &com
 			barrier.dst_stage_mask  = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
 
 			assert(*attachment < sampled_rt->get_views().size());
-			command_buffer.image_memory_barrier(sampled_rt->get_views()[*attachment], barrier);
+			wait_on_last_access(sampled_rt->get_views()[*attachment], barrier);
+			get_image_barrier_batch().add(sampled_rt->get_views()[*attachment], barrier);
 			sampled_rt->set_layout(*attachment, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 		}
 	}
 
 	const auto &bindings = pipeline_layout.get_descriptor_set_layout(0);
 
+	std::vector<const core::ImageView *> written_images;
+
 	for (const auto &storage : storage_images)
 	{
 		if (const uint32_t *attachment = storage.second.get_target_attachment())
@@ -164,20 +172,34 @@ void PostProcessingComputePass::transition_images(vkb::core::CommandBufferC &com
 			const bool readable = !(resource->qualifiers & ShaderResourceQualifiers::NonReadable);
 			const bool writable = !(resource->qualifiers & ShaderResourceQualifiers::NonReadable);
 
+			assert(*attachment < storage_rt->get_views().size());
+			const auto &view = storage_rt->get_views()[*attachment];
+			if (writable)
+			{
+				written_images.push_back(&view);
+			}
+			else if (readable)
+			{
+				read_images.push_back(&view);
+			}
+
 			vkb::ImageMemoryBarrier barrier;
 			barrier.old_layout = storage_rt->get_layout(*attachment);
 			barrier.new_layout = (readable && !writable) ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_GENERAL;
 
-			if (storage_rt->get_layout(*attachment) == barrier.new_layout)
+			const bool accessed = wait_on_last_access(view, barrier);
+			if (storage_rt->get_layout(*attachment) == barrier.new_layout && !accessed)
 			{
 				// No-op
 				continue;
 			}
 
-			barrier.src_stage_mask = prev_pass_barrier_info.pipeline_stage;
-			barrier.dst_stage_mask = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-
-			barrier.src_access_mask = prev_pass_barrier_info.image_write_access;
+			if (!accessed)
+			{
+				barrier.src_stage_mask  = prev_pass_barrier_info.pipeline_stage;
+				barrier.src_access_mask = prev_pass_barrier_info.image_write_access;
+			}
+			barrier.dst_stage_mask  = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
 			barrier.dst_access_mask = 0;
 			if (readable)
 			{
@@ -188,11 +210,22 @@ void PostProcessingComputePass::transition_images(vkb::core::CommandBufferC &com
 				barrier.dst_access_mask |= VK_ACCESS_SHADER_WRITE_BIT;
 			}
 
-			assert(*attachment < storage_rt->get_views().size());
-			command_buffer.image_memory_barrier(storage_rt->get_views()[*attachment], barrier);
+			get_image_barrier_batch().add(view, barrier);
 			storage_rt->set_layout(*attachment, barrier.new_layout);
 		}
 	}
+
+	flush_image_barriers(command_buffer);
+
+	for (const auto *view : read_images)
+	{
+		record_image_read(*view, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+	}
+
+	for (const auto *view : written_images)
+	{
+		record_image_write(*view, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT);
+	}
 }
 
 void PostProcessingComputePass::draw(vkb::core::CommandBufferC &command_buffer, vkb::rendering::RenderTargetC &default_render_target)
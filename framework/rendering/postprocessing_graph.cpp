@@ -0,0 +1,207 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "postprocessing_graph.h"
+
+#include "common/error.h"
+#include "core/allocated.h"
+#include "core/device.h"
+
+#include <algorithm>
+
+namespace vkb
+{
+void ImageBarrierBatch::add(const core::ImageView &image_view, const vkb::ImageMemoryBarrier &memory_barrier)
+{
+	// Adjust barrier's subresource range for depth images
+	auto subresource_range = image_view.get_subresource_range();
+	auto format            = image_view.get_format();
+	if (vkb::is_depth_only_format(format))
+	{
+		subresource_range.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+	}
+	else if (vkb::is_depth_stencil_format(format))
+	{
+		subresource_range.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+	}
+
+	// The legacy stage and access bits have the same values as their synchronization2 counterparts
+	VkImageMemoryBarrier2 barrier{VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2};
+	barrier.srcStageMask        = memory_barrier.src_stage_mask;
+	barrier.srcAccessMask       = memory_barrier.src_access_mask;
+	barrier.dstStageMask        = memory_barrier.dst_stage_mask;
+	barrier.dstAccessMask       = memory_barrier.dst_access_mask;
+	barrier.oldLayout           = memory_barrier.old_layout;
+	barrier.newLayout           = memory_barrier.new_layout;
+	barrier.srcQueueFamilyIndex = memory_barrier.src_queue_family;
+	barrier.dstQueueFamilyIndex = memory_barrier.dst_queue_family;
+	barrier.image               = image_view.get_image().get_handle();
+	barrier.subresourceRange    = subresource_range;
+
+	barriers.push_back(barrier);
+}
+
+bool ImageBarrierBatch::empty() const
+{
+	return barriers.empty();
+}
+
+void ImageBarrierBatch::flush(vkb::core::CommandBufferC &command_buffer, bool synchronization2)
+{
+	if (barriers.empty())
+	{
+		return;
+	}
+
+	if (synchronization2)
+	{
+		VkDependencyInfo dependency_info{VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
+		dependency_info.imageMemoryBarrierCount = static_cast<uint32_t>(barriers.size());
+		dependency_info.pImageMemoryBarriers    = barriers.data();
+
+		vkCmdPipelineBarrier2(command_buffer.get_handle(), &dependency_info);
+	}
+	else
+	{
+		VkPipelineStageFlags              src_stage_mask = 0;
+		VkPipelineStageFlags              dst_stage_mask = 0;
+		std::vector<VkImageMemoryBarrier> image_memory_barriers;
+		image_memory_barriers.reserve(barriers.size());
+
+		for (const auto &barrier : barriers)
+		{
+			src_stage_mask |= static_cast<VkPipelineStageFlags>(barrier.srcStageMask);
+			dst_stage_mask |= static_cast<VkPipelineStageFlags>(barrier.dstStageMask);
+
+			VkImageMemoryBarrier image_memory_barrier{VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
+			image_memory_barrier.srcAccessMask       = static_cast<VkAccessFlags>(barrier.srcAccessMask);
+			image_memory_barrier.dstAccessMask       = static_cast<VkAccessFlags>(barrier.dstAccessMask);
+			image_memory_barrier.oldLayout           = barrier.oldLayout;
+			image_memory_barrier.newLayout           = barrier.newLayout;
+			image_memory_barrier.srcQueueFamilyIndex = barrier.srcQueueFamilyIndex;
+			image_memory_barrier.dstQueueFamilyIndex = barrier.dstQueueFamilyIndex;
+			image_memory_barrier.image               = barrier.image;
+			image_memory_barrier.subresourceRange    = barrier.subresourceRange;
+			image_memory_barriers.push_back(image_memory_barrier);
+		}
+
+		vkCmdPipelineBarrier(command_buffer.get_handle(),
+		                     src_stage_mask ? src_stage_mask : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+		                     dst_stage_mask ? dst_stage_mask : VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+		                     0, 0, nullptr, 0, nullptr,
+		                     static_cast<uint32_t>(image_memory_barriers.size()), image_memory_barriers.data());
+	}
+
+	barriers.clear();
+}
+
+TransientImagePool::TransientImagePool(vkb::core::DeviceC &device) :
+    device{device}
+{}
+
+TransientImagePool::~TransientImagePool()
+{
+	for (VkImage image : images)
+	{
+		vkDestroyImage(device.get_handle(), image, nullptr);
+	}
+
+	for (auto &block : blocks)
+	{
+		vmaFreeMemory(vkb::allocated::get_memory_allocator(), block.allocation);
+	}
+}
+
+core::Image TransientImagePool::create_image(VkExtent2D extent, VkFormat format, VkImageUsageFlags usage, size_t first_pass, size_t last_pass)
+{
+	assert(first_pass <= last_pass);
+
+	VkImageCreateInfo image_info{VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO};
+	image_info.imageType     = VK_IMAGE_TYPE_2D;
+	image_info.format        = format;
+	image_info.extent        = {extent.width, extent.height, 1};
+	image_info.mipLevels     = 1;
+	image_info.arrayLayers   = 1;
+	image_info.samples       = VK_SAMPLE_COUNT_1_BIT;
+	image_info.tiling        = VK_IMAGE_TILING_OPTIMAL;
+	image_info.usage         = usage;
+	image_info.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
+	image_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+	VkImage image{VK_NULL_HANDLE};
+	VK_CHECK(vkCreateImage(device.get_handle(), &image_info, nullptr, &image));
+	images.push_back(image);
+
+	VkMemoryRequirements requirements;
+	vkGetImageMemoryRequirements(device.get_handle(), image, &requirements);
+
+	auto &block = request_block(requirements, usage & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT, first_pass, last_pass);
+	VK_CHECK(vmaBindImageMemory(vkb::allocated::get_memory_allocator(), block.allocation, image));
+
+	return core::Image{device, image, image_info.extent, format, usage};
+}
+
+size_t TransientImagePool::get_block_count() const
+{
+	return blocks.size();
+}
+
+TransientImagePool::Block &TransientImagePool::request_block(const VkMemoryRequirements &requirements, bool lazily_allocated, size_t first_pass, size_t last_pass)
+{
+	for (auto &block : blocks)
+	{
+		if (block.lazily_allocated != lazily_allocated ||
+		    block.size < requirements.size ||
+		    block.offset % requirements.alignment != 0 ||
+		    !(requirements.memoryTypeBits & (1u << block.memory_type)))
+		{
+			continue;
+		}
+
+		const bool overlaps = std::ranges::any_of(block.lifetimes, [first_pass, last_pass](const auto &lifetime) {
+			return lifetime.first <= last_pass && first_pass <= lifetime.second;
+		});
+
+		if (!overlaps)
+		{
+			block.lifetimes.emplace_back(first_pass, last_pass);
+			return block;
+		}
+	}
+
+	VmaAllocationCreateInfo allocation_create_info{};
+	allocation_create_info.requiredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+	if (lazily_allocated)
+	{
+		// Falls back to regular device memory on GPUs without a lazily allocated memory type
+		allocation_create_info.preferredFlags = VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
+	}
+
+	Block block{};
+	block.lazily_allocated = lazily_allocated;
+	block.lifetimes.emplace_back(first_pass, last_pass);
+
+	VmaAllocationInfo allocation_info{};
+	VK_CHECK(vmaAllocateMemory(vkb::allocated::get_memory_allocator(), &requirements, &allocation_create_info, &block.allocation, &allocation_info));
+	block.size        = allocation_info.size;
+	block.offset      = allocation_info.offset;
+	block.memory_type = allocation_info.memoryType;
+
+	blocks.push_back(std::move(block));
+	return blocks.back();
+}
+}        // namespace vkb
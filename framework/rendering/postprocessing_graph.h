@@ -0,0 +1,113 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "core/command_buffer.h"
+#include "core/image.h"
+#include "core/image_view.h"
+
+#include <utility>
+#include <vector>
+
+namespace vkb
+{
+/**
+ * @brief Image barriers gathered while preparing a pass of a vkb::PostProcessingPipeline,
+ *        recorded together with a single pipeline barrier command.
+ */
+class ImageBarrierBatch
+{
+  public:
+	/**
+	 * @brief Adds a barrier on the whole subresource range of the given view
+	 *        The aspect is adjusted for depth images, as done by CommandBuffer::image_memory_barrier()
+	 */
+	void add(const core::ImageView &image_view, const vkb::ImageMemoryBarrier &memory_barrier);
+
+	bool empty() const;
+
+	/**
+	 * @brief Records the barriers added since the last flush, then clears the batch
+	 * @param command_buffer The command buffer to record into
+	 * @param synchronization2 If true, the barriers are recorded with vkCmdPipelineBarrier2 and each keeps its own stages,
+	 *                         otherwise with vkCmdPipelineBarrier waiting on the union of their stages
+	 */
+	void flush(vkb::core::CommandBufferC &command_buffer, bool synchronization2);
+
+  private:
+	std::vector<VkImageMemoryBarrier2> barriers;
+};
+
+/**
+ * @brief Creates the images of the transient render targets of a vkb::PostProcessingPipeline.
+ *
+ * Each image is used by an inclusive range of passes of the pipeline. Images whose ranges do not overlap
+ * share the same device memory, so intermediate targets only cost as much memory as the ones alive at the same time.
+ * Images with VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT prefer lazily allocated memory, which tile-based GPUs
+ * may never back with physical pages.
+ */
+class TransientImagePool
+{
+  public:
+	TransientImagePool(vkb::core::DeviceC &device);
+
+	TransientImagePool(const TransientImagePool &)            = delete;
+	TransientImagePool &operator=(const TransientImagePool &) = delete;
+
+	TransientImagePool(TransientImagePool &&)            = delete;
+	TransientImagePool &operator=(TransientImagePool &&) = delete;
+
+	/**
+	 * @brief Destroys the images and frees their memory
+	 *        Render targets using the images must be destroyed first
+	 */
+	~TransientImagePool();
+
+	/**
+	 * @brief Creates an image used from first_pass to last_pass
+	 *        The image is bound to a memory block that no image alive during these passes uses, if one is large enough,
+	 *        or to a new block otherwise. Blocks are never grown, so targets are best added from the largest.
+	 * @return An image referring to the handle, which stays owned by the pool
+	 */
+	core::Image create_image(VkExtent2D extent, VkFormat format, VkImageUsageFlags usage, size_t first_pass, size_t last_pass);
+
+	/**
+	 * @return The number of memory blocks the images are bound to
+	 */
+	size_t get_block_count() const;
+
+  private:
+	struct Block
+	{
+		VmaAllocation                          allocation{VK_NULL_HANDLE};
+		VkDeviceSize                           size{0};
+		VkDeviceSize                           offset{0};
+		uint32_t                               memory_type{0};
+		bool                                   lazily_allocated{false};
+		std::vector<std::pair<size_t, size_t>> lifetimes;        // Pass ranges of the images bound to this block
+	};
+
+	Block &request_block(const VkMemoryRequirements &requirements, bool lazily_allocated, size_t first_pass, size_t last_pass);
+
+	vkb::core::DeviceC &device;
+
+	std::vector<Block> blocks;
+
+	std::vector<VkImage> images;
+};
+}        // namespace vkb
@@ -1,4 +1,4 @@
-/* Copyright (c) 2020-2025, Arm Limited and Contributors
+/* Copyright (c) 2020-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -19,6 +19,8 @@
 
 #include "postprocessing_pipeline.h"
 
+#include <algorithm>
+
 namespace vkb
 {
 PostProcessingPassBase::PostProcessingPassBase(PostProcessingPipeline *parent) :
@@ -49,4 +51,46 @@ PostProcessingPassBase::BarrierInfo PostProcessingPassBase::get_predecessor_src_
 	}
 }
 
+ImageBarrierBatch &PostProcessingPassBase::get_image_barrier_batch() const
+{
+	return parent->barrier_batch;
+}
+
+void PostProcessingPassBase::flush_image_barriers(vkb::core::CommandBufferC &command_buffer) const
+{
+	parent->barrier_batch.flush(command_buffer, parent->synchronization2);
+}
+
+void PostProcessingPassBase::record_image_write(const core::ImageView &view, VkPipelineStageFlags stage, VkAccessFlags access) const
+{
+	// Later barriers wait on this write, which itself waited on the earlier reads
+	parent->image_accesses[view.get_image().get_handle()] = {stage, access, 0};
+}
+
+void PostProcessingPassBase::record_image_read(const core::ImageView &view, VkPipelineStageFlags stage) const
+{
+	parent->image_accesses[view.get_image().get_handle()].read_stages |= stage;
+}
+
+bool PostProcessingPassBase::wait_on_last_access(const core::ImageView &view, vkb::ImageMemoryBarrier &barrier) const
+{
+	auto it = parent->image_accesses.find(view.get_image().get_handle());
+	if (it == parent->image_accesses.end())
+	{
+		return false;
+	}
+
+	// Reads only need an execution dependency, so that they are done before the image is written or transitioned
+	barrier.src_stage_mask  = it->second.write_stage | it->second.read_stages;
+	barrier.src_access_mask = it->second.write_access;
+	return true;
+}
+
+bool PostProcessingPassBase::is_last_use(const vkb::rendering::RenderTargetC &render_target) const
+{
+	return std::ranges::any_of(parent->transient_render_targets, [this, &render_target](const auto &transient) {
+		return transient.render_target.get() == &render_target && transient.last_pass == parent->get_current_pass_index();
+	});
+}
+
 }        // namespace vkb
\ No newline at end of file
@@ -18,6 +18,7 @@
 #pragma once
 
 #include "core/command_buffer.h"
+#include "postprocessing_graph.h"
 #include "render_context.h"
 #include "render_target.h"
 #include <functional>
@@ -115,6 +116,40 @@ class PostProcessingPassBase
 	 *        if any, or returns the specified default if this is the first pass in the pipeline.
 	 */
 	BarrierInfo get_predecessor_src_barrier_info(BarrierInfo fallback = {}) const;
+
+	/**
+	 * @brief Returns the parent's batch of image barriers, to be recorded with flush_image_barriers()
+	 */
+	ImageBarrierBatch &get_image_barrier_batch() const;
+
+	/**
+	 * @brief Records the image barriers gathered in the parent's batch with a single pipeline barrier.
+	 */
+	void flush_image_barriers(vkb::core::CommandBufferC &command_buffer) const;
+
+	/**
+	 * @brief Declares that this pass writes to the image of the given view, so that the barriers of later passes
+	 *        wait on this write rather than on a guess from the pass right before them.
+	 */
+	void record_image_write(const core::ImageView &view, VkPipelineStageFlags stage, VkAccessFlags access) const;
+
+	/**
+	 * @brief Declares that this pass reads the image of the given view, so that a later pass writing to it
+	 *        or changing its layout waits for the read to be done.
+	 */
+	void record_image_read(const core::ImageView &view, VkPipelineStageFlags stage) const;
+
+	/**
+	 * @brief Makes the barrier wait on the last write to the image of the given view by a pass of the parent,
+	 *        and on the reads of the image by the passes since that write, if any.
+	 * @return Whether the image was written to or read during the current draw
+	 */
+	bool wait_on_last_access(const core::ImageView &view, vkb::ImageMemoryBarrier &barrier) const;
+
+	/**
+	 * @brief Returns whether the given render target is a transient target of the parent no longer used after this pass.
+	 */
+	bool is_last_use(const vkb::rendering::RenderTargetC &render_target) const;
 };
 
 /**
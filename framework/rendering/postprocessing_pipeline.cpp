@@ -28,6 +28,8 @@ PostProcessingPipeline::PostProcessingPipeline(vkb::rendering::RenderContextC &r
 
 void PostProcessingPipeline::draw(vkb::core::CommandBufferC &command_buffer, vkb::rendering::RenderTargetC &default_render_target)
 {
+	image_accesses.clear();
+
 	for (current_pass_index = 0; current_pass_index < passes.size(); current_pass_index++)
 	{
 		auto &pass = *passes[current_pass_index];
@@ -38,6 +40,8 @@ void PostProcessingPipeline::draw(vkb::core::CommandBufferC &command_buffer, vkb
 		}
 		ScopedDebugLabel marker{command_buffer, pass.debug_name.c_str()};
 
+		begin_transient_render_targets(command_buffer);
+
 		if (!pass.prepared)
 		{
 			ScopedDebugLabel marker{command_buffer, "Prepare"};
@@ -66,4 +70,87 @@ void PostProcessingPipeline::draw(vkb::core::CommandBufferC &command_buffer, vkb
 	current_pass_index = 0;
 }
 
+void PostProcessingPipeline::set_synchronization2(bool enabled)
+{
+	synchronization2 = enabled;
+}
+
+vkb::rendering::RenderTargetC &PostProcessingPipeline::add_transient_render_target(VkExtent2D                   extent,
+                                                                                   const std::vector<VkFormat> &formats,
+                                                                                   size_t                       first_pass,
+                                                                                   size_t                       last_pass,
+                                                                                   VkImageUsageFlags            usage)
+{
+	assert(first_pass <= last_pass);
+	assert((first_pass < last_pass || usage == 0) && "A target used by a single pass may only be used as attachments");
+
+	if (!transient_image_pool)
+	{
+		transient_image_pool = std::make_unique<TransientImagePool>(render_context->get_device());
+	}
+
+	std::vector<core::Image> images;
+	for (VkFormat format : formats)
+	{
+		VkImageUsageFlags image_usage = usage | VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT;
+		image_usage |= vkb::is_depth_format(format) ? VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT : VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+		if (first_pass == last_pass)
+		{
+			image_usage |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+		}
+		else
+		{
+			image_usage |= VK_IMAGE_USAGE_SAMPLED_BIT;
+		}
+
+		images.push_back(transient_image_pool->create_image(extent, format, image_usage, first_pass, last_pass));
+	}
+
+	transient_render_targets.push_back({std::make_unique<vkb::rendering::RenderTargetC>(std::move(images)), first_pass, last_pass});
+	return *transient_render_targets.back().render_target;
+}
+
+void PostProcessingPipeline::begin_transient_render_targets(vkb::core::CommandBufferC &command_buffer)
+{
+	for (auto &transient : transient_render_targets)
+	{
+		if (transient.first_pass != current_pass_index)
+		{
+			continue;
+		}
+
+		const auto &views = transient.render_target->get_views();
+		for (uint32_t i = 0; i < static_cast<uint32_t>(views.size()); i++)
+		{
+			// The memory may have held images of earlier passes, whose reads and writes must be done
+			vkb::ImageMemoryBarrier barrier;
+			barrier.old_layout      = VK_IMAGE_LAYOUT_UNDEFINED;
+			barrier.src_stage_mask  = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT |
+			                          VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+			barrier.src_access_mask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+			if (vkb::is_depth_format(views[i].get_format()))
+			{
+				barrier.new_layout      = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+				barrier.dst_stage_mask  = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+				barrier.dst_access_mask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+			}
+			else
+			{
+				barrier.new_layout      = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+				barrier.dst_stage_mask  = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+				barrier.dst_access_mask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+			}
+
+			barrier_batch.add(views[i], barrier);
+			transient.render_target->set_layout(i, barrier.new_layout);
+
+			// Later transitions of the image in this frame must happen after this one
+			image_accesses[views[i].get_image().get_handle()] = {barrier.dst_stage_mask, barrier.dst_access_mask, 0};
+		}
+	}
+
+	barrier_batch.flush(command_buffer, synchronization2);
+}
+
 }        // namespace vkb
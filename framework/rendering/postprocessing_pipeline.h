@@ -17,8 +17,11 @@
 
 #pragma once
 
+#include "postprocessing_graph.h"
 #include "postprocessing_pass.h"
 
+#include <unordered_map>
+
 namespace vkb
 {
 class PostProcessingRenderPass;
@@ -95,11 +98,66 @@ class PostProcessingPipeline
 		return current_pass_index;
 	}
 
+	/**
+	 * @brief Records the image barriers of each pass with vkCmdPipelineBarrier2, each barrier keeping its own stages
+	 *        The synchronization2 feature of Vulkan 1.3 must be enabled, disabled by default
+	 */
+	void set_synchronization2(bool enabled);
+
+	/**
+	 * @brief Creates a render target only used by the passes from first_pass to last_pass of this pipeline.
+	 *        Its images share memory with the images of transient targets used by other passes, and are
+	 *        transitioned from VK_IMAGE_LAYOUT_UNDEFINED before first_pass, so their contents do not outlive last_pass.
+	 *        Attachments written to by last_pass are not stored.
+	 * @remarks A target used by a single pass may only be read as input attachments of that pass, so that its memory
+	 *          can be lazily allocated and never leave tile memory; other targets can also be sampled.
+	 * @param extent The extent of the images
+	 * @param formats The format of each attachment
+	 * @param first_pass The index of the first pass using the target
+	 * @param last_pass The index of the last pass using the target
+	 * @param usage Additional usage of the images, e.g. VK_IMAGE_USAGE_STORAGE_BIT for compute passes
+	 */
+	vkb::rendering::RenderTargetC &add_transient_render_target(VkExtent2D                   extent,
+	                                                           const std::vector<VkFormat> &formats,
+	                                                           size_t                       first_pass,
+	                                                           size_t                       last_pass,
+	                                                           VkImageUsageFlags            usage = 0);
+
   private:
+	struct TransientRenderTarget
+	{
+		std::unique_ptr<vkb::rendering::RenderTargetC> render_target;
+		size_t                                         first_pass;
+		size_t                                         last_pass;
+	};
+
+	/**
+	 * @brief Stage and access of the last write to an image during draw(), and the stages which read it since then
+	 */
+	struct ImageAccess
+	{
+		VkPipelineStageFlags write_stage;
+		VkAccessFlags        write_access;
+		VkPipelineStageFlags read_stages;
+	};
+
+	/**
+	 * @brief Transitions the images of the transient targets first used by the current pass from
+	 *        VK_IMAGE_LAYOUT_UNDEFINED, after the passes using the images they alias
+	 */
+	void begin_transient_render_targets(vkb::core::CommandBufferC &command_buffer);
+
 	vkb::rendering::RenderContextC                      *render_context{nullptr};
 	ShaderSource                                         triangle_vs;
 	std::vector<std::unique_ptr<PostProcessingPassBase>> passes{};
 	size_t                                               current_pass_index{0};
+	bool                                                 synchronization2{false};
+	ImageBarrierBatch                                    barrier_batch{};
+	std::unordered_map<VkImage, ImageAccess>             image_accesses{};
+
+	// The pool must outlive the render targets viewing its images
+	std::unique_ptr<TransientImagePool> transient_image_pool{};
+	std::vector<TransientRenderTarget>  transient_render_targets{};
 };
 
 }        // namespace vkb
\ No newline at end of file
@@ -278,7 +278,7 @@ void PostProcessingRenderPass::update_load_stores(
 		}
 
 		VkAttachmentStoreOp store;
-		if (is_output)
+		if (is_output && !is_last_use(render_target))
 		{
 			store = VK_ATTACHMENT_STORE_OP_STORE;
 		}
@@ -369,7 +369,8 @@ void PostProcessingRenderPass::transition_attachments(const AttachmentSet
 		barrier.dst_stage_mask  = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
 
 		assert(input < views.size());
-		command_buffer.image_memory_barrier(views[input], barrier);
+		wait_on_last_access(views[input], barrier);
+		get_image_barrier_batch().add(views[input], barrier);
 		render_target.set_layout(input, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 	}
 
@@ -418,7 +419,12 @@ void PostProcessingRenderPass::transition_attachments(const AttachmentSet
 		barrier.dst_stage_mask  = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
 
 		assert(attachment < sampled_rt->get_views().size());
-		command_buffer.image_memory_barrier(sampled_rt->get_views()[attachment], barrier);
+		if (!is_depth_resolve)
+		{
+			// Depth resolves are not tracked as writes, so keep the stages set up above
+			wait_on_last_access(sampled_rt->get_views()[attachment], barrier);
+		}
+		get_image_barrier_batch().add(sampled_rt->get_views()[attachment], barrier);
 		sampled_rt->set_layout(attachment, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 	}
 
@@ -451,12 +457,39 @@ void PostProcessingRenderPass::transition_attachments(const AttachmentSet
 			barrier.dst_stage_mask  = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
 		}
 
-		command_buffer.image_memory_barrier(views[output], barrier);
+		wait_on_last_access(views[output], barrier);
+		get_image_barrier_batch().add(views[output], barrier);
 		render_target.set_layout(output, output_layout);
 	}
 
 	// NOTE: Unused attachments might be carried over to other render passes,
 	//       so we don't want to transition them to UNDEFINED layout here
+
+	flush_image_barriers(command_buffer);
+
+	for (uint32_t input : input_attachments)
+	{
+		record_image_read(views[input], VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+	}
+
+	for (const auto &sampled : sampled_attachments)
+	{
+		auto *sampled_rt = sampled.first ? sampled.first : &render_target;
+		record_image_read(sampled_rt->get_views()[sampled.second & ATTACHMENT_BITMASK], VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+	}
+
+	for (uint32_t output : output_attachments)
+	{
+		if (vkb::is_depth_format(views[output].get_format()))
+		{
+			record_image_write(views[output], VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+			                   VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
+		}
+		else
+		{
+			record_image_write(views[output], VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
+		}
+	}
 }
 
 void PostProcessingRenderPass::prepare_draw(vkb::core::CommandBufferC &command_buffer, vkb::rendering::RenderTargetC &fallback_render_target)
@@ -22,6 +22,9 @@
 #include "core/hpp_swapchain.h"
 #include "platform/window.h"
 #include "rendering/render_frame.h"
+#include <array>
+#include <atomic>
+#include <unordered_map>
 #include <vulkan/vulkan.hpp>
 
 namespace vkb
@@ -43,6 +46,15 @@ template <BindingType bindingType>
 class RenderFrame;
 using RenderFrameCpp = RenderFrame<BindingType::Cpp>;
 
+/**
+ * @brief Number of draws which the subpasses tested against the view frustum, accumulated since the RenderContext was created
+ */
+struct CullingStats
+{
+	std::atomic<uint64_t> visible{0};
+	std::atomic<uint64_t> culled{0};
+};
+
 /**
  * @brief RenderContext acts as a frame manager for the sample, with a lifetime that is the
  * same as that of the Application itself. It acts as a container for RenderFrame objects,
@@ -56,7 +68,13 @@ using RenderFrameCpp = RenderFrame<BindingType::Cpp>;
  * swapchain. A RenderFrame will then be created for each Swapchain image.
  *
  * For offscreen rendering (no swapchain), the RenderContext can be given a valid Device, and
- * a width and height. A single RenderFrame will then be created.
+ * a width and height. A ring of RenderFrames, one by default, will then be created, each with its
+ * own render target. begin_frame moves to the next frame of the ring instead of acquiring an image,
+ * so that the CPU records a frame while the GPU still renders the previous ones.
+ *
+ * By default each submission signals a fence of its frame, which is waited for and reset when the frame is used again.
+ * With timeline semaphore sync, submissions signal increasing values on a timeline semaphore of their queue instead,
+ * and a frame is retired once the timelines reached the values of its submissions.
  */
 template <vkb::BindingType bindingType>
 class RenderContext
@@ -80,6 +98,7 @@ class RenderContext
 	using SurfaceFormatType                  = typename std::conditional<bindingType == BindingType::Cpp, vk::SurfaceFormatKHR, VkSurfaceFormatKHR>::type;
 	using SurfaceTransformFlagBitsType       = typename std::conditional<bindingType == BindingType::Cpp, vk::SurfaceTransformFlagBitsKHR, VkSurfaceTransformFlagBitsKHR>::type;
 	using SurfaceType                        = typename std::conditional<bindingType == BindingType::Cpp, vk::SurfaceKHR, VkSurfaceKHR>::type;
+	using TimelineSemaphoreType              = typename std::conditional<bindingType == BindingType::Cpp, vkb::HPPTimelineSemaphore, vkb::TimelineSemaphore>::type;
 
 	/**
 	 * @brief Constructor
@@ -149,6 +168,11 @@ class RenderContext
 	 */
 	uint32_t get_active_frame_index() const;
 
+	/**
+	 * @brief Subpasses which cull their draws add their counts to these stats
+	 */
+	CullingStats &get_culling_stats();
+
 	vkb::core::Device<bindingType> &get_device();
 
 	/**
@@ -169,6 +193,12 @@ class RenderContext
 
 	SwapchainType const &get_swapchain() const;
 
+	/**
+	 * @brief Returns the timeline semaphore signaled by the submissions to a queue, creating it on first use
+	 *        Other queues can wait on its values to depend on work submitted through the RenderContext
+	 */
+	TimelineSemaphoreType &get_timeline_semaphore(QueueType const &queue);
+
 	/**
 	 * @brief Handles surface changes, only applicable if the render_context makes use of a swapchain
 	 */
@@ -200,6 +230,19 @@ class RenderContext
 	SemaphoreType request_semaphore();
 	SemaphoreType request_semaphore_with_ownership();
 
+	/**
+	 * @brief Sets the number of RenderFrames created for offscreen rendering, to be called before prepare
+	 *        Only used without a swapchain, otherwise there is a RenderFrame for each swapchain image
+	 * @param frame_count The number of frames which may be in flight on the GPU at the same time
+	 */
+	void set_offscreen_frame_count(uint32_t frame_count);
+
+	/**
+	 * @brief Retires frames with timeline semaphores instead of fences
+	 *        Requires the timelineSemaphore feature to be enabled on the device
+	 */
+	void set_timeline_semaphore_sync(bool enabled);
+
 	/**
 	 * @brief Submits the command buffer to the right queue
 	 * @param command_buffer A command buffer containing recorded commands
@@ -269,21 +312,32 @@ class RenderContext
 	void          submit_impl(vkb::core::HPPQueue const &queue, std::vector<std::shared_ptr<vkb::core::CommandBufferCpp>> const &command_buffers);
 	void          update_swapchain_impl(vk::Extent2D const &extent, vk::SurfaceTransformFlagBitsKHR transform);
 
+	/**
+	 * @brief Submits work of the active frame, signaling either a fence or the timeline semaphore of the queue
+	 * @param submit_info The submission, signaling at most one binary semaphore
+	 */
+	void                       submit_frame_impl(vkb::core::HPPQueue const &queue, vk::SubmitInfo submit_info);
+	vkb::HPPTimelineSemaphore &get_timeline_semaphore_impl(vkb::core::HPPQueue const &queue);
+
   private:
-	vk::Semaphore                                                acquired_semaphore;
-	uint32_t                                                     active_frame_index        = 0;        // Current active frame index
-	RenderTargetCpp::CreateFunc                                  create_render_target_func = RenderTargetCpp::DEFAULT_CREATE_FUNC;
-	vkb::core::DeviceCpp                                        &device;
-	bool                                                         frame_active = false;        // Whether a frame is active or not
-	std::vector<std::unique_ptr<vkb::rendering::RenderFrameCpp>> frames;
-	vk::SurfaceTransformFlagBitsKHR                              pre_transform = vk::SurfaceTransformFlagBitsKHR::eIdentity;
-	bool                                                         prepared      = false;
-	const vkb::core::HPPQueue                                   &queue;        // If swapchain exists, then this will be a present supported queue, else a graphics queue
-	vk::Extent2D                                                 surface_extent;
-	std::unique_ptr<vkb::core::HPPSwapchain>                     swapchain;
-	vkb::core::HPPSwapchainProperties                            swapchain_properties;
-	size_t                                                       thread_count = 1;
-	const vkb::Window                                           &window;
+	vk::Semaphore                                                           acquired_semaphore;
+	uint32_t                                                                active_frame_index        = 0;        // Current active frame index
+	RenderTargetCpp::CreateFunc                                             create_render_target_func = RenderTargetCpp::DEFAULT_CREATE_FUNC;
+	CullingStats                                                            culling_stats;
+	vkb::core::DeviceCpp                                                   &device;
+	bool                                                                    frame_active = false;        // Whether a frame is active or not
+	std::vector<std::unique_ptr<vkb::rendering::RenderFrameCpp>>            frames;
+	uint32_t                                                                offscreen_frame_count = 1;
+	vk::SurfaceTransformFlagBitsKHR                                         pre_transform         = vk::SurfaceTransformFlagBitsKHR::eIdentity;
+	bool                                                                    prepared              = false;
+	const vkb::core::HPPQueue                                              &queue;        // If swapchain exists, then this will be a present supported queue, else a graphics queue
+	vk::Extent2D                                                            surface_extent;
+	std::unique_ptr<vkb::core::HPPSwapchain>                                swapchain;
+	vkb::core::HPPSwapchainProperties                                       swapchain_properties;
+	size_t                                                                  thread_count            = 1;
+	bool                                                                    timeline_semaphore_sync = false;
+	std::unordered_map<VkQueue, std::unique_ptr<vkb::HPPTimelineSemaphore>> timeline_semaphores;        // Timeline semaphore per queue
+	const vkb::Window                                                      &window;
 };
 
 using RenderContextC   = RenderContext<vkb::BindingType::C>;
@@ -426,12 +480,38 @@ inline void RenderContext<bindingType>::begin_frame()
 			return;
 		}
 	}
+	else
+	{
+		// Without a swapchain to acquire from, the frames are used in turn
+		active_frame_index = (active_frame_index + 1) % to_u32(frames.size());
+	}
 
 	// Now the frame is active again
 	frame_active = true;
 
 	// Wait on all resource to be freed from the previous render to this frame
 	wait_frame();
+
+	// Images are not guaranteed to be acquired in turn, so the objects which the GPU may still use are found
+	// from the frames which have not been waited for, rather than from the number of frames
+	auto    &resource_cache         = device.get_resource_cache();
+	uint32_t cache_frame            = resource_cache.next_frame();
+	uint32_t oldest_frame_in_flight = cache_frame;
+	for (auto &frame : frames)
+	{
+		if (auto frame_in_flight = frame->get_resource_cache_frame())
+		{
+			// Compare ages, as the frame counter may wrap around
+			if (cache_frame - *frame_in_flight > cache_frame - oldest_frame_in_flight)
+			{
+				oldest_frame_in_flight = *frame_in_flight;
+			}
+		}
+	}
+
+	resource_cache.evict(oldest_frame_in_flight);
+
+	frames[active_frame_index]->set_resource_cache_frame(cache_frame);
 }
 
 template <vkb::BindingType bindingType>
@@ -513,6 +593,12 @@ inline uint32_t RenderContext<bindingType>::get_active_frame_index() const
 	return active_frame_index;
 }
 
+template <vkb::BindingType bindingType>
+inline CullingStats &RenderContext<bindingType>::get_culling_stats()
+{
+	return culling_stats;
+}
+
 template <vkb::BindingType bindingType>
 inline vkb::core::Device<bindingType> &RenderContext<bindingType>::get_device()
 {
@@ -594,6 +680,31 @@ inline typename RenderContext<bindingType>::SwapchainType const &RenderContext<b
 	}
 }
 
+template <vkb::BindingType bindingType>
+inline typename RenderContext<bindingType>::TimelineSemaphoreType &RenderContext<bindingType>::get_timeline_semaphore(QueueType const &queue)
+{
+	if constexpr (bindingType == vkb::BindingType::Cpp)
+	{
+		return get_timeline_semaphore_impl(queue);
+	}
+	else
+	{
+		return reinterpret_cast<vkb::TimelineSemaphore &>(get_timeline_semaphore_impl(reinterpret_cast<vkb::core::HPPQueue const &>(queue)));
+	}
+}
+
+template <vkb::BindingType bindingType>
+inline vkb::HPPTimelineSemaphore &RenderContext<bindingType>::get_timeline_semaphore_impl(vkb::core::HPPQueue const &queue)
+{
+	auto &timeline = timeline_semaphores[static_cast<VkQueue>(queue.get_handle())];
+	if (!timeline)
+	{
+		timeline = std::make_unique<vkb::HPPTimelineSemaphore>(device);
+	}
+
+	return *timeline;
+}
+
 template <vkb::BindingType bindingType>
 inline bool RenderContext<bindingType>::handle_surface_changes(bool force_update)
 {
@@ -673,17 +784,20 @@ inline void RenderContext<bindingType>::prepare(size_t thread_count, typename vk
 	}
 	else
 	{
-		// Otherwise, create a single RenderFrame
+		// Otherwise, create the ring of offscreen RenderFrames
 		swapchain = nullptr;
 
-		auto color_image = vkb::core::HPPImage{device,
-		                                       vk::Extent3D{surface_extent.width, surface_extent.height, 1},
-		                                       DEFAULT_VK_FORMAT,        // We can use any format here that we like
-		                                       vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eTransferSrc,
-		                                       VMA_MEMORY_USAGE_GPU_ONLY};
+		for (uint32_t i = 0; i < offscreen_frame_count; ++i)
+		{
+			auto color_image = vkb::core::HPPImage{device,
+			                                       vk::Extent3D{surface_extent.width, surface_extent.height, 1},
+			                                       DEFAULT_VK_FORMAT,        // We can use any format here that we like
+			                                       vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eTransferSrc,
+			                                       VMA_MEMORY_USAGE_GPU_ONLY};
 
-		std::unique_ptr<RenderTargetCpp> render_target = create_render_target_func(std::move(color_image));
-		frames.emplace_back(std::make_unique<vkb::rendering::RenderFrameCpp>(device, std::move(render_target), thread_count));
+			std::unique_ptr<RenderTargetCpp> render_target = create_render_target_func(std::move(color_image));
+			frames.emplace_back(std::make_unique<vkb::rendering::RenderFrameCpp>(device, std::move(render_target), thread_count));
+		}
 	}
 
 	this->thread_count = thread_count;
@@ -761,6 +875,21 @@ inline typename RenderContext<bindingType>::SemaphoreType RenderContext<bindingT
 	return get_active_frame().get_semaphore_pool().request_semaphore_with_ownership();
 }
 
+template <vkb::BindingType bindingType>
+inline void RenderContext<bindingType>::set_offscreen_frame_count(uint32_t frame_count)
+{
+	assert(!prepared && "The offscreen frame count must be set before prepare()");
+	assert(frame_count > 0 && "At least one frame is needed");
+
+	offscreen_frame_count = frame_count;
+}
+
+template <vkb::BindingType bindingType>
+inline void RenderContext<bindingType>::set_timeline_semaphore_sync(bool enabled)
+{
+	timeline_semaphore_sync = enabled;
+}
+
 template <vkb::BindingType bindingType>
 inline void RenderContext<bindingType>::submit(std::shared_ptr<vkb::core::CommandBuffer<bindingType>> command_buffer)
 {
@@ -846,9 +975,7 @@ inline vk::Semaphore RenderContext<bindingType>::submit_impl(const vkb::core::HP
 		submit_info.pWaitDstStageMask  = &wait_pipeline_stage;
 	}
 
-	vk::Fence fence = frame.get_fence_pool().request_fence();
-
-	queue.get_handle().submit(submit_info, fence);
+	submit_frame_impl(queue, submit_info);
 
 	return signal_semaphore;
 }
@@ -877,9 +1004,46 @@ inline void RenderContext<bindingType>::submit_impl(vkb::core::HPPQueue const
 
 	vk::SubmitInfo submit_info{.commandBufferCount = to_u32(cmd_buf_handles.size()), .pCommandBuffers = cmd_buf_handles.data()};
 
-	vk::Fence fence = frames[active_frame_index]->get_fence_pool().request_fence();
+	submit_frame_impl(queue, submit_info);
+}
+
+template <vkb::BindingType bindingType>
+inline void RenderContext<bindingType>::submit_frame_impl(vkb::core::HPPQueue const &queue, vk::SubmitInfo submit_info)
+{
+	vkb::rendering::RenderFrameCpp &frame = *frames[active_frame_index];
+
+	if (!timeline_semaphore_sync)
+	{
+		queue.get_handle().submit(submit_info, frame.get_fence_pool().request_fence());
+		return;
+	}
+
+	assert(submit_info.signalSemaphoreCount <= 1 && "Only one binary semaphore can be signaled along with the timeline");
+
+	auto    &timeline = get_timeline_semaphore_impl(queue);
+	uint64_t value    = timeline.request_value();
+
+	// The value of a binary semaphore is ignored
+	std::array<vk::Semaphore, 2> signal_semaphores{};
+	std::array<uint64_t, 2>      signal_values{};
+	uint32_t                     signal_count = 0;
+
+	if (submit_info.signalSemaphoreCount == 1)
+	{
+		signal_semaphores[signal_count++] = submit_info.pSignalSemaphores[0];
+	}
+	signal_semaphores[signal_count] = timeline.get_handle();
+	signal_values[signal_count++]   = value;
+
+	vk::TimelineSemaphoreSubmitInfo timeline_info{.signalSemaphoreValueCount = signal_count, .pSignalSemaphoreValues = signal_values.data()};
+
+	submit_info.pNext                = &timeline_info;
+	submit_info.signalSemaphoreCount = signal_count;
+	submit_info.pSignalSemaphores    = signal_semaphores.data();
+
+	queue.get_handle().submit(submit_info);
 
-	queue.get_handle().submit(submit_info, fence);
+	frame.track_timeline_value(timeline, value);
 }
 
 template <vkb::BindingType bindingType>
@@ -23,6 +23,8 @@
 #include "core/hpp_queue.h"
 #include "core/queue.h"
 #include "hpp_semaphore_pool.h"
+#include "hpp_timeline_semaphore.h"
+#include <optional>
 
 namespace vkb
 {
@@ -70,6 +72,7 @@ class RenderFrame
 	using FencePoolType           = typename std::conditional<bindingType == vkb::BindingType::Cpp, vkb::HPPFencePool, vkb::FencePool>::type;
 	using QueueType               = typename std::conditional<bindingType == vkb::BindingType::Cpp, vkb::core::HPPQueue, vkb::Queue>::type;
 	using SemaphorePoolType       = typename std::conditional<bindingType == vkb::BindingType::Cpp, vkb::HPPSemaphorePool, vkb::SemaphorePool>::type;
+	using TimelineSemaphoreType   = typename std::conditional<bindingType == vkb::BindingType::Cpp, vkb::HPPTimelineSemaphore, vkb::TimelineSemaphore>::type;
 
   public:
 	RenderFrame(vkb::core::Device<bindingType> &device, std::unique_ptr<vkb::rendering::RenderTarget<bindingType>> &&render_target, size_t thread_count = 1);
@@ -106,12 +109,34 @@ class RenderFrame
 	vkb::rendering::RenderTarget<bindingType> const &get_render_target() const;
 	SemaphorePoolType                               &get_semaphore_pool();
 	SemaphorePoolType const                         &get_semaphore_pool() const;
+
+	/**
+	 * @return The number of threads this frame has resource pools for, thread indices must be lower than it
+	 */
+	size_t get_thread_count() const;
+
+	/**
+	 * @return The resource cache frame of the last recording of this frame the GPU may still be executing,
+	 *         or std::nullopt once reset() waited for it
+	 */
+	std::optional<uint32_t> get_resource_cache_frame() const;
+
 	DescriptorSetType                                request_descriptor_set(DescriptorSetLayoutType const              &descriptor_set_layout,
 	                                                                        BindingMap<DescriptorBufferInfoType> const &buffer_infos,
 	                                                                        BindingMap<DescriptorImageInfoType> const  &image_infos,
 	                                                                        bool                                        update_after_bind,
 	                                                                        size_t                                      thread_index = 0);
-	void                                             reset();
+
+	/**
+	 * @brief Requests a descriptor set written with the update template of its layout
+	 * @param descriptor_set_layout A descriptor set layout with an update template
+	 * @param descriptor_infos The descriptors in the layout of the update template, the whole array is hashed to find the descriptor set
+	 * @param thread_index Selects the thread's descriptor pool and cache
+	 * @return The descriptor set
+	 */
+	DescriptorSetType request_descriptor_set(DescriptorSetLayoutType const &descriptor_set_layout, std::vector<vkb::DescriptorUpdateInfo> const &descriptor_infos, size_t thread_index = 0);
+
+	void reset();
 
 	/**
 	 * @brief Sets a new buffer allocation strategy
@@ -119,12 +144,27 @@ class RenderFrame
 	 */
 	void set_buffer_allocation_strategy(BufferAllocationStrategy new_strategy);
 
+	/**
+	 * @brief Records the resource cache frame this frame is recorded in, so that the objects it uses are not evicted
+	 *        before reset() waited for the GPU
+	 * @param frame The frame returned by the resource cache when this frame began
+	 */
+	void set_resource_cache_frame(uint32_t frame);
+
 	/**
 	 * @brief Sets a new descriptor set management strategy
 	 * @param new_strategy The new descriptor set management strategy
 	 */
 	void set_descriptor_management_strategy(DescriptorManagementStrategy new_strategy);
 
+	/**
+	 * @brief Records the value signaled on a timeline semaphore by a submission of this frame
+	 *        reset() waits for the timeline to reach it, so the submission does not need a fence
+	 * @param timeline The timeline semaphore of the queue the frame was submitted to
+	 * @param value The value signaled by the submission
+	 */
+	void track_timeline_value(TimelineSemaphoreType &timeline, uint64_t value);
+
 	/**
 	 * @brief Updates all the descriptor sets in the current frame at a specific thread index
 	 */
@@ -154,15 +194,21 @@ class RenderFrame
 	                                              BindingMap<vk::DescriptorImageInfo> const  &image_infos,
 	                                              bool                                        update_after_bind,
 	                                              size_t                                      thread_index = 0);
+	vk::DescriptorSet request_descriptor_set_impl(vkb::core::HPPDescriptorSetLayout const       &descriptor_set_layout,
+	                                              std::vector<vkb::DescriptorUpdateInfo> const &descriptor_infos,
+	                                              size_t                                        thread_index);
 
   private:
 	vkb::core::DeviceCpp                                                                             &device;
 	std::map<vk::BufferUsageFlags, std::vector<std::pair<vkb::BufferPoolCpp, vkb::BufferBlockCpp *>>> buffer_pools;
-	std::map<uint32_t, std::vector<vkb::core::CommandPoolCpp>>                                        command_pools;           // Commands pools per queue family index
-	std::vector<std::unordered_map<std::size_t, vkb::core::HPPDescriptorPool>>                        descriptor_pools;        // Descriptor pools per thread
-	std::vector<std::unordered_map<std::size_t, vkb::core::HPPDescriptorSet>>                         descriptor_sets;         // Descriptor sets per thread
+	std::map<uint32_t, std::vector<vkb::core::CommandPoolCpp>>                                        command_pools;                    // Commands pools per queue family index
+	std::vector<std::unordered_map<ResourceKey, vkb::core::HPPDescriptorPool>>                        descriptor_pools;                 // Descriptor pools per thread
+	std::vector<std::unordered_map<ResourceKey, vkb::core::HPPDescriptorSet>>                         descriptor_sets;                  // Descriptor sets per thread
+	std::vector<std::unordered_map<ResourceKey, vk::DescriptorSet>>                                   templated_descriptor_sets;        // Descriptor sets written with update templates per thread
 	vkb::HPPFencePool                                                                                 fence_pool;
 	vkb::HPPSemaphorePool                                                                             semaphore_pool;
+	std::vector<std::pair<vkb::HPPTimelineSemaphore *, uint64_t>>                                     timeline_values;        // Last value signaled by this frame on each timeline
+	std::optional<uint32_t>                                                                           resource_cache_frame;        // Resource cache frame of the recording the GPU may still be executing
 	std::unique_ptr<vkb::rendering::RenderTargetCpp>                                                  swapchain_render_target;
 	size_t                                                                                            thread_count;
 	BufferAllocationStrategy                                                                          buffer_allocation_strategy     = BufferAllocationStrategy::MultipleAllocationsPerBuffer;
@@ -176,7 +222,7 @@ template <vkb::BindingType bindingType>
 inline RenderFrame<bindingType>::RenderFrame(vkb::core::Device<bindingType>                              &device_,
                                              std::unique_ptr<vkb::rendering::RenderTarget<bindingType>> &&render_target,
                                              size_t                                                       thread_count) :
-    device(reinterpret_cast<vkb::core::DeviceCpp &>(device_)), fence_pool{device}, semaphore_pool{device}, thread_count{thread_count}, descriptor_pools(thread_count), descriptor_sets(thread_count)
+    device(reinterpret_cast<vkb::core::DeviceCpp &>(device_)), fence_pool{device}, semaphore_pool{device}, thread_count{thread_count}, descriptor_pools(thread_count), descriptor_sets(thread_count), templated_descriptor_sets(thread_count)
 {
 	static constexpr uint32_t BUFFER_POOL_BLOCK_SIZE = 256;        // Block size of a buffer pool in kilobytes
 
@@ -256,6 +302,11 @@ inline void RenderFrame<bindingType>::clear_descriptors()
 		desc_sets_per_thread.clear();
 	}
 
+	for (auto &desc_sets_per_thread : templated_descriptor_sets)
+	{
+		desc_sets_per_thread.clear();
+	}
+
 	for (auto &desc_pools_per_thread : descriptor_pools)
 	{
 		for (auto &desc_pool : desc_pools_per_thread)
@@ -423,6 +474,18 @@ inline typename RenderFrame<bindingType>::SemaphorePoolType const &RenderFrame<b
 	}
 }
 
+template <vkb::BindingType bindingType>
+inline size_t RenderFrame<bindingType>::get_thread_count() const
+{
+	return thread_count;
+}
+
+template <vkb::BindingType bindingType>
+inline std::optional<uint32_t> RenderFrame<bindingType>::get_resource_cache_frame() const
+{
+	return resource_cache_frame;
+}
+
 template <vkb::BindingType bindingType>
 inline typename RenderFrame<bindingType>::DescriptorSetType RenderFrame<bindingType>::request_descriptor_set(DescriptorSetLayoutType const              &descriptor_set_layout,
                                                                                                              BindingMap<DescriptorBufferInfoType> const &buffer_infos,
@@ -491,11 +554,79 @@ inline vk::DescriptorSet RenderFrame<bindingType>::request_descriptor_set_impl(v
 	}
 }
 
+template <vkb::BindingType bindingType>
+inline typename RenderFrame<bindingType>::DescriptorSetType RenderFrame<bindingType>::request_descriptor_set(DescriptorSetLayoutType const                &descriptor_set_layout,
+                                                                                                             std::vector<vkb::DescriptorUpdateInfo> const &descriptor_infos,
+                                                                                                             size_t                                        thread_index)
+{
+	assert(thread_index < thread_count && "Thread index is out of bounds");
+	assert(thread_index < templated_descriptor_sets.size());
+
+	if constexpr (bindingType == vkb::BindingType::Cpp)
+	{
+		return request_descriptor_set_impl(descriptor_set_layout, descriptor_infos, thread_index);
+	}
+	else
+	{
+		return static_cast<VkDescriptorSet>(
+		    request_descriptor_set_impl(reinterpret_cast<vkb::core::HPPDescriptorSetLayout const &>(descriptor_set_layout), descriptor_infos, thread_index));
+	}
+}
+
+template <vkb::BindingType bindingType>
+inline vk::DescriptorSet RenderFrame<bindingType>::request_descriptor_set_impl(vkb::core::HPPDescriptorSetLayout const       &descriptor_set_layout,
+                                                                               std::vector<vkb::DescriptorUpdateInfo> const &descriptor_infos,
+                                                                               size_t                                        thread_index)
+{
+	assert(descriptor_set_layout.get_update_template() && descriptor_infos.size() == descriptor_set_layout.get_update_template_size());
+
+	auto &descriptor_pool = vkb::common::request_resource(device, nullptr, descriptor_pools[thread_index], descriptor_set_layout);
+	if (descriptor_management_strategy == DescriptorManagementStrategy::StoreInCache)
+	{
+		// The descriptors are plain data laid out by the update template, so they are keyed as a single block of memory
+		ResourceKey key;
+		key.append(static_cast<VkDescriptorSetLayout>(descriptor_set_layout.get_handle()));
+		key.append(descriptor_infos.data(), descriptor_infos.size() * sizeof(vkb::DescriptorUpdateInfo));
+		key.finalize();
+
+		auto &thread_descriptor_sets = templated_descriptor_sets[thread_index];
+
+		auto descriptor_set_it = thread_descriptor_sets.find(key);
+		if (descriptor_set_it != thread_descriptor_sets.end())
+		{
+			return descriptor_set_it->second;
+		}
+
+		vk::DescriptorSet descriptor_set = descriptor_pool.allocate();
+		device.get_handle().updateDescriptorSetWithTemplate(descriptor_set, descriptor_set_layout.get_update_template(), descriptor_infos.data());
+
+		thread_descriptor_sets.emplace(std::move(key), descriptor_set);
+
+		return descriptor_set;
+	}
+	else
+	{
+		// Allocate a descriptor set and write the descriptors to it, without keeping it for later requests
+		vk::DescriptorSet descriptor_set = descriptor_pool.allocate();
+		device.get_handle().updateDescriptorSetWithTemplate(descriptor_set, descriptor_set_layout.get_update_template(), descriptor_infos.data());
+		return descriptor_set;
+	}
+}
+
 template <vkb::BindingType bindingType>
 inline void RenderFrame<bindingType>::reset()
 {
+	for (auto &timeline_value : timeline_values)
+	{
+		VK_CHECK(timeline_value.first->wait(timeline_value.second));
+	}
+	timeline_values.clear();
+
 	VK_CHECK(fence_pool.wait());
 
+	// The GPU is done with the objects recorded in this frame
+	resource_cache_frame.reset();
+
 	fence_pool.reset();
 
 	for (auto &command_pools_per_queue : command_pools)
@@ -529,12 +660,43 @@ inline void RenderFrame<bindingType>::set_buffer_allocation_strategy(BufferAlloc
 	buffer_allocation_strategy = new_strategy;
 }
 
+template <vkb::BindingType bindingType>
+inline void RenderFrame<bindingType>::set_resource_cache_frame(uint32_t frame)
+{
+	resource_cache_frame = frame;
+}
+
 template <vkb::BindingType bindingType>
 inline void RenderFrame<bindingType>::set_descriptor_management_strategy(DescriptorManagementStrategy new_strategy)
 {
 	descriptor_management_strategy = new_strategy;
 }
 
+template <vkb::BindingType bindingType>
+inline void RenderFrame<bindingType>::track_timeline_value(TimelineSemaphoreType &timeline, uint64_t value)
+{
+	vkb::HPPTimelineSemaphore *timeline_ptr;
+	if constexpr (bindingType == vkb::BindingType::Cpp)
+	{
+		timeline_ptr = &timeline;
+	}
+	else
+	{
+		timeline_ptr = reinterpret_cast<vkb::HPPTimelineSemaphore *>(&timeline);
+	}
+
+	auto it = std::ranges::find_if(timeline_values, [timeline_ptr](auto const &timeline_value) { return timeline_value.first == timeline_ptr; });
+	if (it == timeline_values.end())
+	{
+		timeline_values.emplace_back(timeline_ptr, value);
+	}
+	else
+	{
+		// Values on a timeline only grow, waiting for the last one covers all earlier submissions
+		it->second = std::max(it->second, value);
+	}
+}
+
 template <vkb::BindingType bindingType>
 inline void RenderFrame<bindingType>::update_descriptor_sets(size_t thread_index)
 {
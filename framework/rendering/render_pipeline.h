@@ -19,6 +19,7 @@
 #pragma once
 
 #include "common/hpp_vk_common.h"
+#include "common/job_system.h"
 #include "common/vk_common.h"
 #include "core/command_buffer.h"
 #include "rendering/render_target.h"
@@ -39,6 +40,10 @@ namespace rendering
  * GeometrySubpass -> Processes Scene for Shaders, use by itself if shader requires no lighting
  * ForwardSubpass -> Binds lights at the beginning of a GeometrySubpass to create Forward Rendering, should be used with most default shaders
  * LightingSubpass -> Holds a Global Light uniform, Can be combined with GeometrySubpass to create Deferred Rendering
+ * ClusteredLightingSubpass -> Like LightingSubpass, but bins the lights into clusters with a compute pass, with no limit on the number of lights
+ *
+ * With parallel recording enabled, the subpasses splitting their draws into chunks are recorded into secondary
+ * command buffers, one per chunk, on the threads of the JobSystem, and executed by the primary command buffer.
  */
 template <vkb::BindingType bindingType>
 class RenderPipeline
@@ -101,16 +106,32 @@ class RenderPipeline
 	 */
 	void set_load_store(const std::vector<LoadStoreInfoType> &load_store);
 
+	/**
+	 * @brief Records the chunks of the subpasses in secondary command buffers in parallel, disabled by default
+	 *        A subpass is split into at most as many chunks as the render frame has threads, so the render context
+	 *        must be prepared with several threads. Secondary command buffers set the viewport and scissor to the
+	 *        extent of the render target, and the commands recorded after RenderPipeline::draw() in a subpass
+	 *        recorded in parallel must be executed from a secondary command buffer as well.
+	 *        Only used when the contents passed to RenderPipeline::draw() are inline.
+	 */
+	void set_parallel_recording(bool enabled);
+
   private:
-	void draw_impl(vkb::core::CommandBufferCpp     &command_buffer,
-	               vkb::rendering::RenderTargetCpp &render_target,
-	               vk::SubpassContents              contents);
+	void     draw_impl(vkb::core::CommandBufferCpp     &command_buffer,
+	                   vkb::rendering::RenderTargetCpp &render_target,
+	                   vk::SubpassContents              contents);
+	void     draw_chunks_impl(vkb::core::CommandBufferCpp     &command_buffer,
+	                          vkb::rendering::RenderTargetCpp &render_target,
+	                          vkb::rendering::SubpassCpp      &subpass,
+	                          uint32_t                         chunk_count);
+	uint32_t get_max_chunk_count(vkb::core::CommandBufferCpp &command_buffer) const;
 
   private:
 	size_t                                                   active_subpass_index = 0;
 	std::vector<vk::ClearValue>                              clear_value{vk::ClearColorValue{0.0f, 0.0f, 0.0f, 1.0f}, vk::ClearDepthStencilValue{0.0f, ~0U}};                                                    // Defaults for swapchain and depth attachment
 	std::vector<vkb::common::HPPLoadStoreInfo>               load_store{{vk::AttachmentLoadOp::eClear, vk::AttachmentStoreOp::eStore}, {vk::AttachmentLoadOp::eClear, vk::AttachmentStoreOp::eDontCare}};        // Defaults for swapchain and depth attachment
 	std::vector<std::unique_ptr<vkb::rendering::SubpassCpp>> subpasses;
+	bool                                                     parallel_recording = false;
 };
 
 using RenderPipelineC   = RenderPipeline<vkb::BindingType::C>;
@@ -177,6 +198,10 @@ void RenderPipeline<bindingType>::draw_impl(vkb::core::CommandBufferCpp     &com
                                             vkb::rendering::RenderTargetCpp &render_target,
                                             vk::SubpassContents              contents)
 {
+	// Subpasses are only split if the caller records them inline, otherwise it already records its own secondary command buffers
+	bool     record_chunks   = parallel_recording && (contents == vk::SubpassContents::eInline);
+	uint32_t max_chunk_count = record_chunks ? get_max_chunk_count(command_buffer) : 1;
+
 	for (size_t i = 0; i < subpasses.size(); ++i)
 	{
 		active_subpass_index = i;
@@ -185,16 +210,20 @@ void RenderPipeline<bindingType>::draw_impl(vkb::core::CommandBufferCpp     &com
 
 		subpass->update_render_target_attachments(render_target);
 
+		// Chunks are prepared before the subpass begins, as the subpass contents depend on their count
+		uint32_t            chunk_count      = record_chunks ? subpass->prepare_draw_chunks(max_chunk_count) : 1;
+		vk::SubpassContents subpass_contents = (chunk_count > 1) ? vk::SubpassContents::eSecondaryCommandBuffers : contents;
+
 		if (i == 0)
 		{
-			command_buffer.begin_render_pass(render_target, load_store, clear_value, subpasses, contents);
+			command_buffer.begin_render_pass(render_target, load_store, clear_value, subpasses, subpass_contents);
 		}
 		else
 		{
-			command_buffer.next_subpass();
+			command_buffer.next_subpass(subpass_contents);
 		}
 
-		if (contents != vk::SubpassContents::eSecondaryCommandBuffers)
+		if (subpass_contents != vk::SubpassContents::eSecondaryCommandBuffers)
 		{
 			if (subpass->get_debug_name().empty())
 			{
@@ -203,10 +232,72 @@ void RenderPipeline<bindingType>::draw_impl(vkb::core::CommandBufferCpp     &com
 			ScopedDebugLabel subpass_debug_label{reinterpret_cast<vkb::core::CommandBufferC const &>(command_buffer), subpass->get_debug_name().c_str()};
 		}
 
-		subpass->draw(command_buffer);
+		if (chunk_count > 1)
+		{
+			draw_chunks_impl(command_buffer, render_target, *subpass, chunk_count);
+		}
+		else if (record_chunks)
+		{
+			subpass->draw_chunk(command_buffer, 0);
+		}
+		else
+		{
+			subpass->draw(command_buffer);
+		}
 	}
 }
 
+template <vkb::BindingType bindingType>
+void RenderPipeline<bindingType>::draw_chunks_impl(vkb::core::CommandBufferCpp     &command_buffer,
+                                                   vkb::rendering::RenderTargetCpp &render_target,
+                                                   vkb::rendering::SubpassCpp      &subpass,
+                                                   uint32_t                         chunk_count)
+{
+	auto &primary_pool = command_buffer.get_command_pool();
+	auto &render_frame = *primary_pool.get_render_frame();
+	auto &queue        = command_buffer.get_device().get_queue(primary_pool.get_queue_family_index(), 0);
+
+	// Command pools may be created when requested, so the secondary command buffers are requested before recording starts,
+	// each one from the pool of the thread index its chunk uses
+	std::vector<std::shared_ptr<vkb::core::CommandBufferCpp>> secondary_command_buffers(chunk_count);
+	for (uint32_t chunk_index = 0; chunk_index < chunk_count; ++chunk_index)
+	{
+		secondary_command_buffers[chunk_index] =
+		    render_frame.get_command_pool(queue, primary_pool.get_reset_mode(), chunk_index).request_command_buffer(vk::CommandBufferLevel::eSecondary);
+	}
+
+	vk::Extent2D extent = render_target.get_extent();
+
+	JobSystem::get().parallel_for(chunk_count, [&](size_t chunk_index) {
+		auto &secondary_command_buffer = *secondary_command_buffers[chunk_index];
+
+		secondary_command_buffer.begin(vk::CommandBufferUsageFlagBits::eOneTimeSubmit | vk::CommandBufferUsageFlagBits::eRenderPassContinue, &command_buffer);
+
+		// Dynamic state is not inherited from the primary command buffer
+		secondary_command_buffer.set_viewport(0, {{0.0f, 0.0f, static_cast<float>(extent.width), static_cast<float>(extent.height), 0.0f, 1.0f}});
+		secondary_command_buffer.set_scissor(0, {{{}, extent}});
+
+		subpass.draw_chunk(secondary_command_buffer, static_cast<uint32_t>(chunk_index));
+
+		secondary_command_buffer.end();
+	});
+
+	command_buffer.execute_commands(secondary_command_buffers);
+}
+
+template <vkb::BindingType bindingType>
+uint32_t RenderPipeline<bindingType>::get_max_chunk_count(vkb::core::CommandBufferCpp &command_buffer) const
+{
+	// Chunks use the resource pools of the render frame of the primary command buffer, one per thread
+	auto *render_frame = command_buffer.get_command_pool().get_render_frame();
+	if (!render_frame)
+	{
+		return 1;
+	}
+
+	return static_cast<uint32_t>(std::min(render_frame->get_thread_count(), JobSystem::get().get_thread_count()));
+}
+
 template <vkb::BindingType bindingType>
 const std::vector<typename RenderPipeline<bindingType>::ClearValueType> &RenderPipeline<bindingType>::get_clear_value() const
 {
@@ -294,5 +385,11 @@ void RenderPipeline<bindingType>::set_load_store(const std::vector<LoadStoreInfo
 	}
 }
 
+template <vkb::BindingType bindingType>
+void RenderPipeline<bindingType>::set_parallel_recording(bool enabled)
+{
+	parallel_recording = enabled;
+}
+
 }        // namespace rendering
 }        // namespace vkb
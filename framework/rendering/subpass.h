@@ -95,6 +95,22 @@ class Subpass
 	 */
 	virtual void draw(vkb::core::CommandBuffer<bindingType> &command_buffer) = 0;
 
+	/**
+	 * @brief Prepares the draws of the frame to be recorded in chunks, possibly on several threads at once
+	 *        Subpasses which override draw() must override draw_chunk() as well before splitting their draws
+	 * @param max_chunk_count The maximum number of chunks the draws can be split into
+	 * @return The number of chunks to record with draw_chunk(), by default 1
+	 */
+	virtual uint32_t prepare_draw_chunks(uint32_t max_chunk_count);
+
+	/**
+	 * @brief Records a chunk of the draws prepared with prepare_draw_chunks(), by default the whole subpass
+	 *        Chunks are recorded concurrently in secondary command buffers, so they must not modify the subpass
+	 * @param command_buffer Command buffer to use to record draw commands
+	 * @param chunk_index Index of the chunk, also the index of the thread resources of the render frame to use
+	 */
+	virtual void draw_chunk(vkb::core::CommandBuffer<bindingType> &command_buffer, uint32_t chunk_index);
+
 	/**
 	 * @brief Prepares the shaders and shader variants for a subpass
 	 */
@@ -223,6 +239,18 @@ inline Subpass<bindingType>::Subpass(vkb::rendering::RenderContext<bindingType>
 	}
 }
 
+template <vkb::BindingType bindingType>
+inline uint32_t Subpass<bindingType>::prepare_draw_chunks(uint32_t /*max_chunk_count*/)
+{
+	return 1;
+}
+
+template <vkb::BindingType bindingType>
+inline void Subpass<bindingType>::draw_chunk(vkb::core::CommandBuffer<bindingType> &command_buffer, uint32_t /*chunk_index*/)
+{
+	draw(command_buffer);
+}
+
 template <vkb::BindingType bindingType>
 inline const std::vector<uint32_t> &Subpass<bindingType>::get_input_attachments() const
 {
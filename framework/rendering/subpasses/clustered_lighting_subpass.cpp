@@ -0,0 +1,248 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "clustered_lighting_subpass.h"
+
+#include "buffer_pool.h"
+#include "core/command_buffer.h"
+#include "core/debug.h"
+#include "rendering/render_context.h"
+#include "resource_cache.h"
+#include "scene_graph/components/camera.h"
+#include "scene_graph/components/light.h"
+#include "scene_graph/components/orthographic_camera.h"
+#include "scene_graph/components/perspective_camera.h"
+#include "scene_graph/node.h"
+#include "scene_graph/scene.h"
+
+namespace vkb
+{
+ClusteredLightingSubpass::ClusteredLightingSubpass(
+    vkb::rendering::RenderContextC &render_context, ShaderSource &&vertex_shader, ShaderSource &&fragment_shader, sg::Camera &cam, vkb::scene_graph::SceneC &scene_) :
+    Subpass{render_context, std::move(vertex_shader), std::move(fragment_shader)}, camera{cam}, scene{scene_}
+{
+}
+
+void ClusteredLightingSubpass::prepare()
+{
+	// Build all shaders upfront
+	auto &resource_cache = get_render_context().get_device().get_resource_cache();
+	resource_cache.request_shader_module(VK_SHADER_STAGE_VERTEX_BIT, get_vertex_shader(), lighting_variant);
+	resource_cache.request_shader_module(VK_SHADER_STAGE_FRAGMENT_BIT, get_fragment_shader(), lighting_variant);
+	resource_cache.request_shader_module(VK_SHADER_STAGE_COMPUTE_BIT, culling_shader);
+}
+
+void ClusteredLightingSubpass::record_light_culling(vkb::core::CommandBufferC &command_buffer)
+{
+	gather_lights();
+
+	auto      &render_frame = get_render_context().get_active_frame();
+	VkExtent2D extent       = render_frame.get_render_target().get_extent();
+
+	glm::uvec4 grid{(extent.width + cluster_tile_size - 1) / cluster_tile_size,
+	                (extent.height + cluster_tile_size - 1) / cluster_tile_size,
+	                cluster_depth_slices,
+	                cluster_tile_size};
+
+	update_cluster_buffers(grid.x * grid.y * grid.z);
+
+	glm::mat4 proj = vkb::rendering::vulkan_style_projection(camera.get_projection());
+
+	ClusterUniform cluster_uniform;
+	cluster_uniform.inv_view_proj  = glm::inverse(proj * camera.get_view());
+	cluster_uniform.view           = camera.get_view();
+	cluster_uniform.inv_proj       = glm::inverse(proj);
+	cluster_uniform.inv_resolution = glm::vec2(1.0f / extent.width, 1.0f / extent.height);
+	cluster_uniform.depth_range    = get_depth_range();
+	cluster_uniform.grid           = grid;
+	cluster_uniform.light_counts   = glm::uvec4(directional_light_count,
+	                                            directional_light_count + point_light_count,
+	                                            static_cast<uint32_t>(lights.size()),
+	                                            max_lights_per_cluster);
+
+	uniform_allocation = render_frame.allocate_buffer(VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, sizeof(ClusterUniform));
+	uniform_allocation.update(cluster_uniform);
+
+	// Keep the buffer valid to bind when the scene has no lights
+	light_allocation = render_frame.allocate_buffer(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, std::max<size_t>(lights.size(), 1) * sizeof(vkb::rendering::Light));
+	if (!lights.empty())
+	{
+		auto *light_data = reinterpret_cast<const uint8_t *>(lights.data());
+		light_allocation.update(std::vector<uint8_t>{light_data, light_data + lights.size() * sizeof(vkb::rendering::Light)});
+	}
+
+	vkb::ScopedDebugLabel debug_label{command_buffer, "Cull clustered lights"};
+
+	// The lighting pass of the previous frame must be done reading the clusters before they are written again
+	BufferMemoryBarrier reuse_barrier;
+	reuse_barrier.src_stage_mask  = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+	reuse_barrier.dst_stage_mask  = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+	reuse_barrier.src_access_mask = 0;
+	reuse_barrier.dst_access_mask = VK_ACCESS_SHADER_WRITE_BIT;
+	command_buffer.buffer_memory_barrier(*cluster_light_counts, 0, VK_WHOLE_SIZE, reuse_barrier);
+	command_buffer.buffer_memory_barrier(*cluster_light_indices, 0, VK_WHOLE_SIZE, reuse_barrier);
+
+	auto &resource_cache  = command_buffer.get_device().get_resource_cache();
+	auto &shader_module   = resource_cache.request_shader_module(VK_SHADER_STAGE_COMPUTE_BIT, culling_shader);
+	auto &pipeline_layout = resource_cache.request_pipeline_layout({&shader_module});
+
+	command_buffer.bind_pipeline_layout(pipeline_layout);
+
+	command_buffer.bind_buffer(uniform_allocation.get_buffer(), uniform_allocation.get_offset(), uniform_allocation.get_size(), 0, 0, 0);
+	command_buffer.bind_buffer(light_allocation.get_buffer(), light_allocation.get_offset(), light_allocation.get_size(), 0, 1, 0);
+	command_buffer.bind_buffer(*cluster_light_counts, 0, cluster_light_counts->get_size(), 0, 2, 0);
+	command_buffer.bind_buffer(*cluster_light_indices, 0, cluster_light_indices->get_size(), 0, 3, 0);
+
+	command_buffer.dispatch((cluster_count + 63) / 64, 1, 1);
+
+	BufferMemoryBarrier lighting_barrier;
+	lighting_barrier.src_stage_mask  = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+	lighting_barrier.dst_stage_mask  = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+	lighting_barrier.src_access_mask = VK_ACCESS_SHADER_WRITE_BIT;
+	lighting_barrier.dst_access_mask = VK_ACCESS_SHADER_READ_BIT;
+	command_buffer.buffer_memory_barrier(*cluster_light_counts, 0, VK_WHOLE_SIZE, lighting_barrier);
+	command_buffer.buffer_memory_barrier(*cluster_light_indices, 0, VK_WHOLE_SIZE, lighting_barrier);
+}
+
+void ClusteredLightingSubpass::draw(vkb::core::CommandBufferC &command_buffer)
+{
+	assert(cluster_light_counts && "record_light_culling() must be recorded before drawing the subpass");
+
+	// Get shaders from cache
+	auto &resource_cache     = command_buffer.get_device().get_resource_cache();
+	auto &vert_shader_module = resource_cache.request_shader_module(VK_SHADER_STAGE_VERTEX_BIT, get_vertex_shader(), lighting_variant);
+	auto &frag_shader_module = resource_cache.request_shader_module(VK_SHADER_STAGE_FRAGMENT_BIT, get_fragment_shader(), lighting_variant);
+
+	std::vector<ShaderModule *> shader_modules{&vert_shader_module, &frag_shader_module};
+
+	// Create pipeline layout and bind it
+	auto &pipeline_layout = resource_cache.request_pipeline_layout(shader_modules);
+	command_buffer.bind_pipeline_layout(pipeline_layout);
+
+	// we know, that the lighting subpass does not have any vertex stage input -> reset the vertex input state
+	assert(pipeline_layout.get_resources(ShaderResourceType::Input, VK_SHADER_STAGE_VERTEX_BIT).empty());
+	command_buffer.set_vertex_input_state({});
+
+	// Get image views of the attachments
+	auto &render_target = get_render_context().get_active_frame().get_render_target();
+	auto &target_views  = render_target.get_views();
+	assert(3 < target_views.size());
+
+	// Bind depth, albedo, and normal as input attachments
+	command_buffer.bind_input(target_views[1], 0, 0, 0);
+	command_buffer.bind_input(target_views[2], 0, 1, 0);
+	command_buffer.bind_input(target_views[3], 0, 2, 0);
+
+	// Set cull mode to front as full screen triangle is clock-wise
+	vkb::rendering::RasterizationStateC rasterization_state;
+	rasterization_state.cull_mode = VK_CULL_MODE_FRONT_BIT;
+	command_buffer.set_rasterization_state(rasterization_state);
+
+	// Bind the uniform and the lights of the frame, and the clusters written by the culling pass
+	command_buffer.bind_buffer(uniform_allocation.get_buffer(), uniform_allocation.get_offset(), uniform_allocation.get_size(), 0, 3, 0);
+	command_buffer.bind_buffer(light_allocation.get_buffer(), light_allocation.get_offset(), light_allocation.get_size(), 0, 4, 0);
+	command_buffer.bind_buffer(*cluster_light_counts, 0, cluster_light_counts->get_size(), 0, 5, 0);
+	command_buffer.bind_buffer(*cluster_light_indices, 0, cluster_light_indices->get_size(), 0, 6, 0);
+
+	// Draw full screen triangle
+	command_buffer.draw(3, 1, 0, 0);
+}
+
+void ClusteredLightingSubpass::gather_lights()
+{
+	std::vector<vkb::rendering::Light> point_lights;
+	std::vector<vkb::rendering::Light> spot_lights;
+
+	lights.clear();
+
+	for (auto *scene_light : scene.get_components<sg::Light>())
+	{
+		const auto &properties = scene_light->get_properties();
+		auto       &transform  = scene_light->get_node()->get_transform();
+
+		vkb::rendering::Light light{{transform.get_translation(), static_cast<float>(scene_light->get_light_type())},
+		                            {properties.color, properties.intensity},
+		                            {transform.get_rotation() * properties.direction, properties.range},
+		                            {properties.inner_cone_angle, properties.outer_cone_angle}};
+
+		switch (scene_light->get_light_type())
+		{
+			case sg::LightType::Directional:
+				lights.push_back(light);
+				break;
+			case sg::LightType::Point:
+				point_lights.push_back(light);
+				break;
+			case sg::LightType::Spot:
+				spot_lights.push_back(light);
+				break;
+			default:
+				LOGE("ClusteredLightingSubpass::gather_lights: encountered unknown light type {}", to_string(scene_light->get_light_type()));
+				break;
+		}
+	}
+
+	directional_light_count = static_cast<uint32_t>(lights.size());
+	point_light_count       = static_cast<uint32_t>(point_lights.size());
+
+	lights.insert(lights.end(), point_lights.begin(), point_lights.end());
+	lights.insert(lights.end(), spot_lights.begin(), spot_lights.end());
+}
+
+glm::vec2 ClusteredLightingSubpass::get_depth_range() const
+{
+	glm::vec2 depth_range{0.1f, 100.0f};
+
+	if (auto *perspective_camera = dynamic_cast<sg::PerspectiveCamera *>(&camera))
+	{
+		depth_range = {perspective_camera->get_near_plane(), perspective_camera->get_far_plane()};
+	}
+	else if (auto *orthographic_camera = dynamic_cast<sg::OrthographicCamera *>(&camera))
+	{
+		depth_range = {orthographic_camera->get_near_plane(), orthographic_camera->get_far_plane()};
+	}
+
+	// The depth slices are exponential, so the first one cannot start at the eye
+	depth_range.x = std::max(depth_range.x, 0.01f);
+	depth_range.y = std::max(depth_range.y, depth_range.x * 2.0f);
+
+	return depth_range;
+}
+
+void ClusteredLightingSubpass::update_cluster_buffers(uint32_t count)
+{
+	if (count == cluster_count)
+	{
+		return;
+	}
+
+	auto &device = get_render_context().get_device();
+
+	// The previous buffers may still be read by frames in flight, this only happens when the render target is resized
+	if (cluster_light_counts)
+	{
+		device.wait_idle();
+	}
+
+	cluster_count = count;
+
+	cluster_light_counts = std::make_unique<vkb::core::BufferC>(device, cluster_count * sizeof(uint32_t), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VMA_MEMORY_USAGE_GPU_ONLY);
+
+	cluster_light_indices = std::make_unique<vkb::core::BufferC>(
+	    device, cluster_count * max_lights_per_cluster * sizeof(uint32_t), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VMA_MEMORY_USAGE_GPU_ONLY);
+}
+}        // namespace vkb
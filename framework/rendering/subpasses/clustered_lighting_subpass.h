@@ -0,0 +1,129 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "buffer_pool.h"
+#include "common/glm_common.h"
+#include "rendering/subpass.h"
+#include "scene_graph/scene.h"
+
+namespace vkb
+{
+namespace core
+{
+template <vkb::BindingType bindingType>
+class CommandBuffer;
+using CommandBufferC = CommandBuffer<vkb::BindingType::C>;
+}        // namespace core
+
+namespace sg
+{
+class Camera;
+class Light;
+class Scene;
+}        // namespace sg
+
+/**
+ * @brief Lighting pass of Deferred Rendering, shading each pixel with the lights reaching its cluster only
+ *
+ * The view frustum is split into a grid of clusters, screen tiles subdivided into exponential depth slices.
+ * Every frame a compute pass tests the range of the point and spot lights against the bounds of each cluster
+ * and writes the indices of the lights reaching it into a storage buffer. The fragment shader then looks up
+ * the cluster of the pixel and only iterates over its lights, so there is no limit on the number of lights
+ * of the scene, only on the number of lights reaching a single cluster.
+ * Lights with a range of zero reach every cluster. Directional lights are applied to every pixel.
+ *
+ * The fragment shader reads the lights and the clusters from storage buffers, as done by deferred/clustered_lighting.frag.
+ * Samples using this subpass must compile that shader and deferred/cluster_lights.comp.
+ * record_light_culling() must be called on the command buffer before beginning the render pass of this subpass.
+ */
+class ClusteredLightingSubpass : public vkb::rendering::SubpassC
+{
+  public:
+	/// Width and height of the screen tiles of the clusters, in pixels
+	static constexpr uint32_t cluster_tile_size = 64;
+
+	/// Number of depth slices of the clusters
+	static constexpr uint32_t cluster_depth_slices = 16;
+
+	/// Lights reaching a cluster beyond this count are ignored
+	static constexpr uint32_t max_lights_per_cluster = 128;
+
+  public:
+	ClusteredLightingSubpass(
+	    vkb::rendering::RenderContextC &render_context, ShaderSource &&vertex_shader, ShaderSource &&fragment_shader, sg::Camera &camera, vkb::scene_graph::SceneC &scene);
+
+	virtual void prepare() override;
+
+	void draw(vkb::core::CommandBufferC &command_buffer) override;
+
+	/**
+	 * @brief Records the compute pass assigning the lights of the frame to the clusters
+	 *        It must be recorded outside of a render pass, before the render pass of this subpass
+	 */
+	void record_light_culling(vkb::core::CommandBufferC &command_buffer);
+
+  private:
+	/**
+	 * @brief Uniform shared by the culling and lighting shaders
+	 */
+	struct alignas(16) ClusterUniform
+	{
+		glm::mat4  inv_view_proj;
+		glm::mat4  view;
+		glm::mat4  inv_proj;
+		glm::vec2  inv_resolution;
+		glm::vec2  depth_range;         // View space distances of the first and last depth slices
+		glm::uvec4 grid;                // Number of clusters along x, y and z, and the tile size in pixels
+		glm::uvec4 light_counts;        // Ends of the directional, point and spot lights in the light buffer, and the maximum lights per cluster
+	};
+
+	void gather_lights();
+
+	glm::vec2 get_depth_range() const;
+
+	void update_cluster_buffers(uint32_t cluster_count);
+
+  private:
+	sg::Camera &camera;
+
+	vkb::scene_graph::SceneC &scene;
+
+	ShaderVariant lighting_variant;
+
+	ShaderSource culling_shader{"deferred/cluster_lights.comp.spv"};
+
+	/// Lights of the frame, directional lights first, then point lights, then spot lights
+	std::vector<vkb::rendering::Light> lights;
+
+	uint32_t directional_light_count = 0;
+	uint32_t point_light_count       = 0;
+	uint32_t cluster_count           = 0;
+
+	/// Allocations of the frame, written by record_light_culling() and bound again by draw()
+	vkb::BufferAllocationC uniform_allocation;
+	vkb::BufferAllocationC light_allocation;
+
+	/// Number of lights reaching each cluster
+	std::unique_ptr<vkb::core::BufferC> cluster_light_counts;
+
+	/// Indices of the lights reaching each cluster, max_lights_per_cluster slots per cluster
+	std::unique_ptr<vkb::core::BufferC> cluster_light_indices;
+};
+
+}        // namespace vkb
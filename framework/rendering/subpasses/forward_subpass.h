@@ -74,8 +74,10 @@ class ForwardSubpass : public vkb::rendering::subpasses::GeometrySubpass<binding
 	virtual ~ForwardSubpass() = default;
 
 	// from vkb::rendering::Subpass
-	void draw(vkb::core::CommandBuffer<bindingType> &command_buffer) override;
-	void prepare() override;
+	void     draw(vkb::core::CommandBuffer<bindingType> &command_buffer) override;
+	void     draw_chunk(vkb::core::CommandBuffer<bindingType> &command_buffer, uint32_t chunk_index) override;
+	void     prepare() override;
+	uint32_t prepare_draw_chunks(uint32_t max_chunk_count) override;
 };
 
 using ForwardSubpassC   = ForwardSubpass<vkb::BindingType::C>;
@@ -101,9 +103,20 @@ inline void ForwardSubpass<bindingType>::draw(vkb::core::CommandBuffer<bindingTy
 	GeometrySubpass<bindingType>::draw(command_buffer);
 }
 
+template <vkb::BindingType bindingType>
+inline void ForwardSubpass<bindingType>::draw_chunk(vkb::core::CommandBuffer<bindingType> &command_buffer, uint32_t chunk_index)
+{
+	// The lights were allocated by prepare_draw_chunks, each chunk only binds them
+	command_buffer.bind_lighting(this->get_lighting_state(), 0, 4);
+
+	GeometrySubpass<bindingType>::draw_chunk(command_buffer, chunk_index);
+}
+
 template <vkb::BindingType bindingType>
 inline void ForwardSubpass<bindingType>::prepare()
 {
+	this->invalidate_draw_records();
+
 	auto &device = this->get_render_context_impl().get_device();
 	for (auto &mesh : this->get_meshes_impl())
 	{
@@ -116,6 +129,14 @@ inline void ForwardSubpass<bindingType>::prepare()
 	}
 }
 
+template <vkb::BindingType bindingType>
+inline uint32_t ForwardSubpass<bindingType>::prepare_draw_chunks(uint32_t max_chunk_count)
+{
+	this->template allocate_lights<ForwardLights>(this->get_scene().template get_components<sg::Light>(), MAX_FORWARD_LIGHT_COUNT);
+
+	return GeometrySubpass<bindingType>::prepare_draw_chunks(max_chunk_count);
+}
+
 }        // namespace subpasses
 }        // namespace rendering
 }        // namespace vkb
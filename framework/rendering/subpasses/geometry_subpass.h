@@ -18,7 +18,9 @@
 
 #pragma once
 
+#include "common/radix_sort.h"
 #include "core/command_buffer.h"
+#include "geometry/frustum.h"
 #include "rendering/render_context.h"
 #include "rendering/subpass.h"
 #include "scene_graph/components/aabb.h"
@@ -27,6 +29,11 @@
 #include "scene_graph/components/pbr_material.h"
 #include "scene_graph/components/sub_mesh.h"
 #include "scene_graph/scene.h"
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
 
 namespace vkb
 {
@@ -76,6 +83,12 @@ struct DefaultFrontFaceTypeValue<VkFrontFace>
 {
 	static constexpr VkFrontFace value = VK_FRONT_FACE_COUNTER_CLOCKWISE;
 };
+
+// Folds a hash or an address into its given number of most mixed bits, to be packed into a sort key
+inline uint64_t fold_to_bits(uint64_t value, uint32_t bits)
+{
+	return (value * 0x9E3779B97F4A7C15ull) >> (64 - bits);
+}
 }        // namespace
 
 /**
@@ -118,11 +131,38 @@ class GeometrySubpass : public vkb::rendering::Subpass<bindingType>
 	 */
 	virtual void draw(vkb::core::CommandBuffer<bindingType> &command_buffer) override;
 
+	/**
+	 * @brief Culls and sorts the draws of the frame, then splits them into chunks of at least the minimum number of draws per chunk
+	 */
+	virtual uint32_t prepare_draw_chunks(uint32_t max_chunk_count) override;
+
+	/**
+	 * @brief Records a contiguous range of the sorted draws, opaque ones first, using the chunk index as thread index
+	 */
+	virtual void draw_chunk(vkb::core::CommandBuffer<bindingType> &command_buffer, uint32_t chunk_index) override;
+
 	/**
 	 * @brief Thread index to use for allocating resources
 	 */
 	void set_thread_index(uint32_t index);
 
+	/**
+	 * @brief Sets the minimum number of draws recorded by a chunk, so that small scenes are not split, 64 by default
+	 */
+	void set_min_draws_per_chunk(uint32_t count);
+
+	/**
+	 * @brief Enables or disables culling of the mesh instances outside of the camera frustum, enabled by default
+	 */
+	void set_frustum_culling(bool enabled);
+
+	/**
+	 * @brief Drops the draw records compiled for the submeshes, so that they are compiled again when next drawn.
+	 *        prepare() calls it. It must also be called when the textures, samplers or vertex buffers of a submesh change,
+	 *        or when prepare_pipeline_layout() would return a different layout, as the records keep what they resolved.
+	 */
+	void invalidate_draw_records();
+
   protected:
 	void                                                   draw_submesh(vkb::core::CommandBuffer<bindingType> &command_buffer, SubMeshType &sub_mesh, FrontFaceType front_face = DefaultFrontFaceTypeValue<FrontFaceType>::value);
 	virtual void                                           draw_submesh_command(vkb::core::CommandBuffer<bindingType> &command_buffer, SubMeshType &sub_mesh);
@@ -134,6 +174,7 @@ class GeometrySubpass : public vkb::rendering::Subpass<bindingType>
 	/**
 	 * @brief Sorts objects based on distance from camera and classifies them
 	 *        into opaque and transparent in the arrays provided
+	 *        Unless frustum culling is disabled, objects outside of the camera frustum are left out
 	 */
 	void get_sorted_nodes(std::multimap<float, std::pair<vkb::scene_graph::Node<bindingType> *, SubMeshType *>> &opaque_nodes,
 	                      std::multimap<float, std::pair<vkb::scene_graph::Node<bindingType> *, SubMeshType *>> &transparent_nodes);
@@ -146,10 +187,53 @@ class GeometrySubpass : public vkb::rendering::Subpass<bindingType>
 	virtual void                update_uniform(vkb::core::CommandBuffer<bindingType> &command_buffer, vkb::scene_graph::Node<bindingType> &node, size_t thread_index);
 
   protected:
+	struct TextureBinding
+	{
+		uint32_t                       binding;
+		vkb::core::HPPImageView const *image_view;
+		vkb::core::HPPSampler const   *sampler;
+	};
+
+	struct VertexBufferBinding
+	{
+		uint32_t                                                        location;
+		std::vector<std::reference_wrapper<const vkb::core::BufferCpp>> buffers;
+	};
+
+	/**
+	 * @brief The state needed to draw a submesh, resolved from the shader reflection the first time the submesh is drawn by this subpass
+	 *        It is compiled again if the shader variant of the submesh changes, other changes need invalidate_draw_records()
+	 */
+	struct DrawRecord
+	{
+		size_t                              shader_variant_id;
+		vkb::core::HPPPipelineLayout       *pipeline_layout;
+		bool                                push_constants;
+		std::vector<TextureBinding>         textures;
+		vkb::rendering::VertexInputStateCpp vertex_input_state;
+		std::vector<VertexBufferBinding>    vertex_buffers;
+		std::vector<vk::DeviceSize>         vertex_buffer_offsets{0};
+	};
+
+  protected:
+	DrawRecord const                                           &get_draw_record(vkb::core::CommandBufferCpp &command_buffer, vkb::scene_graph::components::HPPSubMesh &sub_mesh);
 	std::vector<vkb::scene_graph::components::HPPMesh *> const &get_meshes_impl() const;
 
   private:
+	/**
+	 * @brief A draw of a submesh of a mesh instance, ordered by its sort key
+	 */
+	struct DrawPacket
+	{
+		uint64_t                                  key;
+		vkb::scene_graph::NodeCpp                *node;
+		vkb::scene_graph::components::HPPSubMesh *sub_mesh;
+	};
+
+  private:
+	void                          cull_instances(bool update_culling_stats);
 	void                          draw_impl(vkb::core::CommandBufferCpp &command_buffer);
+	void                          draw_range_impl(vkb::core::CommandBufferCpp &command_buffer, size_t first_draw, size_t last_draw, uint32_t draw_thread_index);
 	void                          draw_submesh_impl(vkb::core::CommandBufferCpp              &command_buffer,
 	                                                vkb::scene_graph::components::HPPSubMesh &sub_mesh,
 	                                                vk::FrontFace                             front_face = vk::FrontFace::eCounterClockwise);
@@ -159,6 +243,7 @@ class GeometrySubpass : public vkb::rendering::Subpass<bindingType>
 	                                                           const std::vector<vkb::core::HPPShaderModule *> &shader_modules);
 	void                          prepare_pipeline_state_impl(vkb::core::CommandBufferCpp &command_buffer, vk::FrontFace front_face, bool double_sided_material);
 	virtual void                  prepare_push_constants_impl(vkb::core::CommandBufferCpp &command_buffer, vkb::scene_graph::components::HPPSubMesh &sub_mesh);
+	void                          sort_draws();
 	void                          update_uniform_impl(vkb::core::CommandBufferCpp &command_buffer, vkb::scene_graph::NodeCpp &node, size_t thread_index);
 
   private:
@@ -166,7 +251,24 @@ class GeometrySubpass : public vkb::rendering::Subpass<bindingType>
 	vkb::sg::Camera                                     &camera;
 	std::vector<vkb::scene_graph::components::HPPMesh *> meshes;
 	vkb::scene_graph::SceneCpp                          *scene;
-	uint32_t                                             thread_index = 0;
+	uint32_t                                             thread_index        = 0;
+	bool                                                 frustum_culling     = true;
+	uint32_t                                             min_draws_per_chunk = 64;
+	uint32_t                                             draw_chunk_count    = 1;
+
+	/// World space bounds of the mesh instances, kept across frames to avoid reallocating them
+	vkb::PackedBounds                                                                          instance_bounds;
+	std::vector<std::pair<vkb::scene_graph::components::HPPMesh *, vkb::scene_graph::NodeCpp *>> instances;
+	std::vector<uint8_t>                                                                       instance_visibility;
+
+	/// Draws of the current frame, kept across frames so that building and sorting them does not allocate
+	std::vector<DrawPacket> opaque_draws;
+	std::vector<DrawPacket> transparent_draws;
+	std::vector<DrawPacket> draw_scratch;
+
+	/// Draw records are compiled lazily, possibly by several chunks recorded at once
+	std::mutex                                                                       draw_records_mutex;
+	std::unordered_map<vkb::scene_graph::components::HPPSubMesh const *, DrawRecord> draw_records;
 };
 
 using GeometrySubpassC   = GeometrySubpass<vkb::BindingType::C>;
@@ -209,38 +311,80 @@ inline void GeometrySubpass<bindingType>::draw(vkb::core::CommandBuffer<bindingT
 template <vkb::BindingType bindingType>
 inline void GeometrySubpass<bindingType>::draw_impl(vkb::core::CommandBufferCpp &command_buffer)
 {
-	std::multimap<float, std::pair<vkb::scene_graph::NodeCpp *, vkb::scene_graph::components::HPPSubMesh *>> opaque_nodes;
-	std::multimap<float, std::pair<vkb::scene_graph::NodeCpp *, vkb::scene_graph::components::HPPSubMesh *>> transparent_nodes;
+	sort_draws();
+
+	draw_range_impl(command_buffer, 0, opaque_draws.size() + transparent_draws.size(), thread_index);
+}
+
+template <vkb::BindingType bindingType>
+inline uint32_t GeometrySubpass<bindingType>::prepare_draw_chunks(uint32_t max_chunk_count)
+{
+	sort_draws();
 
-	get_sorted_nodes_impl(opaque_nodes, transparent_nodes);
+	size_t draw_count = opaque_draws.size() + transparent_draws.size();
+	draw_chunk_count  = static_cast<uint32_t>(std::clamp<size_t>(draw_count / std::max(min_draws_per_chunk, 1u), 1, std::max(max_chunk_count, 1u)));
 
-	// Draw opaque objects in front-to-back order
+	return draw_chunk_count;
+}
+
+template <vkb::BindingType bindingType>
+inline void GeometrySubpass<bindingType>::draw_chunk(vkb::core::CommandBuffer<bindingType> &command_buffer, uint32_t chunk_index)
+{
+	assert(chunk_index < draw_chunk_count && "Chunk index is out of bounds");
+
+	// Split the draws evenly, the opaque and transparent draws of a chunk keep their relative order
+	size_t draw_count = opaque_draws.size() + transparent_draws.size();
+	size_t first_draw = draw_count * chunk_index / draw_chunk_count;
+	size_t last_draw  = draw_count * (chunk_index + 1) / draw_chunk_count;
+
+	if constexpr (bindingType == vkb::BindingType::Cpp)
+	{
+		draw_range_impl(command_buffer, first_draw, last_draw, chunk_index);
+	}
+	else
+	{
+		draw_range_impl(reinterpret_cast<vkb::core::CommandBufferCpp &>(command_buffer), first_draw, last_draw, chunk_index);
+	}
+}
+
+template <vkb::BindingType bindingType>
+inline void GeometrySubpass<bindingType>::draw_range_impl(vkb::core::CommandBufferCpp &command_buffer, size_t first_draw, size_t last_draw, uint32_t draw_thread_index)
+{
+	size_t opaque_end = std::min(last_draw, opaque_draws.size());
+
+	// Draw opaque objects grouped by pipeline state and material, in front-to-back order within a group
+	if (first_draw < opaque_end)
 	{
 		vkb::core::HPPScopedDebugLabel opaque_debug_label{command_buffer, "Opaque objects"};
 
-		for (auto node_it = opaque_nodes.begin(); node_it != opaque_nodes.end(); node_it++)
+		for (size_t i = first_draw; i < opaque_end; i++)
 		{
+			auto &draw = opaque_draws[i];
+
 			if constexpr (bindingType == vkb::BindingType::Cpp)
 			{
-				update_uniform(command_buffer, *node_it->second.first, thread_index);
+				update_uniform(command_buffer, *draw.node, draw_thread_index);
 			}
 			else
 			{
 				update_uniform(reinterpret_cast<vkb::core::CommandBufferC &>(command_buffer),
-				               reinterpret_cast<vkb::scene_graph::NodeC &>(*node_it->second.first),
-				               thread_index);
+				               reinterpret_cast<vkb::scene_graph::NodeC &>(*draw.node),
+				               draw_thread_index);
 			}
 
 			// Invert the front face if the mesh was flipped
-			const auto   &scale      = node_it->second.first->get_transform().get_scale();
+			const auto   &scale      = draw.node->get_transform().get_scale();
 			bool          flipped    = scale.x * scale.y * scale.z < 0;
 			vk::FrontFace front_face = flipped ? vk::FrontFace::eClockwise : vk::FrontFace::eCounterClockwise;
 
-			draw_submesh_impl(command_buffer, *node_it->second.second, front_face);
+			draw_submesh_impl(command_buffer, *draw.sub_mesh, front_face);
 		}
 	}
 
-	if (!transparent_nodes.empty())
+	size_t transparent_begin = std::max(first_draw, opaque_draws.size()) - opaque_draws.size();
+	size_t transparent_end   = std::max(last_draw, opaque_draws.size()) - opaque_draws.size();
+
+	if (transparent_begin < transparent_end)
 	{
 		// Enable alpha blending
 		vkb::rendering::ColorBlendAttachmentStateCpp color_blend_attachment{.blend_enable           = true,
@@ -258,19 +402,21 @@ inline void GeometrySubpass<bindingType>::draw_impl(vkb::core::CommandBufferCpp
 		{
 			vkb::core::HPPScopedDebugLabel transparent_debug_label{command_buffer, "Transparent objects"};
 
-			for (auto node_it = transparent_nodes.rbegin(); node_it != transparent_nodes.rend(); node_it++)
+			for (size_t i = transparent_begin; i < transparent_end; i++)
 			{
+				auto &draw = transparent_draws[i];
+
 				if constexpr (bindingType == vkb::BindingType::Cpp)
 				{
-					update_uniform(command_buffer, *node_it->second.first, thread_index);
+					update_uniform(command_buffer, *draw.node, draw_thread_index);
 				}
 				else
 				{
 					update_uniform(reinterpret_cast<vkb::core::CommandBufferC &>(command_buffer),
-					               reinterpret_cast<vkb::scene_graph::NodeC &>(*node_it->second.first),
-					               thread_index);
+					               reinterpret_cast<vkb::scene_graph::NodeC &>(*draw.node),
+					               draw_thread_index);
 				}
-				draw_submesh_impl(command_buffer, *node_it->second.second);
+				draw_submesh_impl(command_buffer, *draw.sub_mesh);
 			}
 		}
 	}
@@ -279,6 +425,9 @@ inline void GeometrySubpass<bindingType>::draw_impl(vkb::core::CommandBufferCpp
 template <vkb::BindingType bindingType>
 inline void GeometrySubpass<bindingType>::prepare()
 {
+	// Subclasses may choose another pipeline layout when prepared again
+	invalidate_draw_records();
+
 	// Build all shader variance upfront
 	auto &resource_cache = this->get_render_context_impl().get_device().get_resource_cache();
 	for (auto &mesh : meshes)
@@ -298,6 +447,68 @@ inline void GeometrySubpass<bindingType>::set_thread_index(uint32_t index)
 	thread_index = index;
 }
 
+template <vkb::BindingType bindingType>
+inline void GeometrySubpass<bindingType>::set_min_draws_per_chunk(uint32_t count)
+{
+	min_draws_per_chunk = count;
+}
+
+template <vkb::BindingType bindingType>
+inline void GeometrySubpass<bindingType>::sort_draws()
+{
+	auto camera_position = glm::vec3(camera.get_node()->get_transform().get_world_matrix()[3]);
+
+	cull_instances(true);
+
+	opaque_draws.clear();
+	transparent_draws.clear();
+
+	for (size_t i = 0; i < instances.size(); i++)
+	{
+		if (!instance_visibility[i])
+		{
+			continue;
+		}
+
+		auto [mesh, node] = instances[i];
+
+		// Distances are never negative, so their bits compare as unsigned integers in the same order as the floats
+		float    distance   = glm::length(camera_position - instance_bounds.get_center(i));
+		uint32_t depth_bits = std::bit_cast<uint32_t>(distance);
+
+		const auto &scale   = node->get_transform().get_scale();
+		uint64_t    flipped = scale.x * scale.y * scale.z < 0;
+
+		for (auto &sub_mesh : mesh->get_submeshes())
+		{
+			auto *material = sub_mesh->get_material();
+
+			if (material->get_alpha_mode() == sg::AlphaMode::Blend)
+			{
+				// Back-to-front
+				transparent_draws.push_back({std::numeric_limits<uint32_t>::max() - depth_bits, node, sub_mesh});
+			}
+			else
+			{
+				// From the most to the least significant bits: alpha tested, shader variant, rasterization state, material and depth,
+				// so that draws sharing a pipeline and then a material are consecutive, front-to-back within a material
+				uint64_t alpha_mask   = material->get_alpha_mode() == sg::AlphaMode::Mask;
+				uint64_t variant      = fold_to_bits(reinterpret_cast<vkb::ShaderVariant const &>(sub_mesh->get_shader_variant()).get_id(), 16);
+				uint64_t double_sided = material->is_double_sided();
+				uint64_t material_id  = fold_to_bits(reinterpret_cast<uintptr_t>(material), 20);
+
+				uint64_t key = (alpha_mask << 63) | (variant << 47) | (double_sided << 46) | (flipped << 45) | (material_id << 25) | (depth_bits >> 6);
+
+				opaque_draws.push_back({key, node, sub_mesh});
+			}
+		}
+	}
+
+	auto get_key = [](const DrawPacket &draw) { return draw.key; };
+	radix_sort(opaque_draws, draw_scratch, get_key);
+	radix_sort(transparent_draws, draw_scratch, get_key);
+}
+
 template <vkb::BindingType bindingType>
 inline void
     GeometrySubpass<bindingType>::draw_submesh(vkb::core::CommandBuffer<bindingType> &command_buffer, SubMeshType &sub_mesh, FrontFaceType front_face)
@@ -323,14 +534,82 @@ inline void GeometrySubpass<bindingType>::draw_submesh_command(vkb::core::Comman
 		// Bind index buffer of submesh
 		command_buffer.bind_index_buffer(sub_mesh.get_index_buffer(), sub_mesh.get_index_offset(), sub_mesh.get_index_type());
 
-		// Draw submesh using indexed data
-		command_buffer.draw_indexed(sub_mesh.get_vertex_indices(), 1, 0, 0, 0);
+		// Draw submesh using indexed data, offset into the index and vertex buffers it may share with other submeshes
+		command_buffer.draw_indexed(sub_mesh.get_vertex_indices(), 1, sub_mesh.get_first_index(), sub_mesh.get_vertex_offset(), 0);
 	}
 	else
 	{
 		// Draw submesh using vertices only
-		command_buffer.draw(sub_mesh.get_vertices_count(), 1, 0, 0);
+		command_buffer.draw(sub_mesh.get_vertices_count(), 1, static_cast<uint32_t>(sub_mesh.get_vertex_offset()), 0);
+	}
+}
+
+template <vkb::BindingType bindingType>
+inline typename GeometrySubpass<bindingType>::DrawRecord const &
+    GeometrySubpass<bindingType>::get_draw_record(vkb::core::CommandBufferCpp &command_buffer, vkb::scene_graph::components::HPPSubMesh &sub_mesh)
+{
+	size_t shader_variant_id = reinterpret_cast<vkb::ShaderVariant const &>(sub_mesh.get_shader_variant()).get_id();
+
+	std::lock_guard<std::mutex> guard{draw_records_mutex};
+
+	auto record_it = draw_records.find(&sub_mesh);
+	if (record_it != draw_records.end() && record_it->second.shader_variant_id == shader_variant_id)
+	{
+		return record_it->second;
+	}
+
+	DrawRecord record{.shader_variant_id = shader_variant_id};
+
+	auto &resource_cache = command_buffer.get_device().get_resource_cache();
+	auto &vert_shader_module =
+	    resource_cache.request_shader_module(vk::ShaderStageFlagBits::eVertex, this->get_vertex_shader_impl(), sub_mesh.get_shader_variant());
+	auto &frag_shader_module =
+	    resource_cache.request_shader_module(vk::ShaderStageFlagBits::eFragment, this->get_fragment_shader_impl(), sub_mesh.get_shader_variant());
+
+	auto &pipeline_layout = reinterpret_cast<vkb::core::HPPPipelineLayout &>(
+	    prepare_pipeline_layout(reinterpret_cast<vkb::core::CommandBuffer<bindingType> &>(command_buffer),
+	                            {reinterpret_cast<ShaderModuleType *>(&vert_shader_module), reinterpret_cast<ShaderModuleType *>(&frag_shader_module)}));
+
+	record.pipeline_layout = &pipeline_layout;
+	record.push_constants  = static_cast<bool>(pipeline_layout.get_push_constant_range_stage(sizeof(PBRMaterialUniform)));
+
+	vkb::core::HPPDescriptorSetLayout const &descriptor_set_layout = pipeline_layout.get_descriptor_set_layout(0);
+
+	for (auto const &texture : sub_mesh.get_material()->get_textures())
+	{
+		if (auto layout_binding = descriptor_set_layout.get_layout_binding(texture.first))
+		{
+			record.textures.push_back({.binding    = layout_binding->binding,
+			                           .image_view = &texture.second->get_image()->get_vk_image_view(),
+			                           .sampler    = &texture.second->get_sampler()->get_core_sampler()});
+		}
+	}
+
+	auto vertex_input_resources = pipeline_layout.get_resources(vkb::core::HPPShaderResourceType::Input, vk::ShaderStageFlagBits::eVertex);
+
+	for (auto &input_resource : vertex_input_resources)
+	{
+		vkb::scene_graph::components::HPPVertexAttribute attribute;
+		if (!sub_mesh.get_attribute(input_resource.name, attribute))
+		{
+			continue;
+		}
+
+		record.vertex_input_state.attributes.push_back(
+		    {.location = input_resource.location, .binding = input_resource.location, .format = attribute.format, .offset = attribute.offset});
+		record.vertex_input_state.bindings.push_back({.binding = input_resource.location, .stride = attribute.stride});
 	}
+
+	// Find submesh vertex buffers matching the shader input attribute names
+	for (auto &input_resource : vertex_input_resources)
+	{
+		if (auto const *buffer_ptr = sub_mesh.find_vertex_buffer(input_resource.name))
+		{
+			record.vertex_buffers.push_back({.location = input_resource.location, .buffers = {std::cref(*buffer_ptr)}});
+		}
+	}
+
+	return draw_records.insert_or_assign(&sub_mesh, std::move(record)).first->second;
 }
 
 template <vkb::BindingType bindingType>
@@ -396,11 +675,11 @@ inline void
 }
 
 template <vkb::BindingType bindingType>
-inline void GeometrySubpass<bindingType>::get_sorted_nodes_impl(
-    std::multimap<float, std::pair<vkb::scene_graph::NodeCpp *, vkb::scene_graph::components::HPPSubMesh *>> &opaque_nodes,
-    std::multimap<float, std::pair<vkb::scene_graph::NodeCpp *, vkb::scene_graph::components::HPPSubMesh *>> &transparent_nodes)
+inline void GeometrySubpass<bindingType>::cull_instances(bool update_culling_stats)
 {
-	auto camera_transform = camera.get_node()->get_transform().get_world_matrix();
+	// Gather the world space bounds of all mesh instances, so that they are culled in a single pass
+	instance_bounds.clear();
+	instances.clear();
 
 	for (auto &mesh : meshes)
 	{
@@ -413,23 +692,96 @@ inline void GeometrySubpass<bindingType>::get_sorted_nodes_impl(
 			sg::AABB world_bounds{mesh_bounds.get_min(), mesh_bounds.get_max()};
 			world_bounds.transform(node_transform);
 
-			float distance = glm::length(glm::vec3(camera_transform[3]) - world_bounds.get_center());
+			instance_bounds.push_back(world_bounds.get_min(), world_bounds.get_max());
+			instances.emplace_back(mesh, node);
+		}
+	}
 
-			for (auto &sub_mesh : mesh->get_submeshes())
+	if (frustum_culling)
+	{
+		Frustum frustum;
+		frustum.update(camera.get_pre_rotation() * vkb::rendering::vulkan_style_projection(camera.get_projection()) * camera.get_view());
+		frustum.check_boxes(instance_bounds, instance_visibility);
+	}
+	else
+	{
+		instance_visibility.assign(instances.size(), 1);
+	}
+
+	if (!update_culling_stats)
+	{
+		return;
+	}
+
+	uint64_t visible_count = 0;
+	uint64_t culled_count  = 0;
+
+	for (size_t i = 0; i < instances.size(); i++)
+	{
+		auto submesh_count = instances[i].first->get_submeshes().size();
+		if (instance_visibility[i])
+		{
+			visible_count += submesh_count;
+		}
+		else
+		{
+			culled_count += submesh_count;
+		}
+	}
+
+	auto &culling_stats = this->get_render_context_impl().get_culling_stats();
+	culling_stats.visible.fetch_add(visible_count, std::memory_order_relaxed);
+	culling_stats.culled.fetch_add(culled_count, std::memory_order_relaxed);
+}
+
+template <vkb::BindingType bindingType>
+inline void GeometrySubpass<bindingType>::get_sorted_nodes_impl(
+    std::multimap<float, std::pair<vkb::scene_graph::NodeCpp *, vkb::scene_graph::components::HPPSubMesh *>> &opaque_nodes,
+    std::multimap<float, std::pair<vkb::scene_graph::NodeCpp *, vkb::scene_graph::components::HPPSubMesh *>> &transparent_nodes)
+{
+	auto camera_transform = camera.get_node()->get_transform().get_world_matrix();
+
+	// The frame's culling stats are counted by sort_draws, subclasses may call both in a frame
+	cull_instances(false);
+
+	for (size_t i = 0; i < instances.size(); i++)
+	{
+		if (!instance_visibility[i])
+		{
+			continue;
+		}
+
+		auto [mesh, node] = instances[i];
+
+		float distance = glm::length(glm::vec3(camera_transform[3]) - instance_bounds.get_center(i));
+
+		for (auto &sub_mesh : mesh->get_submeshes())
+		{
+			if (sub_mesh->get_material()->get_alpha_mode() == sg::AlphaMode::Blend)
 			{
-				if (sub_mesh->get_material()->get_alpha_mode() == sg::AlphaMode::Blend)
-				{
-					transparent_nodes.emplace(distance, std::make_pair(node, sub_mesh));
-				}
-				else
-				{
-					opaque_nodes.emplace(distance, std::make_pair(node, sub_mesh));
-				}
+				transparent_nodes.emplace(distance, std::make_pair(node, sub_mesh));
+			}
+			else
+			{
+				opaque_nodes.emplace(distance, std::make_pair(node, sub_mesh));
 			}
 		}
 	}
 }
 
+template <vkb::BindingType bindingType>
+inline void GeometrySubpass<bindingType>::set_frustum_culling(bool enabled)
+{
+	frustum_culling = enabled;
+}
+
+template <vkb::BindingType bindingType>
+inline void GeometrySubpass<bindingType>::invalidate_draw_records()
+{
+	std::lock_guard<std::mutex> guard{draw_records_mutex};
+	draw_records.clear();
+}
+
 template <vkb::BindingType bindingType>
 inline uint32_t GeometrySubpass<bindingType>::get_thread_index() const
 {
@@ -509,19 +861,11 @@ inline void GeometrySubpass<bindingType>::draw_submesh_impl(vkb::core::CommandBu
 	vkb::rendering::MultisampleStateCpp multisample_state{.rasterization_samples = this->get_sample_count_impl()};
 	command_buffer.set_multisample_state(multisample_state);
 
-	auto &resource_cache = command_buffer.get_device().get_resource_cache();
-	auto &vert_shader_module =
-	    resource_cache.request_shader_module(vk::ShaderStageFlagBits::eVertex, this->get_vertex_shader_impl(), sub_mesh.get_shader_variant());
-	auto &frag_shader_module =
-	    resource_cache.request_shader_module(vk::ShaderStageFlagBits::eFragment, this->get_fragment_shader_impl(), sub_mesh.get_shader_variant());
-
-	auto &pipeline_layout = reinterpret_cast<vkb::core::HPPPipelineLayout &>(
-	    prepare_pipeline_layout(reinterpret_cast<vkb::core::CommandBuffer<bindingType> &>(command_buffer),
-	                            {reinterpret_cast<ShaderModuleType *>(&vert_shader_module), reinterpret_cast<ShaderModuleType *>(&frag_shader_module)}));
+	auto const &record = get_draw_record(command_buffer, sub_mesh);
 
-	command_buffer.bind_pipeline_layout(pipeline_layout);
+	command_buffer.bind_pipeline_layout(*record.pipeline_layout);
 
-	if (pipeline_layout.get_push_constant_range_stage(sizeof(PBRMaterialUniform)))
+	if (record.push_constants)
 	{
 		if constexpr (bindingType == BindingType::Cpp)
 		{
@@ -533,49 +877,17 @@ inline void GeometrySubpass<bindingType>::draw_submesh_impl(vkb::core::CommandBu
 		}
 	}
 
-	vkb::core::HPPDescriptorSetLayout const &descriptor_set_layout = pipeline_layout.get_descriptor_set_layout(0);
-
-	for (auto const &texture : sub_mesh.get_material()->get_textures())
+	for (auto const &texture : record.textures)
 	{
-		if (auto layout_binding = descriptor_set_layout.get_layout_binding(texture.first))
-		{
-			command_buffer.bind_image(
-			    texture.second->get_image()->get_vk_image_view(), texture.second->get_sampler()->get_core_sampler(), 0, layout_binding->binding, 0);
-		}
+		command_buffer.bind_image(*texture.image_view, *texture.sampler, 0, texture.binding, 0);
 	}
 
-	auto vertex_input_resources = pipeline_layout.get_resources(vkb::core::HPPShaderResourceType::Input, vk::ShaderStageFlagBits::eVertex);
-
-	vkb::rendering::VertexInputStateCpp vertex_input_state;
+	command_buffer.set_vertex_input_state(record.vertex_input_state);
 
-	for (auto &input_resource : vertex_input_resources)
+	for (auto const &vertex_buffer : record.vertex_buffers)
 	{
-		vkb::scene_graph::components::HPPVertexAttribute attribute;
-		if (!sub_mesh.get_attribute(input_resource.name, attribute))
-		{
-			continue;
-		}
-
-		vertex_input_state.attributes.push_back(
-		    {.location = input_resource.location, .binding = input_resource.location, .format = attribute.format, .offset = attribute.offset});
-		vertex_input_state.bindings.push_back({.binding = input_resource.location, .stride = attribute.stride});
-	}
-
-	command_buffer.set_vertex_input_state(vertex_input_state);
-
-	// Find submesh vertex buffers matching the shader input attribute names
-	for (auto &input_resource : vertex_input_resources)
-	{
-		auto const *buffer_ptr = sub_mesh.find_vertex_buffer(input_resource.name);
-
-		if (buffer_ptr)
-		{
-			std::vector<std::reference_wrapper<const vkb::core::BufferCpp>> buffers;
-			buffers.emplace_back(std::ref(*buffer_ptr));
-
-			// Bind vertex buffers only for the attribute locations defined
-			command_buffer.bind_vertex_buffers(input_resource.location, std::move(buffers), {0});
-		}
+		// Bind vertex buffers only for the attribute locations defined
+		command_buffer.bind_vertex_buffers(vertex_buffer.location, vertex_buffer.buffers, record.vertex_buffer_offsets);
 	}
 
 	if constexpr (bindingType == BindingType::Cpp)
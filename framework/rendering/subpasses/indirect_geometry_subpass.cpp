@@ -0,0 +1,31 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "indirect_geometry_subpass.h"
+
+namespace vkb
+{
+namespace rendering
+{
+namespace subpasses
+{
+// Compiled once here, so that the subpass is built with the framework even if no sample of the build uses it
+template class IndirectGeometrySubpass<vkb::BindingType::C>;
+template class IndirectGeometrySubpass<vkb::BindingType::Cpp>;
+}        // namespace subpasses
+}        // namespace rendering
+}        // namespace vkb
@@ -0,0 +1,666 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "rendering/subpasses/geometry_subpass.h"
+#include <algorithm>
+#include <array>
+#include <map>
+#include <tuple>
+
+namespace vkb
+{
+namespace rendering
+{
+namespace subpasses
+{
+/**
+ * @brief This subpass renders a Scene like GeometrySubpass, but culls the mesh instances and issues their draws on the GPU
+ *
+ * The draws of the opaque indexed submeshes are uploaded once, grouped in batches sharing a material, a shader variant,
+ * geometry buffers and a rasterization state. Every frame a compute pass tests the bounds of the instances against the camera
+ * frustum and writes the draw commands of the visible ones into an indirect buffer, which is then drawn with one indirect draw
+ * per batch, so that the CPU cost of a frame does not depend on the number of instances.
+ * Packing the geometry of the scene into shared buffers, see GLTFLoader::set_packed_geometry(), lets different meshes share a batch.
+ *
+ * Transparent and non-indexed submeshes are still drawn from the CPU, as GeometrySubpass does.
+ *
+ * The vertex shader reads the model matrix of the instance from the InstanceTransforms storage buffer of set 0, indexed by
+ * gl_InstanceIndex, as done by indirect_geometry/geometry.vert. Samples using the subpass compile indirect_geometry/geometry.vert
+ * and indirect_geometry/cull.comp with their shaders.
+ * record_culling() must be called on the command buffer before beginning the render pass of this subpass.
+ *
+ * The drawIndirectFirstInstance feature must be enabled, as the culling shader passes the index of each instance as
+ * the first instance of its draw command. Without the multiDrawIndirect feature every draw command of a batch is issued
+ * by its own indirect draw, and set_draw_indirect_count() requires the drawIndirectCount feature. Samples check these
+ * features in request_gpu_features() and fall back to GeometrySubpass when they are missing.
+ */
+template <vkb::BindingType bindingType>
+class IndirectGeometrySubpass : public GeometrySubpass<bindingType>
+{
+  public:
+	using FrontFaceType    = typename GeometrySubpass<bindingType>::FrontFaceType;
+	using ShaderSourceType = typename GeometrySubpass<bindingType>::ShaderSourceType;
+	using SubMeshType      = typename GeometrySubpass<bindingType>::SubMeshType;
+
+	/// Binding of the InstanceTransforms storage buffer in set 0 of the vertex shader
+	static constexpr uint32_t instance_transforms_binding = 2;
+
+  public:
+	/**
+	 * @brief Constructs a subpass drawing the opaque geometry of a scene with indirect draws
+	 * @param render_context Render context
+	 * @param vertex_shader Vertex shader source, reading the model matrices from the InstanceTransforms buffer
+	 * @param fragment_shader Fragment shader source
+	 * @param scene Scene to render on this subpass
+	 * @param camera Camera used to look at the scene
+	 */
+	IndirectGeometrySubpass(vkb::rendering::RenderContext<bindingType> &render_context,
+	                        ShaderSourceType                          &&vertex_shader,
+	                        ShaderSourceType                          &&fragment_shader,
+	                        vkb::scene_graph::Scene<bindingType>       &scene,
+	                        sg::Camera                                 &camera);
+
+	virtual ~IndirectGeometrySubpass() = default;
+
+	/**
+	 * @brief Record draw commands
+	 */
+	virtual void draw(vkb::core::CommandBuffer<bindingType> &command_buffer) override;
+
+	/**
+	 * @brief The draws are issued by a handful of indirect draws, so they are never split into chunks
+	 */
+	virtual uint32_t prepare_draw_chunks(uint32_t max_chunk_count) override;
+
+	/**
+	 * @brief Records the whole subpass, as draw() does
+	 */
+	virtual void draw_chunk(vkb::core::CommandBuffer<bindingType> &command_buffer, uint32_t chunk_index) override;
+
+	/**
+	 * @brief Records the compute pass culling the instances and writing the indirect draw commands of the frame
+	 *        It must be recorded outside of a render pass, before the render pass of this subpass
+	 */
+	void record_culling(vkb::core::CommandBuffer<bindingType> &command_buffer);
+
+	/**
+	 * @brief Compacts the visible draws of each batch and lets the GPU read their count, with vkCmdDrawIndexedIndirectCount
+	 *        The drawIndirectCount feature of Vulkan 1.2, or the VK_KHR_draw_indirect_count extension, must be enabled, disabled by default
+	 */
+	void set_draw_indirect_count(bool enabled);
+
+	/**
+	 * @brief Uploads the model matrices of the instances every frame instead of once, for scenes with moving nodes, disabled by default
+	 */
+	void set_dynamic_transforms(bool enabled);
+
+  protected:
+	/**
+	 * @brief Issues the indirect draw of the batch being drawn, or the draw of a single submesh instance
+	 */
+	virtual void draw_submesh_command(vkb::core::CommandBuffer<bindingType> &command_buffer, SubMeshType &sub_mesh) override;
+
+  private:
+	/**
+	 * @brief A draw of a submesh of a mesh instance, as read by the culling shader
+	 */
+	struct IndirectDraw
+	{
+		uint32_t index_count;
+		uint32_t first_index;
+		int32_t  vertex_offset;
+		uint32_t instance;
+		uint32_t batch;
+		uint32_t batch_first;        // Index of the first command of the batch in the indirect buffer
+	};
+
+	struct InstanceBounds
+	{
+		glm::vec4 center;
+		glm::vec4 extent;
+	};
+
+	struct CullUniform
+	{
+		std::array<glm::vec4, 6> planes;
+		uint32_t                 draw_count;
+		uint32_t                 compact;
+	};
+
+	/**
+	 * @brief Draws sharing all the state bound for a submesh, drawn with a single indirect draw
+	 */
+	struct Batch
+	{
+		vkb::scene_graph::components::HPPSubMesh *sub_mesh;        // The state of the batch is the state of any of its submeshes
+		bool                                      flipped;
+		uint32_t                                  first_command;
+		uint32_t                                  command_count;
+	};
+
+	/**
+	 * @brief A submesh of a mesh instance drawn from the CPU
+	 */
+	struct InstanceDraw
+	{
+		float                                     distance;
+		uint32_t                                  instance;
+		vkb::scene_graph::components::HPPSubMesh *sub_mesh;
+	};
+
+	/// Material, shader variant, index buffer, index offset, index type, position buffer and front face shared by the draws of a batch
+	using BatchKey = std::tuple<void const *, size_t, void const *, vk::DeviceSize, vk::IndexType, void const *, bool>;
+
+	static constexpr uint32_t no_batch = ~0u;
+
+  private:
+	void                  build_batches(vkb::core::CommandBufferCpp &command_buffer);
+	void                  draw_impl(vkb::core::CommandBufferCpp &command_buffer);
+	void                  draw_instance(vkb::core::CommandBufferCpp &command_buffer, InstanceDraw const &draw);
+	void                  draw_submesh_cpp(vkb::core::CommandBufferCpp &command_buffer, vkb::scene_graph::components::HPPSubMesh &sub_mesh, vk::FrontFace front_face);
+	vkb::core::BufferCpp &get_transform_buffer();
+	glm::mat4             get_view_proj();
+	void                  record_culling_impl(vkb::core::CommandBufferCpp &command_buffer);
+	void                  update_global_uniform(vkb::core::CommandBufferCpp &command_buffer);
+
+  private:
+	sg::Camera                &camera;
+	vkb::core::HPPShaderSource cull_shader{"indirect_geometry/cull.comp.spv"};
+	bool                       batches_built       = false;
+	bool                       draw_indirect_count = false;
+	bool                       dynamic_transforms  = false;
+	bool                       multi_draw_indirect = false;
+	uint32_t                   indirect_draw_count = 0;
+
+	/// What draw_submesh_command() draws: the batch with this index, or otherwise a single instance of a submesh
+	uint32_t current_batch    = no_batch;
+	uint32_t current_instance = 0;
+
+	std::vector<vkb::scene_graph::NodeCpp *> instance_nodes;
+	std::vector<Batch>                       batches;
+
+	/// Submeshes which cannot be drawn indirectly
+	std::vector<InstanceDraw> cpu_opaque_draws;
+	std::vector<InstanceDraw> cpu_transparent_draws;
+
+	std::unique_ptr<vkb::core::BufferCpp> draw_buffer;
+	std::unique_ptr<vkb::core::BufferCpp> bounds_buffer;
+	std::unique_ptr<vkb::core::BufferCpp> indirect_buffer;
+	std::unique_ptr<vkb::core::BufferCpp> count_buffer;
+
+	/// Model matrices of the instances, a single buffer for static transforms or one per render frame for dynamic ones
+	std::vector<std::unique_ptr<vkb::core::BufferCpp>> transform_buffers;
+	std::vector<glm::mat4>                             transforms;
+};
+
+using IndirectGeometrySubpassC   = IndirectGeometrySubpass<vkb::BindingType::C>;
+using IndirectGeometrySubpassCpp = IndirectGeometrySubpass<vkb::BindingType::Cpp>;
+
+// Member function definitions
+
+template <vkb::BindingType bindingType>
+inline IndirectGeometrySubpass<bindingType>::IndirectGeometrySubpass(vkb::rendering::RenderContext<bindingType> &render_context,
+                                                                     ShaderSourceType                          &&vertex_source,
+                                                                     ShaderSourceType                          &&fragment_source,
+                                                                     vkb::scene_graph::Scene<bindingType>       &scene,
+                                                                     sg::Camera                                 &camera) :
+    GeometrySubpass<bindingType>{render_context, std::move(vertex_source), std::move(fragment_source), scene, camera}, camera{camera}
+{
+}
+
+template <vkb::BindingType bindingType>
+inline void IndirectGeometrySubpass<bindingType>::draw(vkb::core::CommandBuffer<bindingType> &command_buffer)
+{
+	if constexpr (bindingType == vkb::BindingType::Cpp)
+	{
+		draw_impl(command_buffer);
+	}
+	else
+	{
+		draw_impl(reinterpret_cast<vkb::core::CommandBufferCpp &>(command_buffer));
+	}
+}
+
+template <vkb::BindingType bindingType>
+inline uint32_t IndirectGeometrySubpass<bindingType>::prepare_draw_chunks(uint32_t /*max_chunk_count*/)
+{
+	return 1;
+}
+
+template <vkb::BindingType bindingType>
+inline void IndirectGeometrySubpass<bindingType>::draw_chunk(vkb::core::CommandBuffer<bindingType> &command_buffer, uint32_t /*chunk_index*/)
+{
+	draw(command_buffer);
+}
+
+template <vkb::BindingType bindingType>
+inline void IndirectGeometrySubpass<bindingType>::record_culling(vkb::core::CommandBuffer<bindingType> &command_buffer)
+{
+	if constexpr (bindingType == vkb::BindingType::Cpp)
+	{
+		record_culling_impl(command_buffer);
+	}
+	else
+	{
+		record_culling_impl(reinterpret_cast<vkb::core::CommandBufferCpp &>(command_buffer));
+	}
+}
+
+template <vkb::BindingType bindingType>
+inline void IndirectGeometrySubpass<bindingType>::set_draw_indirect_count(bool enabled)
+{
+	draw_indirect_count = enabled;
+}
+
+template <vkb::BindingType bindingType>
+inline void IndirectGeometrySubpass<bindingType>::set_dynamic_transforms(bool enabled)
+{
+	if (dynamic_transforms != enabled)
+	{
+		dynamic_transforms = enabled;
+
+		// The transform buffers are created again for the new mode
+		batches_built = false;
+	}
+}
+
+template <vkb::BindingType bindingType>
+inline void IndirectGeometrySubpass<bindingType>::draw_submesh_command(vkb::core::CommandBuffer<bindingType> &command_buffer, SubMeshType &sub_mesh)
+{
+	auto &cpp_command_buffer = reinterpret_cast<vkb::core::CommandBufferCpp &>(command_buffer);
+	auto &cpp_sub_mesh       = reinterpret_cast<vkb::scene_graph::components::HPPSubMesh &>(sub_mesh);
+
+	if (current_batch == no_batch)
+	{
+		// The first instance selects the model matrix read by the vertex shader
+		if (cpp_sub_mesh.get_vertex_indices() != 0)
+		{
+			cpp_command_buffer.bind_index_buffer(cpp_sub_mesh.get_index_buffer(), cpp_sub_mesh.get_index_offset(), cpp_sub_mesh.get_index_type());
+			cpp_command_buffer.draw_indexed(cpp_sub_mesh.get_vertex_indices(), 1, cpp_sub_mesh.get_first_index(), cpp_sub_mesh.get_vertex_offset(), current_instance);
+		}
+		else
+		{
+			cpp_command_buffer.draw(cpp_sub_mesh.get_vertices_count(), 1, static_cast<uint32_t>(cpp_sub_mesh.get_vertex_offset()), current_instance);
+		}
+		return;
+	}
+
+	auto const &batch = batches[current_batch];
+
+	cpp_command_buffer.bind_index_buffer(cpp_sub_mesh.get_index_buffer(), cpp_sub_mesh.get_index_offset(), cpp_sub_mesh.get_index_type());
+
+	const uint32_t       stride = sizeof(vk::DrawIndexedIndirectCommand);
+	const vk::DeviceSize offset = batch.first_command * static_cast<vk::DeviceSize>(stride);
+
+	if (draw_indirect_count)
+	{
+		cpp_command_buffer.draw_indexed_indirect_count(*indirect_buffer, offset, *count_buffer, current_batch * sizeof(uint32_t), batch.command_count, stride);
+	}
+	else if (multi_draw_indirect)
+	{
+		cpp_command_buffer.draw_indexed_indirect(*indirect_buffer, offset, batch.command_count, stride);
+	}
+	else
+	{
+		// Without the multiDrawIndirect feature, an indirect draw reads a single command
+		for (uint32_t i = 0; i < batch.command_count; i++)
+		{
+			cpp_command_buffer.draw_indexed_indirect(*indirect_buffer, offset + i * stride, 1, stride);
+		}
+	}
+}
+
+template <vkb::BindingType bindingType>
+inline void IndirectGeometrySubpass<bindingType>::build_batches(vkb::core::CommandBufferCpp &command_buffer)
+{
+	instance_nodes.clear();
+	batches.clear();
+	cpu_opaque_draws.clear();
+	cpu_transparent_draws.clear();
+
+	std::map<BatchKey, uint32_t>           batch_indices;
+	std::vector<std::vector<IndirectDraw>> batch_draws;
+	std::vector<InstanceBounds>            instance_bounds;
+
+	for (auto *mesh : this->get_meshes_impl())
+	{
+		const sg::AABB &mesh_bounds = mesh->get_bounds();
+
+		glm::vec3 center = (mesh_bounds.get_min() + mesh_bounds.get_max()) * 0.5f;
+		glm::vec3 extent = (mesh_bounds.get_max() - mesh_bounds.get_min()) * 0.5f;
+
+		for (auto *node : mesh->get_nodes())
+		{
+			uint32_t instance = static_cast<uint32_t>(instance_nodes.size());
+
+			instance_nodes.push_back(node);
+			instance_bounds.push_back({glm::vec4(center, 1.0f), glm::vec4(extent, 0.0f)});
+
+			const auto &scale   = node->get_transform().get_scale();
+			bool        flipped = scale.x * scale.y * scale.z < 0;
+
+			for (auto *sub_mesh : mesh->get_submeshes())
+			{
+				auto const *material = sub_mesh->get_material();
+
+				if (material->get_alpha_mode() == sg::AlphaMode::Blend)
+				{
+					cpu_transparent_draws.push_back({0.0f, instance, sub_mesh});
+					continue;
+				}
+
+				auto const *position_buffer = sub_mesh->find_vertex_buffer("position");
+
+				if (sub_mesh->get_vertex_indices() == 0 || !position_buffer)
+				{
+					cpu_opaque_draws.push_back({0.0f, instance, sub_mesh});
+					continue;
+				}
+
+				BatchKey key{material,
+				             reinterpret_cast<vkb::ShaderVariant const &>(sub_mesh->get_shader_variant()).get_id(),
+				             &sub_mesh->get_index_buffer(),
+				             sub_mesh->get_index_offset(),
+				             sub_mesh->get_index_type(),
+				             position_buffer,
+				             flipped};
+
+				auto [batch_it, inserted] = batch_indices.try_emplace(key, static_cast<uint32_t>(batches.size()));
+				if (inserted)
+				{
+					batches.push_back({.sub_mesh = sub_mesh, .flipped = flipped});
+					batch_draws.emplace_back();
+				}
+
+				batch_draws[batch_it->second].push_back({.index_count   = sub_mesh->get_vertex_indices(),
+				                                         .first_index   = sub_mesh->get_first_index(),
+				                                         .vertex_offset = sub_mesh->get_vertex_offset(),
+				                                         .instance      = instance,
+				                                         .batch         = batch_it->second});
+			}
+		}
+	}
+
+	// Lay the commands of each batch out contiguously
+	std::vector<IndirectDraw> draws;
+	for (uint32_t batch_index = 0; batch_index < batches.size(); batch_index++)
+	{
+		auto &batch         = batches[batch_index];
+		batch.first_command = static_cast<uint32_t>(draws.size());
+		batch.command_count = static_cast<uint32_t>(batch_draws[batch_index].size());
+
+		for (auto &draw : batch_draws[batch_index])
+		{
+			draw.batch_first = batch.first_command;
+			draws.push_back(draw);
+		}
+	}
+
+	indirect_draw_count = static_cast<uint32_t>(draws.size());
+	multi_draw_indirect = command_buffer.get_device().get_gpu().get_requested_features().multiDrawIndirect;
+	batches_built       = true;
+
+	auto &device = command_buffer.get_device();
+
+	transforms.resize(instance_nodes.size());
+	transform_buffers.clear();
+
+	if (!instance_nodes.empty())
+	{
+		size_t buffer_count = dynamic_transforms ? this->get_render_context_impl().get_render_frames().size() : 1;
+		for (size_t i = 0; i < buffer_count; i++)
+		{
+			transform_buffers.push_back(std::make_unique<vkb::core::BufferCpp>(
+			    device, transforms.size() * sizeof(glm::mat4), vk::BufferUsageFlagBits::eStorageBuffer, VMA_MEMORY_USAGE_CPU_TO_GPU));
+		}
+
+		if (!dynamic_transforms)
+		{
+			for (size_t i = 0; i < instance_nodes.size(); i++)
+			{
+				transforms[i] = instance_nodes[i]->get_transform().get_world_matrix();
+			}
+			transform_buffers[0]->update(transforms);
+		}
+	}
+
+	if (draws.empty())
+	{
+		return;
+	}
+
+	draw_buffer = std::make_unique<vkb::core::BufferCpp>(
+	    device, draws.size() * sizeof(IndirectDraw), vk::BufferUsageFlagBits::eStorageBuffer, VMA_MEMORY_USAGE_CPU_TO_GPU);
+	draw_buffer->update(draws);
+
+	bounds_buffer = std::make_unique<vkb::core::BufferCpp>(
+	    device, instance_bounds.size() * sizeof(InstanceBounds), vk::BufferUsageFlagBits::eStorageBuffer, VMA_MEMORY_USAGE_CPU_TO_GPU);
+	bounds_buffer->update(instance_bounds);
+
+	indirect_buffer = std::make_unique<vkb::core::BufferCpp>(device,
+	                                                         draws.size() * sizeof(vk::DrawIndexedIndirectCommand),
+	                                                         vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer,
+	                                                         VMA_MEMORY_USAGE_GPU_ONLY);
+
+	count_buffer = std::make_unique<vkb::core::BufferCpp>(device,
+	                                                      batches.size() * sizeof(uint32_t),
+	                                                      vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer |
+	                                                          vk::BufferUsageFlagBits::eTransferDst,
+	                                                      VMA_MEMORY_USAGE_GPU_ONLY);
+}
+
+template <vkb::BindingType bindingType>
+inline void IndirectGeometrySubpass<bindingType>::draw_impl(vkb::core::CommandBufferCpp &command_buffer)
+{
+	assert(batches_built && "The culling of IndirectGeometrySubpass must be recorded before drawing it");
+
+	if (instance_nodes.empty())
+	{
+		return;
+	}
+
+	update_global_uniform(command_buffer);
+
+	auto &transform_buffer = get_transform_buffer();
+	command_buffer.bind_buffer(transform_buffer, 0, transform_buffer.get_size(), 0, instance_transforms_binding, 0);
+
+	{
+		vkb::core::HPPScopedDebugLabel opaque_debug_label{command_buffer, "Opaque objects"};
+
+		for (current_batch = 0; current_batch < batches.size(); current_batch++)
+		{
+			auto const &batch = batches[current_batch];
+			draw_submesh_cpp(command_buffer, *batch.sub_mesh, batch.flipped ? vk::FrontFace::eClockwise : vk::FrontFace::eCounterClockwise);
+		}
+		current_batch = no_batch;
+
+		for (auto const &draw : cpu_opaque_draws)
+		{
+			draw_instance(command_buffer, draw);
+		}
+	}
+
+	if (!cpu_transparent_draws.empty())
+	{
+		// Back-to-front, by distance of the node origin
+		auto camera_position = glm::vec3(camera.get_node()->get_transform().get_world_matrix()[3]);
+		for (auto &draw : cpu_transparent_draws)
+		{
+			draw.distance = glm::length(camera_position - glm::vec3(instance_nodes[draw.instance]->get_transform().get_world_matrix()[3]));
+		}
+		std::ranges::sort(cpu_transparent_draws, [](InstanceDraw const &lhs, InstanceDraw const &rhs) { return lhs.distance > rhs.distance; });
+
+		// Enable alpha blending
+		vkb::rendering::ColorBlendAttachmentStateCpp color_blend_attachment{.blend_enable           = true,
+		                                                                    .src_color_blend_factor = vk::BlendFactor::eSrcAlpha,
+		                                                                    .dst_color_blend_factor = vk::BlendFactor::eOneMinusSrcAlpha,
+		                                                                    .src_alpha_blend_factor = vk::BlendFactor::eOneMinusSrcAlpha};
+
+		vkb::rendering::ColorBlendStateCpp color_blend_state{};
+		color_blend_state.attachments.assign(this->get_output_attachments().size(), color_blend_attachment);
+
+		command_buffer.set_color_blend_state(color_blend_state);
+		command_buffer.set_depth_stencil_state(this->get_depth_stencil_state_impl());
+
+		vkb::core::HPPScopedDebugLabel transparent_debug_label{command_buffer, "Transparent objects"};
+
+		for (auto const &draw : cpu_transparent_draws)
+		{
+			draw_instance(command_buffer, draw);
+		}
+	}
+}
+
+template <vkb::BindingType bindingType>
+inline void IndirectGeometrySubpass<bindingType>::draw_instance(vkb::core::CommandBufferCpp &command_buffer, InstanceDraw const &draw)
+{
+	// Invert the front face if the mesh was flipped
+	const auto   &scale      = instance_nodes[draw.instance]->get_transform().get_scale();
+	bool          flipped    = scale.x * scale.y * scale.z < 0;
+	vk::FrontFace front_face = flipped ? vk::FrontFace::eClockwise : vk::FrontFace::eCounterClockwise;
+
+	current_instance = draw.instance;
+	draw_submesh_cpp(command_buffer, *draw.sub_mesh, front_face);
+}
+
+template <vkb::BindingType bindingType>
+inline void IndirectGeometrySubpass<bindingType>::draw_submesh_cpp(vkb::core::CommandBufferCpp              &command_buffer,
+                                                                   vkb::scene_graph::components::HPPSubMesh &sub_mesh,
+                                                                   vk::FrontFace                             front_face)
+{
+	if constexpr (bindingType == vkb::BindingType::Cpp)
+	{
+		this->draw_submesh(command_buffer, sub_mesh, front_face);
+	}
+	else
+	{
+		this->draw_submesh(reinterpret_cast<vkb::core::CommandBufferC &>(command_buffer),
+		                   reinterpret_cast<vkb::sg::SubMesh &>(sub_mesh),
+		                   static_cast<VkFrontFace>(front_face));
+	}
+}
+
+template <vkb::BindingType bindingType>
+inline vkb::core::BufferCpp &IndirectGeometrySubpass<bindingType>::get_transform_buffer()
+{
+	return dynamic_transforms ? *transform_buffers[this->get_render_context_impl().get_active_frame_index()] : *transform_buffers[0];
+}
+
+template <vkb::BindingType bindingType>
+inline glm::mat4 IndirectGeometrySubpass<bindingType>::get_view_proj()
+{
+	return camera.get_pre_rotation() * vkb::rendering::vulkan_style_projection(camera.get_projection()) * camera.get_view();
+}
+
+template <vkb::BindingType bindingType>
+inline void IndirectGeometrySubpass<bindingType>::record_culling_impl(vkb::core::CommandBufferCpp &command_buffer)
+{
+	if (!batches_built)
+	{
+		build_batches(command_buffer);
+	}
+
+	if (dynamic_transforms && !instance_nodes.empty())
+	{
+		for (size_t i = 0; i < instance_nodes.size(); i++)
+		{
+			transforms[i] = instance_nodes[i]->get_transform().get_world_matrix();
+		}
+		get_transform_buffer().update(transforms);
+	}
+
+	if (indirect_draw_count == 0)
+	{
+		return;
+	}
+
+	vkb::core::HPPScopedDebugLabel debug_label{command_buffer, "Cull indirect draws"};
+
+	// The indirect draws of the previous frame must be done reading the commands before they are written again
+	vkb::common::HPPBufferMemoryBarrier reuse_barrier{.src_stage_mask  = vk::PipelineStageFlagBits::eDrawIndirect,
+	                                                  .dst_stage_mask  = vk::PipelineStageFlagBits::eComputeShader | vk::PipelineStageFlagBits::eTransfer,
+	                                                  .src_access_mask = {},
+	                                                  .dst_access_mask = vk::AccessFlagBits::eShaderWrite | vk::AccessFlagBits::eTransferWrite};
+	command_buffer.buffer_memory_barrier(*indirect_buffer, 0, VK_WHOLE_SIZE, reuse_barrier);
+	command_buffer.buffer_memory_barrier(*count_buffer, 0, VK_WHOLE_SIZE, reuse_barrier);
+
+	if (draw_indirect_count)
+	{
+		command_buffer.fill_buffer(*count_buffer, 0, VK_WHOLE_SIZE, 0);
+
+		vkb::common::HPPBufferMemoryBarrier clear_barrier{.src_stage_mask  = vk::PipelineStageFlagBits::eTransfer,
+		                                                  .dst_stage_mask  = vk::PipelineStageFlagBits::eComputeShader,
+		                                                  .src_access_mask = vk::AccessFlagBits::eTransferWrite,
+		                                                  .dst_access_mask = vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite};
+		command_buffer.buffer_memory_barrier(*count_buffer, 0, VK_WHOLE_SIZE, clear_barrier);
+	}
+
+	Frustum frustum;
+	frustum.update(get_view_proj());
+
+	CullUniform cull_uniform{.planes = frustum.get_planes(), .draw_count = indirect_draw_count, .compact = draw_indirect_count};
+
+	auto &render_frame = this->get_render_context_impl().get_active_frame();
+	auto  allocation   = render_frame.allocate_buffer(vk::BufferUsageFlagBits::eUniformBuffer, sizeof(CullUniform), this->get_thread_index());
+	allocation.update(cull_uniform);
+
+	auto &resource_cache  = command_buffer.get_device().get_resource_cache();
+	auto &shader_module   = resource_cache.request_shader_module(vk::ShaderStageFlagBits::eCompute, cull_shader);
+	auto &pipeline_layout = resource_cache.request_pipeline_layout({&shader_module});
+
+	command_buffer.bind_pipeline_layout(pipeline_layout);
+
+	auto &transform_buffer = get_transform_buffer();
+
+	command_buffer.bind_buffer(allocation.get_buffer(), allocation.get_offset(), allocation.get_size(), 0, 0, 0);
+	command_buffer.bind_buffer(*draw_buffer, 0, draw_buffer->get_size(), 0, 1, 0);
+	command_buffer.bind_buffer(*bounds_buffer, 0, bounds_buffer->get_size(), 0, 2, 0);
+	command_buffer.bind_buffer(transform_buffer, 0, transform_buffer.get_size(), 0, 3, 0);
+	command_buffer.bind_buffer(*indirect_buffer, 0, indirect_buffer->get_size(), 0, 4, 0);
+	command_buffer.bind_buffer(*count_buffer, 0, count_buffer->get_size(), 0, 5, 0);
+
+	command_buffer.dispatch((indirect_draw_count + 63) / 64, 1, 1);
+
+	vkb::common::HPPBufferMemoryBarrier draw_barrier{.src_stage_mask  = vk::PipelineStageFlagBits::eComputeShader,
+	                                                 .dst_stage_mask  = vk::PipelineStageFlagBits::eDrawIndirect,
+	                                                 .src_access_mask = vk::AccessFlagBits::eShaderWrite,
+	                                                 .dst_access_mask = vk::AccessFlagBits::eIndirectCommandRead};
+	command_buffer.buffer_memory_barrier(*indirect_buffer, 0, VK_WHOLE_SIZE, draw_barrier);
+	command_buffer.buffer_memory_barrier(*count_buffer, 0, VK_WHOLE_SIZE, draw_barrier);
+}
+
+template <vkb::BindingType bindingType>
+inline void IndirectGeometrySubpass<bindingType>::update_global_uniform(vkb::core::CommandBufferCpp &command_buffer)
+{
+	// The model matrices are read from the InstanceTransforms buffer instead
+	GlobalUniform global_uniform;
+	global_uniform.model            = glm::mat4(1.0f);
+	global_uniform.camera_view_proj = get_view_proj();
+	global_uniform.camera_position  = glm::vec3(glm::inverse(camera.get_view())[3]);
+
+	auto &render_frame = this->get_render_context_impl().get_active_frame();
+	auto  allocation   = render_frame.allocate_buffer(vk::BufferUsageFlagBits::eUniformBuffer, sizeof(GlobalUniform), this->get_thread_index());
+	allocation.update(global_uniform);
+
+	command_buffer.bind_buffer(allocation.get_buffer(), allocation.get_offset(), allocation.get_size(), 0, 1, 0);
+}
+
+}        // namespace subpasses
+}        // namespace rendering
+}        // namespace vkb
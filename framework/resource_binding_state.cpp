@@ -17,63 +17,91 @@
 
 #include "resource_binding_state.h"
 
+#include <bit>
+
 namespace vkb
 {
 void ResourceBindingState::reset()
 {
-	clear_dirty();
+	// Only the sets which were bound hold resources
+	for (uint32_t sets = bound_sets; sets != 0; sets &= sets - 1)
+	{
+		resource_sets[std::countr_zero(sets)].reset();
+	}
 
-	resource_sets.clear();
+	bound_sets = 0;
+	dirty_sets = 0;
 }
 
 bool ResourceBindingState::is_dirty()
 {
-	return dirty;
+	return dirty_sets != 0;
 }
 
 void ResourceBindingState::clear_dirty()
 {
-	dirty = false;
+	for (uint32_t sets = dirty_sets; sets != 0; sets &= sets - 1)
+	{
+		resource_sets[std::countr_zero(sets)].clear_dirty();
+	}
+
+	dirty_sets = 0;
 }
 
 void ResourceBindingState::clear_dirty(uint32_t set)
 {
+	assert(set < max_descriptor_sets && "Descriptor set index is out of bounds");
+
 	resource_sets[set].clear_dirty();
+
+	dirty_sets &= ~(1u << set);
 }
 
 void ResourceBindingState::bind_buffer(const vkb::core::BufferC &buffer, VkDeviceSize offset, VkDeviceSize range, uint32_t set, uint32_t binding, uint32_t array_element)
 {
-	resource_sets[set].bind_buffer(buffer, offset, range, binding, array_element);
-
-	dirty = true;
+	get_resource_set(set).bind_buffer(buffer, offset, range, binding, array_element);
 }
 
 void ResourceBindingState::bind_image(const core::ImageView &image_view, const core::Sampler &sampler, uint32_t set, uint32_t binding, uint32_t array_element)
 {
-	resource_sets[set].bind_image(image_view, sampler, binding, array_element);
-
-	dirty = true;
+	get_resource_set(set).bind_image(image_view, sampler, binding, array_element);
 }
 
 void ResourceBindingState::bind_image(const core::ImageView &image_view, uint32_t set, uint32_t binding, uint32_t array_element)
 {
-	resource_sets[set].bind_image(image_view, binding, array_element);
-
-	dirty = true;
+	get_resource_set(set).bind_image(image_view, binding, array_element);
 }
 
 void ResourceBindingState::bind_input(const core::ImageView &image_view, uint32_t set, uint32_t binding, uint32_t array_element)
 {
-	resource_sets[set].bind_input(image_view, binding, array_element);
+	get_resource_set(set).bind_input(image_view, binding, array_element);
+}
 
-	dirty = true;
+uint32_t ResourceBindingState::get_bound_sets() const
+{
+	return bound_sets;
+}
+
+uint32_t ResourceBindingState::get_dirty_sets() const
+{
+	return dirty_sets;
 }
 
-const std::unordered_map<uint32_t, ResourceSet> &ResourceBindingState::get_resource_sets()
+const std::array<ResourceSet, ResourceBindingState::max_descriptor_sets> &ResourceBindingState::get_resource_sets()
 {
 	return resource_sets;
 }
 
+ResourceSet &ResourceBindingState::get_resource_set(uint32_t set)
+{
+	assert(set < max_descriptor_sets && "Descriptor set index is out of bounds");
+
+	bound_sets |= 1u << set;
+	dirty_sets |= 1u << set;
+
+	return resource_sets[set];
+}
+
 void ResourceSet::reset()
 {
 	clear_dirty();
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2025, Arm Limited and Contributors
+/* Copyright (c) 2019-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <array>
+
 #include "common/vk_common.h"
 #include "core/buffer.h"
 
@@ -90,10 +92,14 @@ class ResourceSet
  *
  * Keeps track of all the resources bound by the command buffer. The ResourceBindingState is used by
  * the command buffer to create the appropriate descriptor sets when it comes to draw.
+ * The resource sets are stored in a fixed-size array indexed by set, with bitmasks of the sets which
+ * were bound and of the sets which changed since the last draw.
  */
 class ResourceBindingState
 {
   public:
+	static constexpr uint32_t max_descriptor_sets = 32;
+
 	void reset();
 
 	bool is_dirty();
@@ -110,11 +116,22 @@ class ResourceBindingState
 
 	void bind_input(const core::ImageView &image_view, uint32_t set, uint32_t binding, uint32_t array_element);
 
-	const std::unordered_map<uint32_t, ResourceSet> &get_resource_sets();
+	/// @return Bitmask of the sets with resources bound since the last reset
+	uint32_t get_bound_sets() const;
+
+	/// @return Bitmask of the sets whose resources changed since their dirty flag was cleared
+	uint32_t get_dirty_sets() const;
+
+	const std::array<ResourceSet, max_descriptor_sets> &get_resource_sets();
 
   private:
-	bool dirty{false};
+	ResourceSet &get_resource_set(uint32_t set);
+
+  private:
+	uint32_t bound_sets{0};
+
+	uint32_t dirty_sets{0};
 
-	std::unordered_map<uint32_t, ResourceSet> resource_sets;
+	std::array<ResourceSet, max_descriptor_sets> resource_sets;
 };
 }        // namespace vkb
@@ -20,18 +20,40 @@
 #include "common/resource_caching.h"
 #include "core/device.h"
 
+#include <cstring>
+
 namespace vkb
 {
 namespace
 {
+/**
+ * @brief Requests an object from the cache, hits go through the lock-free index
+ * @param build_unlocked Whether the object may be built outside of the resource mutex,
+ *        while other threads keep requesting objects of the same type
+ */
 template <class T, class... A>
-T &request_resource(vkb::core::DeviceC &device, ResourceRecord &recorder, std::mutex &resource_mutex, std::unordered_map<std::size_t, T> &resources, A &...args)
+T &request_resource(vkb::core::DeviceC                 &device,
+                    ResourceRecord                     &recorder,
+                    std::mutex                         &resource_mutex,
+                    std::unordered_map<ResourceKey, T> &resources,
+                    ResourceCacheIndex<T>              &index,
+                    bool                                build_unlocked,
+                    A &...args)
 {
-	std::lock_guard<std::mutex> guard(resource_mutex);
-
-	auto &res = request_resource(device, &recorder, resources, args...);
-
-	return res;
+	ResourceKey key = make_resource_key(args...);
+
+	return index.request(
+	    key, resource_mutex, resources, build_unlocked,
+	    [&]() {
+		    LOGD("Building cache object ({})", typeid(T).name());
+		    return T(device, args...);
+	    },
+	    [&](auto &entry) {
+		    RecordHelper<T, A...> record_helper;
+
+		    size_t record_index = record_helper.record(recorder, args...);
+		    record_helper.index(recorder, record_index, entry.second);
+	    });
 }
 }        // namespace
 
@@ -42,128 +64,337 @@ ResourceCache::ResourceCache(vkb::core::DeviceC &device) :
 
 void ResourceCache::warmup(const std::vector<uint8_t> &data)
 {
-	recorder.set_data(data);
+	if (data.empty())
+	{
+		return;
+	}
 
-	replayer.play(*this, recorder);
+	std::vector<uint8_t> records;
+
+	if (!ResourceRecord::remove_header(device.get_gpu().get_properties(), data, records))
+	{
+		LOGW("Resource cache data was recorded with another version, device or driver, skipping warmup");
+		return;
+	}
+
+	replayer.play(*this, records);
+}
+
+bool ResourceCache::warmup_from_file(const vkb::filesystem::Path &path)
+{
+	auto fs = vkb::filesystem::get();
+
+	if (!fs->is_file(path))
+	{
+		LOGW("No resource cache found at {}", path.string());
+		return false;
+	}
+
+	auto header_data = fs->read_chunk(path, 0, sizeof(ResourceRecordHeader));
+
+	if (header_data.size() != sizeof(ResourceRecordHeader))
+	{
+		LOGW("Resource cache {} is truncated", path.string());
+		return false;
+	}
+
+	ResourceRecordHeader header;
+	std::memcpy(&header, header_data.data(), sizeof(ResourceRecordHeader));
+
+	if (!header.is_compatible(device.get_gpu().get_properties()))
+	{
+		LOGW("Resource cache {} was recorded with another version, device or driver, skipping warmup", path.string());
+		return false;
+	}
+
+	// Records are only read once the header has been validated
+	auto records = fs->read_chunk(path, sizeof(ResourceRecordHeader), static_cast<size_t>(header.data_size));
+
+	if (records.size() != header.data_size)
+	{
+		LOGW("Resource cache {} is truncated", path.string());
+		return false;
+	}
+
+	replayer.play(*this, records);
+
+	return true;
 }
 
 std::vector<uint8_t> ResourceCache::serialize()
 {
-	return recorder.get_data();
+	return ResourceRecord::add_header(device.get_gpu().get_properties(), recorder.get_data());
+}
+
+void ResourceCache::serialize_to_file(const vkb::filesystem::Path &path)
+{
+	vkb::filesystem::get()->write_file(path, serialize());
 }
 
 void ResourceCache::set_pipeline_cache(VkPipelineCache new_pipeline_cache)
 {
+	pipeline_compile_queue.wait_idle();
+
+	if (owns_pipeline_cache)
+	{
+		vkDestroyPipelineCache(device.get_handle(), pipeline_cache, nullptr);
+		owns_pipeline_cache = false;
+	}
+
 	pipeline_cache = new_pipeline_cache;
 }
 
+bool ResourceCache::load_pipeline_cache(const vkb::filesystem::Path &path)
+{
+	auto fs = vkb::filesystem::get();
+
+	std::vector<uint8_t> data;
+
+	if (fs->is_file(path))
+	{
+		data = fs->read_file_binary(path);
+	}
+	else
+	{
+		LOGW("No pipeline cache found at {}", path.string());
+	}
+
+	// The driver ignores data from another device or driver version, and starts from an empty cache
+	VkPipelineCacheCreateInfo create_info{VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO};
+	create_info.initialDataSize = data.size();
+	create_info.pInitialData    = data.data();
+
+	VkPipelineCache new_pipeline_cache{VK_NULL_HANDLE};
+	VK_CHECK(vkCreatePipelineCache(device.get_handle(), &create_info, nullptr, &new_pipeline_cache));
+
+	set_pipeline_cache(new_pipeline_cache);
+	owns_pipeline_cache = true;
+
+	return !data.empty();
+}
+
+void ResourceCache::save_pipeline_cache(const vkb::filesystem::Path &path)
+{
+	if (pipeline_cache == VK_NULL_HANDLE)
+	{
+		LOGW("No pipeline cache to save to {}", path.string());
+		return;
+	}
+
+	pipeline_compile_queue.wait_idle();
+
+	size_t data_size = 0;
+	VK_CHECK(vkGetPipelineCacheData(device.get_handle(), pipeline_cache, &data_size, nullptr));
+
+	std::vector<uint8_t> data(data_size);
+	VK_CHECK(vkGetPipelineCacheData(device.get_handle(), pipeline_cache, &data_size, data.data()));
+
+	vkb::filesystem::get()->write_file(path, data);
+}
+
 ShaderModule &ResourceCache::request_shader_module(VkShaderStageFlagBits stage, const ShaderSource &glsl_source, const ShaderVariant &shader_variant)
 {
 	std::string entry_point{"main"};
-	return request_resource(device, recorder, shader_module_mutex, state.shader_modules, stage, glsl_source, entry_point, shader_variant);
+	return request_resource(device, recorder, shader_module_mutex, state.shader_modules, index_state.shader_modules, true, stage, glsl_source, entry_point, shader_variant);
 }
 
 PipelineLayout &ResourceCache::request_pipeline_layout(const std::vector<ShaderModule *> &shader_modules)
 {
-	return request_resource(device, recorder, pipeline_layout_mutex, state.pipeline_layouts, shader_modules);
+	return request_resource(device, recorder, pipeline_layout_mutex, state.pipeline_layouts, index_state.pipeline_layouts, true, shader_modules);
 }
 
 DescriptorSetLayout &ResourceCache::request_descriptor_set_layout(const uint32_t                     set_index,
                                                                   const std::vector<ShaderModule *> &shader_modules,
                                                                   const std::vector<ShaderResource> &set_resources)
 {
-	return request_resource(device, recorder, descriptor_set_layout_mutex, state.descriptor_set_layouts, set_index, shader_modules, set_resources);
+	return request_resource(device, recorder, descriptor_set_layout_mutex, state.descriptor_set_layouts, index_state.descriptor_set_layouts, true, set_index, shader_modules, set_resources);
 }
 
 GraphicsPipeline &ResourceCache::request_graphics_pipeline(vkb::rendering::PipelineStateC &pipeline_state)
 {
-	return request_resource(device, recorder, graphics_pipeline_mutex, state.graphics_pipelines, pipeline_cache, pipeline_state);
+	return request_resource(device, recorder, graphics_pipeline_mutex, state.graphics_pipelines, index_state.graphics_pipelines, true, pipeline_cache, pipeline_state);
+}
+
+GraphicsPipeline *ResourceCache::request_graphics_pipeline_async(vkb::rendering::PipelineStateC &pipeline_state)
+{
+	if (!pipeline_compile_queue.is_enabled())
+	{
+		return &request_graphics_pipeline(pipeline_state);
+	}
+
+	ResourceKey key = make_resource_key(pipeline_cache, pipeline_state);
+
+	if (auto pipeline = index_state.graphics_pipelines.request_existing(key))
+	{
+		return pipeline;
+	}
+
+	// The pipeline state is copied, as the caller keeps changing its own
+	bool queued = pipeline_compile_queue.push(key, [this, pipeline_state]() mutable { request_graphics_pipeline(pipeline_state); });
+
+	if (!queued)
+	{
+		// Its build failed before, building it again here reports the error to the caller
+		return &request_graphics_pipeline(pipeline_state);
+	}
+
+	return nullptr;
+}
+
+void ResourceCache::register_fallback_pipeline(vkb::rendering::PipelineStateC &pipeline_state)
+{
+	auto &pipeline    = request_graphics_pipeline(pipeline_state);
+	auto  render_pass = pipeline_state.get_render_pass();
+
+	pipeline_compile_queue.register_fallback(pipeline_state.get_pipeline_layout().get_handle(),
+	                                         render_pass ? render_pass->get_handle() : VK_NULL_HANDLE,
+	                                         pipeline_state.get_subpass_index(),
+	                                         pipeline.get_handle());
+}
+
+VkPipeline ResourceCache::find_fallback_pipeline(vkb::rendering::PipelineStateC const &pipeline_state) const
+{
+	auto render_pass = pipeline_state.get_render_pass();
+
+	return pipeline_compile_queue.find_fallback(pipeline_state.get_pipeline_layout().get_handle(),
+	                                            render_pass ? render_pass->get_handle() : VK_NULL_HANDLE,
+	                                            pipeline_state.get_subpass_index());
+}
+
+void ResourceCache::set_async_pipeline_compilation(bool enabled)
+{
+	pipeline_compile_queue.set_enabled(enabled);
+}
+
+size_t ResourceCache::get_pipeline_compile_queue_depth() const
+{
+	return pipeline_compile_queue.get_depth();
+}
+
+void ResourceCache::wait_pipeline_compilations()
+{
+	pipeline_compile_queue.wait_idle();
 }
 
 ComputePipeline &ResourceCache::request_compute_pipeline(vkb::rendering::PipelineStateC &pipeline_state)
 {
-	return request_resource(device, recorder, compute_pipeline_mutex, state.compute_pipelines, pipeline_cache, pipeline_state);
+	return request_resource(device, recorder, compute_pipeline_mutex, state.compute_pipelines, index_state.compute_pipelines, true, pipeline_cache, pipeline_state);
 }
 
 DescriptorSet &ResourceCache::request_descriptor_set(DescriptorSetLayout &descriptor_set_layout, const BindingMap<VkDescriptorBufferInfo> &buffer_infos, const BindingMap<VkDescriptorImageInfo> &image_infos)
 {
-	auto &descriptor_pool = request_resource(device, recorder, descriptor_set_mutex, state.descriptor_pools, descriptor_set_layout);
-	return request_resource(device, recorder, descriptor_set_mutex, state.descriptor_sets, descriptor_set_layout, descriptor_pool, buffer_infos, image_infos);
+	// Descriptor sets are allocated from a shared pool, which is not thread safe, so they are built with the mutex held
+	auto &descriptor_pool = request_resource(device, recorder, descriptor_set_mutex, state.descriptor_pools, index_state.descriptor_pools, false, descriptor_set_layout);
+
+	ResourceKey key = make_resource_key(descriptor_set_layout, descriptor_pool, buffer_infos, image_infos);
+
+	return index_state.descriptor_sets.request(
+	    key, descriptor_set_mutex, state.descriptor_sets, false,
+	    [&]() {
+		    LOGD("Building cache object ({})", typeid(DescriptorSet).name());
+		    return DescriptorSet(device, descriptor_set_layout, descriptor_pool, buffer_infos, image_infos);
+	    },
+	    [this](auto &entry) {
+		    state.descriptor_set_references.insert(entry.first, entry.second.get_buffer_infos(), entry.second.get_image_infos());
+	    });
 }
 
 RenderPass &ResourceCache::request_render_pass(const std::vector<vkb::rendering::AttachmentC> &attachments, const std::vector<LoadStoreInfo> &load_store_infos, const std::vector<SubpassInfo> &subpasses)
 {
-	return request_resource(device, recorder, render_pass_mutex, state.render_passes, attachments, load_store_infos, subpasses);
+	return request_resource(device, recorder, render_pass_mutex, state.render_passes, index_state.render_passes, true, attachments, load_store_infos, subpasses);
 }
 
 Framebuffer &ResourceCache::request_framebuffer(const vkb::rendering::RenderTargetC &render_target, const RenderPass &render_pass)
 {
-	return request_resource(device, recorder, framebuffer_mutex, state.framebuffers, render_target, render_pass);
+	return request_resource(device, recorder, framebuffer_mutex, state.framebuffers, index_state.framebuffers, true, render_target, render_pass);
 }
 
 void ResourceCache::clear_pipelines()
 {
+	// The fallback pipelines are destroyed along with the others, so they are unregistered as well
+	pipeline_compile_queue.clear();
+
+	index_state.graphics_pipelines.clear();
+	index_state.compute_pipelines.clear();
 	state.graphics_pipelines.clear();
 	state.compute_pipelines.clear();
 }
 
 void ResourceCache::update_descriptor_sets(const std::vector<core::ImageView> &old_views, const std::vector<core::ImageView> &new_views)
 {
-	// Find descriptor sets referring to the old image view
-	std::vector<VkWriteDescriptorSet> set_updates;
-	std::set<size_t>                  matches;
+	std::lock_guard<std::mutex> guard(descriptor_set_mutex);
+
+	std::unordered_map<VkImageView, VkImageView> view_updates;
+
+	// Find descriptor sets referring to the old image views, through the references instead of scanning all sets
+	std::unordered_set<const ResourceKey *> matches;
 
 	for (size_t i = 0; i < old_views.size(); ++i)
 	{
-		auto &old_view = old_views[i];
-		auto &new_view = new_views[i];
+		view_updates[old_views[i].get_handle()] = new_views[i].get_handle();
 
-		for (auto &kd_pair : state.descriptor_sets)
+		if (auto keys = state.descriptor_set_references.find_image_view(old_views[i].get_handle()))
 		{
-			auto &key            = kd_pair.first;
-			auto &descriptor_set = kd_pair.second;
+			matches.insert(keys->begin(), keys->end());
+		}
+	}
+
+	using DescriptorSetNode = ResourceCacheIndex<DescriptorSet>::Node;
+
+	std::vector<VkWriteDescriptorSet> set_updates;
+	std::vector<DescriptorSetNode>    updated_nodes;
+	updated_nodes.reserve(matches.size());
 
-			auto &image_infos = descriptor_set.get_image_infos();
+	for (auto match : matches)
+	{
+		// Take the node out of the map, the key is no longer valid once the image infos change.
+		// The set is updated in place, as lock-free lookups may already have found it
+		auto it = state.descriptor_sets.find(*match);
+		state.descriptor_set_references.erase(it->first, it->second.get_buffer_infos(), it->second.get_image_infos());
+		updated_nodes.push_back(index_state.descriptor_sets.extract(state.descriptor_sets, it));
+	}
+
+	for (auto &node : updated_nodes)
+	{
+		auto &descriptor_set = node.mapped();
 
-			for (auto &ba_pair : image_infos)
+		for (auto &ba_pair : descriptor_set.get_image_infos())
+		{
+			auto &binding = ba_pair.first;
+			auto &array   = ba_pair.second;
+
+			for (auto &ai_pair : array)
 			{
-				auto &binding = ba_pair.first;
-				auto &array   = ba_pair.second;
+				auto &array_element = ai_pair.first;
+				auto &image_info    = ai_pair.second;
+
+				auto view_it = view_updates.find(image_info.imageView);
+
+				if (view_it == view_updates.end())
+				{
+					continue;
+				}
+
+				// Update image info with new view
+				image_info.imageView = view_it->second;
+
+				// Save struct for writing the update later
+				if (auto binding_info = descriptor_set.get_layout().get_layout_binding(binding))
+				{
+					VkWriteDescriptorSet write_descriptor_set{VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET};
+
+					write_descriptor_set.dstBinding      = binding;
+					write_descriptor_set.descriptorType  = binding_info->descriptorType;
+					write_descriptor_set.pImageInfo      = &image_info;
+					write_descriptor_set.dstSet          = descriptor_set.get_handle();
+					write_descriptor_set.dstArrayElement = array_element;
+					write_descriptor_set.descriptorCount = 1;
 
-				for (auto &ai_pair : array)
+					set_updates.push_back(write_descriptor_set);
+				}
+				else
 				{
-					auto &array_element = ai_pair.first;
-					auto &image_info    = ai_pair.second;
-
-					if (image_info.imageView == old_view.get_handle())
-					{
-						// Save key to remove old descriptor set
-						matches.insert(key);
-
-						// Update image info with new view
-						image_info.imageView = new_view.get_handle();
-
-						// Save struct for writing the update later
-						{
-							VkWriteDescriptorSet write_descriptor_set{VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET};
-
-							if (auto binding_info = descriptor_set.get_layout().get_layout_binding(binding))
-							{
-								write_descriptor_set.dstBinding      = binding;
-								write_descriptor_set.descriptorType  = binding_info->descriptorType;
-								write_descriptor_set.pImageInfo      = &image_info;
-								write_descriptor_set.dstSet          = descriptor_set.get_handle();
-								write_descriptor_set.dstArrayElement = array_element;
-								write_descriptor_set.descriptorCount = 1;
-
-								set_updates.push_back(write_descriptor_set);
-							}
-							else
-							{
-								LOGE("Shader layout set does not use image binding at #{}", binding);
-							}
-						}
-					}
+					LOGE("Shader layout set does not use image binding at #{}", binding);
 				}
 			}
 		}
@@ -175,41 +406,166 @@ void ResourceCache::update_descriptor_sets(const std::vector<core::ImageView> &o
 		                       0, nullptr);
 	}
 
-	// Delete old entries (moved out descriptor sets)
-	for (auto &match : matches)
+	for (auto &node : updated_nodes)
 	{
-		// Move out of the map
-		auto it             = state.descriptor_sets.find(match);
-		auto descriptor_set = std::move(it->second);
-		state.descriptor_sets.erase(match);
-
-		// Generate new key
-		size_t new_key = 0U;
-		hash_param(new_key, descriptor_set.get_layout(), descriptor_set.get_buffer_infos(), descriptor_set.get_image_infos());
+		// Generate new key, from the same arguments as request_descriptor_set
+		auto &descriptor_set  = node.mapped();
+		auto &descriptor_pool = state.descriptor_pools.at(make_resource_key(descriptor_set.get_layout()));
+		node.key()            = make_resource_key(descriptor_set.get_layout(), descriptor_pool, descriptor_set.get_buffer_infos(), descriptor_set.get_image_infos());
 
 		// Add (key, resource) to the cache
-		state.descriptor_sets.emplace(new_key, std::move(descriptor_set));
+		auto result = state.descriptor_sets.insert(std::move(node));
+		if (result.inserted)
+		{
+			auto &entry = *result.position;
+			index_state.descriptor_sets.insert(entry);
+			state.descriptor_set_references.insert(entry.first, entry.second.get_buffer_infos(), entry.second.get_image_infos());
+		}
+		else
+		{
+			// An equal set already refers to the new views, the updated one is no longer needed
+			descriptor_pool.free(result.node.mapped().get_handle());
+			index_state.descriptor_sets.retire(std::move(result.node));
+		}
+	}
+}
+
+void ResourceCache::invalidate_descriptor_sets(const std::vector<VkImageView> &image_views, const std::vector<VkBuffer> &buffers)
+{
+	std::lock_guard<std::mutex> guard(descriptor_set_mutex);
+
+	std::unordered_set<const ResourceKey *> matches;
+
+	for (auto image_view : image_views)
+	{
+		if (auto keys = state.descriptor_set_references.find_image_view(image_view))
+		{
+			matches.insert(keys->begin(), keys->end());
+		}
+	}
+
+	for (auto buffer : buffers)
+	{
+		if (auto keys = state.descriptor_set_references.find_buffer(buffer))
+		{
+			matches.insert(keys->begin(), keys->end());
+		}
+	}
+
+	for (auto match : matches)
+	{
+		auto  it             = state.descriptor_sets.find(*match);
+		auto &descriptor_set = it->second;
+
+		state.descriptor_set_references.erase(it->first, descriptor_set.get_buffer_infos(), descriptor_set.get_image_infos());
+		state.descriptor_pools.at(make_resource_key(descriptor_set.get_layout())).free(descriptor_set.get_handle());
+
+		// Lock-free lookups may already have found the set, so its node is only destroyed by the next eviction pass
+		index_state.descriptor_sets.retire(index_state.descriptor_sets.extract(state.descriptor_sets, it));
 	}
 }
 
 void ResourceCache::clear_framebuffers()
 {
+	index_state.framebuffers.clear();
 	state.framebuffers.clear();
 }
 
 void ResourceCache::clear()
 {
+	// Pipelines being built refer to the shader modules, layouts and render passes
+	pipeline_compile_queue.clear();
+
+	index_state.shader_modules.clear();
+	index_state.pipeline_layouts.clear();
+	index_state.descriptor_sets.clear();
+	index_state.descriptor_set_layouts.clear();
+	index_state.render_passes.clear();
 	state.shader_modules.clear();
 	state.pipeline_layouts.clear();
 	state.descriptor_sets.clear();
+	state.descriptor_set_references.clear();
 	state.descriptor_set_layouts.clear();
 	state.render_passes.clear();
 	clear_pipelines();
 	clear_framebuffers();
+
+	if (owns_pipeline_cache)
+	{
+		vkDestroyPipelineCache(device.get_handle(), pipeline_cache, nullptr);
+		pipeline_cache      = VK_NULL_HANDLE;
+		owns_pipeline_cache = false;
+	}
+}
+
+uint32_t ResourceCache::next_frame()
+{
+	index_state.descriptor_sets.next_frame();
+	index_state.framebuffers.next_frame();
+	index_state.graphics_pipelines.next_frame();
+
+	return index_state.descriptor_sets.get_frame();
+}
+
+void ResourceCache::evict(uint32_t oldest_frame_in_flight)
+{
+	index_state.descriptor_sets.evict(state.descriptor_sets, budget.descriptor_sets, oldest_frame_in_flight, [this](auto &entry) {
+		auto &descriptor_set = entry.second;
+		state.descriptor_set_references.erase(entry.first, descriptor_set.get_buffer_infos(), descriptor_set.get_image_infos());
+
+		// Descriptor sets do not free themselves, as the pools they come from are usually reset instead
+		state.descriptor_pools.at(make_resource_key(descriptor_set.get_layout())).free(descriptor_set.get_handle());
+	});
+	index_state.framebuffers.evict(state.framebuffers, budget.framebuffers, oldest_frame_in_flight, [](auto &) {});
+
+	// Pipelines may still be built asynchronously, the mutex keeps them from being added to the cache meanwhile.
+	// Their builds look up the cache without it, so evicted pipelines are only destroyed once no build is in flight.
+	// Fallback pipelines stay in the cache, as draws whose pipeline is being built use them.
+	std::lock_guard<std::mutex> lock(graphics_pipeline_mutex);
+	index_state.graphics_pipelines.evict(state.graphics_pipelines,
+	                                     budget.graphics_pipelines,
+	                                     oldest_frame_in_flight,
+	                                     pipeline_compile_queue.get_depth() > 0,
+	                                     [](auto &) {},
+	                                     [this](auto &entry) { return pipeline_compile_queue.is_fallback(entry.second.get_handle()); });
+}
+
+void ResourceCache::set_budget(const ResourceCacheBudget &new_budget)
+{
+	budget = new_budget;
+}
+
+const ResourceCacheBudget &ResourceCache::get_budget() const
+{
+	return budget;
 }
 
 const ResourceCacheState &ResourceCache::get_internal_state() const
 {
 	return state;
 }
+
+const ResourceCacheIndexState &ResourceCache::get_index_state() const
+{
+	return index_state;
+}
+
+ResourceCacheStats ResourceCache::get_stats() const
+{
+	ResourceCacheStats stats;
+
+	index_state.shader_modules.accumulate(stats);
+	index_state.pipeline_layouts.accumulate(stats);
+	index_state.descriptor_set_layouts.accumulate(stats);
+	index_state.descriptor_pools.accumulate(stats);
+	index_state.render_passes.accumulate(stats);
+	index_state.graphics_pipelines.accumulate(stats);
+	index_state.compute_pipelines.accumulate(stats);
+	index_state.descriptor_sets.accumulate(stats);
+	index_state.framebuffers.accumulate(stats);
+
+	stats.pending_pipelines = pipeline_compile_queue.get_depth();
+
+	return stats;
+}
 }        // namespace vkb
@@ -21,12 +21,16 @@
 #include <unordered_map>
 #include <vector>
 
+#include "common/descriptor_set_references.h"
 #include "common/helpers.h"
+#include "common/pipeline_compile_queue.h"
+#include "common/resource_cache_index.h"
 #include "core/descriptor_pool.h"
 #include "core/descriptor_set.h"
 #include "core/descriptor_set_layout.h"
 #include "core/framebuffer.h"
 #include "core/pipeline.h"
+#include "filesystem/filesystem.hpp"
 #include "resource_record.h"
 #include "resource_replay.h"
 
@@ -47,23 +51,50 @@ class ImageView;
  */
 struct ResourceCacheState
 {
-	std::unordered_map<std::size_t, ShaderModule> shader_modules;
+	std::unordered_map<ResourceKey, ShaderModule> shader_modules;
 
-	std::unordered_map<std::size_t, PipelineLayout> pipeline_layouts;
+	std::unordered_map<ResourceKey, PipelineLayout> pipeline_layouts;
 
-	std::unordered_map<std::size_t, DescriptorSetLayout> descriptor_set_layouts;
+	std::unordered_map<ResourceKey, DescriptorSetLayout> descriptor_set_layouts;
 
-	std::unordered_map<std::size_t, DescriptorPool> descriptor_pools;
+	std::unordered_map<ResourceKey, DescriptorPool> descriptor_pools;
 
-	std::unordered_map<std::size_t, RenderPass> render_passes;
+	std::unordered_map<ResourceKey, RenderPass> render_passes;
 
-	std::unordered_map<std::size_t, GraphicsPipeline> graphics_pipelines;
+	std::unordered_map<ResourceKey, GraphicsPipeline> graphics_pipelines;
 
-	std::unordered_map<std::size_t, ComputePipeline> compute_pipelines;
+	std::unordered_map<ResourceKey, ComputePipeline> compute_pipelines;
 
-	std::unordered_map<std::size_t, DescriptorSet> descriptor_sets;
+	std::unordered_map<ResourceKey, DescriptorSet> descriptor_sets;
 
-	std::unordered_map<std::size_t, Framebuffer> framebuffers;
+	std::unordered_map<ResourceKey, Framebuffer> framebuffers;
+
+	DescriptorSetReferences descriptor_set_references;
+};
+
+/**
+ * @brief Struct to hold the lock-free indices over the objects in the ResourceCacheState,
+ *        together with their request counters
+ */
+struct ResourceCacheIndexState
+{
+	ResourceCacheIndex<ShaderModule> shader_modules;
+
+	ResourceCacheIndex<PipelineLayout> pipeline_layouts;
+
+	ResourceCacheIndex<DescriptorSetLayout> descriptor_set_layouts;
+
+	ResourceCacheIndex<DescriptorPool> descriptor_pools;
+
+	ResourceCacheIndex<RenderPass> render_passes;
+
+	ResourceCacheIndex<GraphicsPipeline> graphics_pipelines;
+
+	ResourceCacheIndex<ComputePipeline> compute_pipelines;
+
+	ResourceCacheIndex<DescriptorSet> descriptor_sets;
+
+	ResourceCacheIndex<Framebuffer> framebuffers;
 };
 
 /**
@@ -76,7 +107,12 @@ struct ResourceCacheState
  * The resource cache is also linked with ResourceRecord and ResourceReplay. Replay can warm-up
  * the cache on app startup by creating all necessary objects.
  * The cache holds pointers to objects and has a mapping from such pointers to hashes.
- * It can only be destroyed in bulk, single elements cannot be removed.
+ * Descriptor sets, framebuffers and graphics pipelines which are no longer requested are evicted
+ * once per frame according to the ResourceCacheBudget, other objects are only destroyed in bulk.
+ *
+ * Requests for objects already in the cache go through a lock-free index and do not take any lock.
+ * Only misses take the per-type mutex, and most objects are then built outside of it, so that
+ * threads only wait for each other when they request the same object.
  */
 class ResourceCache
 {
@@ -91,12 +127,49 @@ class ResourceCache
 
 	ResourceCache &operator=(ResourceCache &&) = delete;
 
+	/**
+	 * @brief Creates all resources recorded in a previous run
+	 * @param data Serialized data as returned by serialize(), ignored if it was recorded on another device or driver
+	 */
 	void warmup(const std::vector<uint8_t> &data);
 
+	/**
+	 * @brief Reads serialized data from a file and creates the resources recorded in it
+	 *        The header is read and validated first, so data from another device is not loaded
+	 * @param path Path to the file written by serialize_to_file()
+	 * @return True if the file was found and replayed
+	 */
+	bool warmup_from_file(const vkb::filesystem::Path &path);
+
+	/// @return The resources recorded so far, preceded by a header identifying the device and driver
 	std::vector<uint8_t> serialize();
 
+	/**
+	 * @brief Writes the serialized cache to a file
+	 * @param path Path to the file to write
+	 */
+	void serialize_to_file(const vkb::filesystem::Path &path);
+
+	/**
+	 * @brief Sets the pipeline cache used to build pipelines, owned by the caller
+	 *        A pipeline cache created by load_pipeline_cache() is destroyed
+	 */
 	void set_pipeline_cache(VkPipelineCache pipeline_cache);
 
+	/**
+	 * @brief Creates the pipeline cache used to build pipelines from the data saved by save_pipeline_cache(),
+	 *        so that the driver does not compile the pipelines of a previous run again
+	 * @param path Path to the file written by save_pipeline_cache()
+	 * @return True if the file was found, the driver ignores its data if it was saved by another device or driver
+	 */
+	bool load_pipeline_cache(const vkb::filesystem::Path &path);
+
+	/**
+	 * @brief Writes the data of the pipeline cache to a file, after waiting for the pipelines being built
+	 * @param path Path to the file to write
+	 */
+	void save_pipeline_cache(const vkb::filesystem::Path &path);
+
 	ShaderModule &request_shader_module(VkShaderStageFlagBits stage, const ShaderSource &glsl_source, const ShaderVariant &shader_variant = {});
 
 	PipelineLayout &request_pipeline_layout(const std::vector<ShaderModule *> &shader_modules);
@@ -107,6 +180,33 @@ class ResourceCache
 
 	GraphicsPipeline &request_graphics_pipeline(vkb::rendering::PipelineStateC &pipeline_state);
 
+	/**
+	 * @brief Requests a graphics pipeline without waiting for it to be built
+	 *        While asynchronous compilation is enabled, a pipeline which is not in the cache yet is queued
+	 *        on the worker thread of the PipelineCompileQueue, otherwise this is the same as request_graphics_pipeline()
+	 * @return The pipeline, or nullptr while it is being built
+	 */
+	GraphicsPipeline *request_graphics_pipeline_async(vkb::rendering::PipelineStateC &pipeline_state);
+
+	/**
+	 * @brief Builds a pipeline and registers it as the fallback of the pipelines with the same layout,
+	 *        render pass and subpass, used by draws whose own pipeline is being built
+	 *        Fallback pipelines are not evicted, and are unregistered when the pipelines are cleared
+	 */
+	void register_fallback_pipeline(vkb::rendering::PipelineStateC &pipeline_state);
+
+	/// @return The fallback pipeline registered for the layout, render pass and subpass of a pipeline state, or VK_NULL_HANDLE
+	VkPipeline find_fallback_pipeline(vkb::rendering::PipelineStateC const &pipeline_state) const;
+
+	/// @brief Enables or disables asynchronous compilation of graphics pipelines, disabled by default
+	void set_async_pipeline_compilation(bool enabled);
+
+	/// @return The number of graphics pipelines queued or being built
+	size_t get_pipeline_compile_queue_depth() const;
+
+	/// @brief Waits for the graphics pipelines being built, e.g. before a loading screen ends
+	void wait_pipeline_compilations();
+
 	ComputePipeline &request_compute_pipeline(vkb::rendering::PipelineStateC &pipeline_state);
 
 	DescriptorSet &request_descriptor_set(DescriptorSetLayout                      &descriptor_set_layout,
@@ -123,16 +223,52 @@ class ResourceCache
 	void clear_pipelines();
 
 	/// @brief Update those descriptor sets referring to old views
+	///        The sets are updated in place, so no other thread may use them at the same time
 	/// @param old_views Old image views referred by descriptor sets
 	/// @param new_views New image views to be referred
 	void update_descriptor_sets(const std::vector<core::ImageView> &old_views, const std::vector<core::ImageView> &new_views);
 
+	/**
+	 * @brief Destroys the descriptor sets referring to any of the given image views or buffers,
+	 *        e.g. before a texture is streamed out. The GPU must no longer use those descriptor sets.
+	 *        Lock-free lookups may have found them already, so their objects stay alive until the next eviction pass.
+	 * @param image_views Image views about to be destroyed
+	 * @param buffers Buffers about to be destroyed
+	 */
+	void invalidate_descriptor_sets(const std::vector<VkImageView> &image_views, const std::vector<VkBuffer> &buffers = {});
+
 	void clear_framebuffers();
 
 	void clear();
 
+	/**
+	 * @brief Starts a new frame, objects requested from now on are marked as used in it.
+	 *        Must be called once per frame while no other thread uses the cache.
+	 * @return The new frame, which a render frame keeps until the GPU is done with it
+	 */
+	uint32_t next_frame();
+
+	/**
+	 * @brief Evicts the descriptor sets, framebuffers and graphics pipelines exceeding the budget.
+	 *        Must be called after waiting for the retiring frame, while no other thread uses the cache
+	 *        except for the asynchronous pipeline builds.
+	 * @param oldest_frame_in_flight Oldest frame (as returned by next_frame) the GPU may still be executing,
+	 *        objects used in it or in later frames are kept
+	 */
+	void evict(uint32_t oldest_frame_in_flight);
+
+	void set_budget(const ResourceCacheBudget &budget);
+
+	const ResourceCacheBudget &get_budget() const;
+
 	const ResourceCacheState &get_internal_state() const;
 
+	/// @return The indices over the cached objects, holding the request counters of each resource type
+	const ResourceCacheIndexState &get_index_state() const;
+
+	/// @return The counters of all resource types added up
+	ResourceCacheStats get_stats() const;
+
   private:
 	vkb::core::DeviceC &device;
 
@@ -159,5 +295,14 @@ class ResourceCache
 	std::mutex compute_pipeline_mutex;
 
 	std::mutex framebuffer_mutex;
+
+	ResourceCacheIndexState index_state;
+
+	ResourceCacheBudget budget;
+
+	bool owns_pipeline_cache{false};
+
+	// Last member, so that its destructor waits for the pipelines being built before the rest of the cache is destroyed
+	PipelineCompileQueue pipeline_compile_queue;
 };
 }        // namespace vkb
@@ -23,6 +23,8 @@
 #include "rendering/render_target.h"
 #include "resource_cache.h"
 
+#include <cstring>
+
 namespace vkb
 {
 namespace
@@ -38,13 +40,70 @@ inline void write_subpass_info(std::ostringstream &os, const std::vector<Subpass
 }
 }        // namespace
 
+ResourceRecordHeader ResourceRecordHeader::create(const VkPhysicalDeviceProperties &properties, uint64_t data_size)
+{
+	ResourceRecordHeader header{};
+	header.vendor_id      = properties.vendorID;
+	header.device_id      = properties.deviceID;
+	header.driver_version = properties.driverVersion;
+	header.data_size      = data_size;
+	std::copy(std::begin(properties.pipelineCacheUUID), std::end(properties.pipelineCacheUUID), header.pipeline_cache_uuid.begin());
+
+	return header;
+}
+
+bool ResourceRecordHeader::is_compatible(const VkPhysicalDeviceProperties &properties) const
+{
+	return magic == magic_value &&
+	       version == version_value &&
+	       vendor_id == properties.vendorID &&
+	       device_id == properties.deviceID &&
+	       driver_version == properties.driverVersion &&
+	       std::equal(pipeline_cache_uuid.begin(), pipeline_cache_uuid.end(), std::begin(properties.pipelineCacheUUID));
+}
+
+std::vector<uint8_t> ResourceRecord::add_header(const VkPhysicalDeviceProperties &properties, const std::vector<uint8_t> &data)
+{
+	auto header = ResourceRecordHeader::create(properties, data.size());
+
+	std::vector<uint8_t> serialized(sizeof(ResourceRecordHeader) + data.size());
+	std::memcpy(serialized.data(), &header, sizeof(ResourceRecordHeader));
+	std::copy(data.begin(), data.end(), serialized.begin() + sizeof(ResourceRecordHeader));
+
+	return serialized;
+}
+
+bool ResourceRecord::remove_header(const VkPhysicalDeviceProperties &properties, const std::vector<uint8_t> &data, std::vector<uint8_t> &records)
+{
+	if (data.size() < sizeof(ResourceRecordHeader))
+	{
+		return false;
+	}
+
+	ResourceRecordHeader header;
+	std::memcpy(&header, data.data(), sizeof(ResourceRecordHeader));
+
+	if (!header.is_compatible(properties) || header.data_size != data.size() - sizeof(ResourceRecordHeader))
+	{
+		return false;
+	}
+
+	records.assign(data.begin() + sizeof(ResourceRecordHeader), data.end());
+
+	return true;
+}
+
 void ResourceRecord::set_data(const std::vector<uint8_t> &data)
 {
+	std::lock_guard<std::mutex> guard(stream_mutex);
+
 	stream.str(std::string{data.begin(), data.end()});
 }
 
 std::vector<uint8_t> ResourceRecord::get_data()
 {
+	std::lock_guard<std::mutex> guard(stream_mutex);
+
 	std::string str = stream.str();
 
 	return std::vector<uint8_t>{str.begin(), str.end()};
@@ -57,6 +116,8 @@ const std::ostringstream &ResourceRecord::get_stream()
 
 size_t ResourceRecord::register_shader_module(VkShaderStageFlagBits stage, const ShaderSource &glsl_source, const std::string &entry_point, const ShaderVariant &shader_variant)
 {
+	std::lock_guard<std::mutex> guard(stream_mutex);
+
 	shader_module_indices.push_back(shader_module_indices.size());
 
 	write(stream, ResourceType::ShaderModule, stage, glsl_source.get_source(), entry_point);
@@ -66,6 +127,8 @@ size_t ResourceRecord::register_shader_module(VkShaderStageFlagBits stage, const
 
 size_t ResourceRecord::register_pipeline_layout(const std::vector<ShaderModule *> &shader_modules)
 {
+	std::lock_guard<std::mutex> guard(stream_mutex);
+
 	pipeline_layout_indices.push_back(pipeline_layout_indices.size());
 
 	std::vector<size_t> shader_indices(shader_modules.size());
@@ -81,6 +144,8 @@ size_t ResourceRecord::register_pipeline_layout(const std::vector<ShaderModule *
 
 size_t ResourceRecord::register_render_pass(const std::vector<vkb::rendering::AttachmentC> &attachments, const std::vector<LoadStoreInfo> &load_store_infos, const std::vector<SubpassInfo> &subpasses)
 {
+	std::lock_guard<std::mutex> guard(stream_mutex);
+
 	render_pass_indices.push_back(render_pass_indices.size());
 
 	write(stream,
@@ -95,6 +160,8 @@ size_t ResourceRecord::register_render_pass(const std::vector<vkb::rendering::At
 
 size_t ResourceRecord::register_graphics_pipeline(VkPipelineCache /*pipeline_cache*/, vkb::rendering::PipelineStateC &pipeline_state)
 {
+	std::lock_guard<std::mutex> guard(stream_mutex);
+
 	graphics_pipeline_indices.push_back(graphics_pipeline_indices.size());
 
 	auto &pipeline_layout = pipeline_state.get_pipeline_layout();
@@ -136,21 +203,29 @@ size_t ResourceRecord::register_graphics_pipeline(VkPipelineCache /*pipeline_cac
 
 void ResourceRecord::set_shader_module(size_t index, const ShaderModule &shader_module)
 {
+	std::lock_guard<std::mutex> guard(stream_mutex);
+
 	shader_module_to_index[&shader_module] = index;
 }
 
 void ResourceRecord::set_pipeline_layout(size_t index, const PipelineLayout &pipeline_layout)
 {
+	std::lock_guard<std::mutex> guard(stream_mutex);
+
 	pipeline_layout_to_index[&pipeline_layout] = index;
 }
 
 void ResourceRecord::set_render_pass(size_t index, const RenderPass &render_pass)
 {
+	std::lock_guard<std::mutex> guard(stream_mutex);
+
 	render_pass_to_index[&render_pass] = index;
 }
 
 void ResourceRecord::set_graphics_pipeline(size_t index, const GraphicsPipeline &graphics_pipeline)
 {
+	std::lock_guard<std::mutex> guard(stream_mutex);
+
 	graphics_pipeline_to_index[&graphics_pipeline] = index;
 }
 
@@ -19,6 +19,9 @@
 
 #include "core/render_pass.h"
 #include "rendering/pipeline_state.h"
+#include <array>
+#include <cstdint>
+#include <mutex>
 #include <vector>
 
 namespace vkb
@@ -43,12 +46,69 @@ enum class ResourceType
 	GraphicsPipeline
 };
 
+/**
+ * @brief Header written in front of the recorded resources when they are serialized.
+ *        Recorded data is only replayed on the same device and driver it was recorded on,
+ *        as pipelines built from it would otherwise miss the pipeline cache anyway.
+ */
+struct ResourceRecordHeader
+{
+	static constexpr uint32_t magic_value   = 0x52424B56;        // "VKBR"
+	static constexpr uint32_t version_value = 1;
+
+	uint32_t magic{magic_value};
+
+	uint32_t version{version_value};
+
+	uint32_t vendor_id{0};
+
+	uint32_t device_id{0};
+
+	uint32_t driver_version{0};
+
+	std::array<uint8_t, VK_UUID_SIZE> pipeline_cache_uuid{};
+
+	/// Aligns data_size explicitly, so that the header written to disk has no uninitialized padding
+	uint32_t reserved{0};
+
+	/// Size in bytes of the records following the header
+	uint64_t data_size{0};
+
+	static ResourceRecordHeader create(const VkPhysicalDeviceProperties &properties, uint64_t data_size);
+
+	/**
+	 * @brief Checks whether data recorded with this header can be replayed on a device
+	 * @param properties Properties of the device the data would be replayed on
+	 * @return True if the header matches the format version, device and driver
+	 */
+	bool is_compatible(const VkPhysicalDeviceProperties &properties) const;
+};
+
+static_assert(sizeof(ResourceRecordHeader) == 48, "ResourceRecordHeader must not have any padding");
+
 /**
  * @brief Writes Vulkan objects in a memory stream.
  */
 class ResourceRecord
 {
   public:
+	/**
+	 * @brief Prepends a header for the given device to the recorded data
+	 * @param properties Properties of the device the data was recorded on
+	 * @param data Recorded resources as returned by get_data()
+	 * @return The serialized data, ready to be written to disk
+	 */
+	static std::vector<uint8_t> add_header(const VkPhysicalDeviceProperties &properties, const std::vector<uint8_t> &data);
+
+	/**
+	 * @brief Validates the header of serialized data and strips it
+	 * @param properties Properties of the device the data would be replayed on
+	 * @param data Serialized data as returned by add_header()
+	 * @param records Set to the recorded resources if the header is valid
+	 * @return True if the data can be replayed on the device
+	 */
+	static bool remove_header(const VkPhysicalDeviceProperties &properties, const std::vector<uint8_t> &data, std::vector<uint8_t> &records);
+
 	void set_data(const std::vector<uint8_t> &data);
 
 	std::vector<uint8_t> get_data();
@@ -78,6 +138,9 @@ class ResourceRecord
 	void set_graphics_pipeline(size_t index, const GraphicsPipeline &graphics_pipeline);
 
   private:
+	// Resources of different types can be recorded from several threads at once
+	std::mutex stream_mutex;
+
 	std::ostringstream stream;
 
 	std::vector<size_t> shader_module_indices;
@@ -22,6 +22,9 @@
 #include "rendering/render_target.h"
 #include "resource_cache.h"
 
+#include <atomic>
+#include <thread>
+
 namespace vkb
 {
 namespace
@@ -48,9 +51,9 @@ ResourceReplay::ResourceReplay()
 	stream_resources[ResourceType::GraphicsPipeline] = std::bind(&ResourceReplay::create_graphics_pipeline, this, std::placeholders::_1, std::placeholders::_2);
 }
 
-void ResourceReplay::play(ResourceCache &resource_cache, ResourceRecord &recorder)
+void ResourceReplay::play(ResourceCache &resource_cache, const std::vector<uint8_t> &data)
 {
-	std::istringstream stream{recorder.get_stream().str()};
+	std::istringstream stream{std::string{data.begin(), data.end()}};
 
 	while (true)
 	{
@@ -77,6 +80,8 @@ void ResourceReplay::play(ResourceCache &resource_cache, ResourceRecord &recorde
 			LOGE("Replay command not supported.");
 		}
 	}
+
+	create_pending_graphics_pipelines(resource_cache);
 }
 
 void ResourceReplay::create_shader_module(ResourceCache &resource_cache, std::istringstream &stream)
@@ -198,8 +203,47 @@ void ResourceReplay::create_graphics_pipeline(ResourceCache &resource_cache, std
 	pipeline_state.set_depth_stencil_state(depth_stencil_state);
 	pipeline_state.set_color_blend_state(color_blend_state);
 
-	auto &graphics_pipeline = resource_cache.request_graphics_pipeline(pipeline_state);
+	// Only build the pipeline once the whole stream has been read
+	pending_graphics_pipelines.push_back(std::move(pipeline_state));
+}
+
+void ResourceReplay::create_pending_graphics_pipelines(ResourceCache &resource_cache)
+{
+	if (pending_graphics_pipelines.empty())
+	{
+		return;
+	}
+
+	size_t first_index = graphics_pipelines.size();
+	graphics_pipelines.resize(first_index + pending_graphics_pipelines.size());
+
+	std::atomic<size_t> next_pipeline{0};
+
+	auto build_pipelines = [&]() {
+		for (size_t i = next_pipeline++; i < pending_graphics_pipelines.size(); i = next_pipeline++)
+		{
+			graphics_pipelines[first_index + i] = &resource_cache.request_graphics_pipeline(pending_graphics_pipelines[i]);
+		}
+	};
+
+	size_t worker_count = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), pending_graphics_pipelines.size());
+
+	LOGI("Replaying {} graphics pipelines on {} threads", pending_graphics_pipelines.size(), worker_count);
+
+	std::vector<std::thread> workers;
+	for (size_t i = 1; i < worker_count; ++i)
+	{
+		workers.emplace_back(build_pipelines);
+	}
+
+	// The calling thread takes part in the work too
+	build_pipelines();
+
+	for (auto &worker : workers)
+	{
+		worker.join();
+	}
 
-	graphics_pipelines.push_back(&graphics_pipeline);
+	pending_graphics_pipelines.clear();
 }
 }        // namespace vkb
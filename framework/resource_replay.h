@@ -27,13 +27,20 @@ class ResourceCache;
 
 /**
  * @brief Reads Vulkan objects from a memory stream and creates them in the resource cache.
+ *        Graphics pipelines are independent from each other, so they are collected while
+ *        reading the stream and built afterwards on a pool of worker threads.
  */
 class ResourceReplay
 {
   public:
 	ResourceReplay();
 
-	void play(ResourceCache &resource_cache, ResourceRecord &recorder);
+	/**
+	 * @brief Creates all the resources recorded in data
+	 * @param resource_cache The cache to create the resources in
+	 * @param data Recorded resources, without header
+	 */
+	void play(ResourceCache &resource_cache, const std::vector<uint8_t> &data);
 
   protected:
 	void create_shader_module(ResourceCache &resource_cache, std::istringstream &stream);
@@ -44,6 +51,8 @@ class ResourceReplay
 
 	void create_graphics_pipeline(ResourceCache &resource_cache, std::istringstream &stream);
 
+	void create_pending_graphics_pipelines(ResourceCache &resource_cache);
+
   private:
 	using ResourceFunc = std::function<void(ResourceCache &, std::istringstream &)>;
 
@@ -56,5 +65,7 @@ class ResourceReplay
 	std::vector<const RenderPass *> render_passes;
 
 	std::vector<const GraphicsPipeline *> graphics_pipelines;
+
+	std::vector<vkb::rendering::PipelineStateC> pending_graphics_pipelines;
 };
 }        // namespace vkb
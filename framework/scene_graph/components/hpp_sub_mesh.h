@@ -20,6 +20,7 @@
 #include <core/hpp_shader_module.h>
 #include <scene_graph/components/hpp_material.h>
 #include <scene_graph/components/sub_mesh.h>
+#include <stdexcept>
 
 namespace vkb
 {
@@ -43,8 +44,10 @@ class HPPSubMesh : private vkb::sg::SubMesh
 {
   public:
 	using vkb::sg::Component::get_name;
+	using vkb::sg::SubMesh::get_first_index;
 	using vkb::sg::SubMesh::get_index_offset;
 	using vkb::sg::SubMesh::get_vertex_indices;
+	using vkb::sg::SubMesh::get_vertex_offset;
 	using vkb::sg::SubMesh::get_vertices_count;
 
 	bool get_attribute(const std::string &name, HPPVertexAttribute &attribute) const
@@ -79,13 +82,17 @@ class HPPSubMesh : private vkb::sg::SubMesh
 
 	vkb::core::BufferCpp const &get_vertex_buffer(std::string const &name) const
 	{
-		return reinterpret_cast<vkb::core::BufferCpp const &>(vkb::sg::SubMesh::vertex_buffers.at(name));
+		auto buffer = vkb::sg::SubMesh::find_vertex_buffer(name);
+		if (!buffer)
+		{
+			throw std::out_of_range("Submesh has no vertex buffer for attribute " + name);
+		}
+		return reinterpret_cast<vkb::core::BufferCpp const &>(*buffer);
 	}
 
 	vkb::core::BufferCpp const *find_vertex_buffer(std::string const &name) const
 	{
-		auto it = vkb::sg::SubMesh::vertex_buffers.find(name);
-		return it != vkb::sg::SubMesh::vertex_buffers.end() ? reinterpret_cast<vkb::core::BufferCpp const *>(&it->second) : nullptr;
+		return reinterpret_cast<vkb::core::BufferCpp const *>(vkb::sg::SubMesh::find_vertex_buffer(name));
 	}
 };
 }        // namespace components
@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2025, Arm Limited and Contributors
+/* Copyright (c) 2018-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -17,15 +17,20 @@
 
 #include "image.h"
 
+#include <atomic>
 #include <cstddef>
+#include <cstring>
 #include <mutex>
+#include <thread>
 
 #include "common/error.h"
+#include "common/resource_key.h"
 
 #define STB_IMAGE_RESIZE_IMPLEMENTATION
 #include <stb_image_resize.h>
 
 #include "common/utils.h"
+#include "filesystem/filesystem.hpp"
 #include "filesystem/legacy.h"
 #include "scene_graph/components/image/astc.h"
 #include "scene_graph/components/image/ktx.h"
@@ -374,15 +379,17 @@ void Image::coerce_format_to_srgb()
 	format = maybe_coerce_to_srgb(format);
 }
 
-std::unique_ptr<Image> Image::load(const std::string &name, const std::string &uri,
-                                   ContentType content_type)
+namespace
 {
-	std::unique_ptr<Image> image{nullptr};
+constexpr const char *decoded_image_cache_directory = "cache/decoded_images";
 
-	auto data = fs::read_asset(uri);
+constexpr size_t decoded_image_cache_header_size = 20;
 
-	// Get extension
-	auto extension = get_extension(uri);
+constexpr const char decoded_image_cache_header[decoded_image_cache_header_size] = "DecodedImageDataV01";
+
+std::unique_ptr<Image> decode(const std::string &name, const std::string &extension, const std::vector<uint8_t> &data, Image::ContentType content_type)
+{
+	std::unique_ptr<Image> image{nullptr};
 
 	if (extension == "png" || extension == "jpg")
 	{
@@ -404,5 +411,168 @@ std::unique_ptr<Image> Image::load(const std::string &name, const std::string &u
 	return image;
 }
 
+template <class T>
+void append(std::vector<uint8_t> &dst, const T &value)
+{
+	auto bytes = reinterpret_cast<const uint8_t *>(&value);
+	dst.insert(dst.end(), bytes, bytes + sizeof(T));
+}
+
+template <class T>
+T read(const std::vector<uint8_t> &src, size_t &offset)
+{
+	if (offset + sizeof(T) > src.size())
+	{
+		throw std::runtime_error{"Decoded image cache file is truncated"};
+	}
+	T value;
+	std::memcpy(&value, src.data() + offset, sizeof(T));
+	offset += sizeof(T);
+	return value;
+}
+}        // namespace
+
+std::unique_ptr<Image> Image::load(const std::string &name, const std::string &uri,
+                                   ContentType content_type)
+{
+	auto data = fs::read_asset(uri);
+
+	return decode(name, get_extension(uri), data, content_type);
+}
+
+std::unique_ptr<Image> Image::load_cached(const std::string &name, const std::string &uri, ContentType content_type)
+{
+	auto extension = get_extension(uri);
+
+	// Other formats are stored ready for upload already
+	if (extension != "png" && extension != "jpg")
+	{
+		return load(name, uri, content_type);
+	}
+
+	auto data = fs::read_asset(uri);
+
+	auto hash = hash128(data.data(), data.size(), static_cast<uint64_t>(content_type));
+
+	auto fs   = vkb::filesystem::get();
+	auto path = fmt::format("{}/{:016x}{:016x}.bin", decoded_image_cache_directory, hash[0], hash[1]);
+
+	// The cache file is a fixed size header, followed by the image description and the texels,
+	// so that the texels are read straight into the data of the image
+	const size_t header_size = decoded_image_cache_header_size + 2 * sizeof(uint64_t);
+
+	try
+	{
+		if (fs->exists(path))
+		{
+			auto header = fs->read_chunk(path, 0, header_size);
+			if (header.size() == header_size && std::memcmp(header.data(), decoded_image_cache_header, decoded_image_cache_header_size) == 0)
+			{
+				size_t offset           = decoded_image_cache_header_size;
+				auto   description_size = read<uint64_t>(header, offset);
+				auto   data_size        = read<uint64_t>(header, offset);
+
+				auto description = fs->read_chunk(path, header_size, description_size);
+				auto texels      = fs->read_chunk(path, header_size + description_size, data_size);
+				if (description.size() == description_size && texels.size() == data_size)
+				{
+					offset = 0;
+
+					auto format    = read<VkFormat>(description, offset);
+					auto layers    = read<uint32_t>(description, offset);
+					auto mip_count = read<uint32_t>(description, offset);
+
+					std::vector<Mipmap> mipmaps(mip_count);
+					for (auto &mipmap : mipmaps)
+					{
+						mipmap.level  = read<uint32_t>(description, offset);
+						mipmap.offset = read<uint32_t>(description, offset);
+						mipmap.extent = read<VkExtent3D>(description, offset);
+					}
+
+					std::vector<std::vector<VkDeviceSize>> offsets(read<uint32_t>(description, offset));
+					for (auto &layer_offsets : offsets)
+					{
+						layer_offsets.resize(read<uint32_t>(description, offset));
+						for (auto &level_offset : layer_offsets)
+						{
+							level_offset = read<VkDeviceSize>(description, offset);
+						}
+					}
+
+					auto image = std::make_unique<Image>(name, std::move(texels), std::move(mipmaps));
+					image->set_format(format);
+					image->set_layers(layers);
+					image->set_offsets(offsets);
+
+					LOGD("Loaded image {} from cache file {}", name, path);
+
+					return image;
+				}
+			}
+
+			LOGW("Decoded image cache file {} is invalid, image {} will be decoded", path, name);
+		}
+	}
+	catch (const std::runtime_error &e)
+	{
+		LOGE("ERROR loading file {} from cache. Error: <{}>", path, e.what());
+	}
+
+	auto image = decode(name, extension, data, content_type);
+	if (!image)
+	{
+		return image;
+	}
+
+	try
+	{
+		std::vector<uint8_t> description;
+		append(description, image->get_format());
+		append(description, image->get_layers());
+		append(description, to_u32(image->get_mipmaps().size()));
+		for (auto &mipmap : image->get_mipmaps())
+		{
+			append(description, mipmap.level);
+			append(description, mipmap.offset);
+			append(description, mipmap.extent);
+		}
+		append(description, to_u32(image->get_offsets().size()));
+		for (auto &layer_offsets : image->get_offsets())
+		{
+			append(description, to_u32(layer_offsets.size()));
+			for (auto level_offset : layer_offsets)
+			{
+				append(description, level_offset);
+			}
+		}
+
+		std::vector<uint8_t> file_content;
+		file_content.reserve(header_size + description.size() + image->get_data().size());
+
+		file_content.insert(file_content.end(), decoded_image_cache_header, decoded_image_cache_header + decoded_image_cache_header_size);
+		append(file_content, static_cast<uint64_t>(description.size()));
+		append(file_content, static_cast<uint64_t>(image->get_data().size()));
+		file_content.insert(file_content.end(), description.begin(), description.end());
+		file_content.insert(file_content.end(), image->get_data().begin(), image->get_data().end());
+
+		LOGI("Saving decoded image cache data to file: {}", path);
+
+		// Images with the same contents may be decoded by several jobs at once, so each writes its own
+		// temporary file and renames it, and readers only ever see a complete cache file
+		static std::atomic<uint32_t> temp_file_counter{0};
+		auto temp_path = fmt::format("{}.{:x}.{}.tmp", path, std::hash<std::thread::id>{}(std::this_thread::get_id()), temp_file_counter.fetch_add(1, std::memory_order_relaxed));
+
+		fs->write_file(temp_path, file_content);
+		fs->rename(temp_path, path);
+	}
+	catch (const std::runtime_error &e)
+	{
+		LOGE("ERROR: saving to file: {}\nError<{}>", path, e.what());
+	}
+
+	return image;
+}
+
 }        // namespace sg
 }        // namespace vkb
\ No newline at end of file
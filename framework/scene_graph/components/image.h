@@ -74,6 +74,13 @@ class Image : public Component
 
 	static std::unique_ptr<Image> load(const std::string &name, const std::string &uri, ContentType content_type);
 
+	/**
+	 * @brief Loads an image like load(), but reads PNG and JPEG images back from a cache of decoded images
+	 *        The first load decodes the image and writes its texels to the cache, keyed by a hash of the file contents.
+	 *        The cache is not bounded in size, so loaders only use it when asked to.
+	 */
+	static std::unique_ptr<Image> load_cached(const std::string &name, const std::string &uri, ContentType content_type);
+
 	virtual ~Image() = default;
 
 	virtual std::type_index get_type() override;
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2025, Arm Limited and Contributors
+/* Copyright (c) 2019-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -17,10 +17,13 @@
 
 #include "scene_graph/components/image/astc.h"
 
+#include <algorithm>
 #include <filesystem>
 #include <mutex>
 
 #include "common/error.h"
+#include "common/helpers.h"
+#include "common/job_system.h"
 #include "core/util/profiling.hpp"
 
 #include "common/glm_common.h"
@@ -177,9 +180,12 @@ void Astc::decode(BlockDim blockdim, VkExtent3D extent, const uint8_t *compresse
 		throw std::runtime_error{"Error reading astc: invalid size"};
 	}
 
-	// Allocate working state given config and thread_count
+	// Allocate working state given config and thread_count, every thread of the job system takes part in the decoding
+	auto &job_system   = JobSystem::get();
+	auto  thread_count = to_u32(job_system.get_thread_count());
+
 	astcenc_context *astc_context;
-	astcenc_context_alloc(&astc_config, 1, &astc_context);
+	astcenc_context_alloc(&astc_config, thread_count, &astc_context);
 
 	astcenc_image decoded{};
 	decoded.dim_x     = extent.width;
@@ -195,12 +201,18 @@ void Astc::decode(BlockDim blockdim, VkExtent3D extent, const uint8_t *compresse
 	void *data_ptr = static_cast<void *>(decoded_data.data());
 	decoded.data   = &data_ptr;
 
-	atscresult = astcenc_decompress_image(astc_context, compressed_data, compressed_size, &decoded, &swizzle, 0);
-	if (atscresult != ASTCENC_SUCCESS)
+	// astcenc hands out rows of blocks to the threads calling it with the same context, until all of them are decoded
+	std::vector<astcenc_error> results(thread_count, ASTCENC_SUCCESS);
+	job_system.parallel_for(thread_count, [&](size_t thread_index) {
+		results[thread_index] = astcenc_decompress_image(astc_context, compressed_data, compressed_size, &decoded, &swizzle, to_u32(thread_index));
+	});
+
+	astcenc_context_free(astc_context);
+
+	if (std::ranges::any_of(results, [](astcenc_error result) { return result != ASTCENC_SUCCESS; }))
 	{
 		throw std::runtime_error("Error decoding astc");
 	}
-	astcenc_context_free(astc_context);
 
 	set_format(VK_FORMAT_R8G8B8A8_SRGB);
 	set_width(decoded.dim_x);
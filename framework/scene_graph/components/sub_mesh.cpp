@@ -28,9 +28,14 @@ SubMesh::SubMesh(const std::string &name) :
     Component{name}
 {}
 
+uint32_t SubMesh::get_first_index() const
+{
+	return first_index;
+}
+
 vkb::core::BufferC const &SubMesh::get_index_buffer() const
 {
-	return *index_buffer;
+	return shared_index_buffer ? *shared_index_buffer : *index_buffer;
 }
 
 uint32_t SubMesh::get_index_offset() const
@@ -43,6 +48,11 @@ VkIndexType SubMesh::get_index_type() const
 	return index_type;
 }
 
+int32_t SubMesh::get_vertex_offset() const
+{
+	return vertex_offset;
+}
+
 uint32_t SubMesh::get_vertex_indices() const
 {
 	return vertex_indices;
@@ -53,6 +63,18 @@ uint32_t SubMesh::get_vertices_count() const
 	return vertices_count;
 }
 
+vkb::core::BufferC const *SubMesh::find_vertex_buffer(const std::string &name) const
+{
+	auto shared_it = shared_vertex_buffers.find(name);
+	if (shared_it != shared_vertex_buffers.end())
+	{
+		return shared_it->second.get();
+	}
+
+	auto it = vertex_buffers.find(name);
+	return it != vertex_buffers.end() ? &it->second : nullptr;
+}
+
 std::type_index SubMesh::get_type()
 {
 	return typeid(SubMesh);
@@ -53,12 +53,21 @@ class SubMesh : public Component
 	virtual std::type_index get_type() override;
 
   public:
+	uint32_t                  get_first_index() const;
 	vkb::core::BufferC const &get_index_buffer() const;
 	uint32_t                  get_index_offset() const;
 	VkIndexType               get_index_type() const;
+	int32_t                   get_vertex_offset() const;
 	uint32_t                  get_vertex_indices() const;
 	uint32_t                  get_vertices_count() const;
 
+	/**
+	 * @brief Finds the buffer holding a vertex attribute, owned by the submesh or shared with other submeshes
+	 * @param name Name of the attribute
+	 * @return The buffer, or nullptr if the submesh does not have this attribute
+	 */
+	vkb::core::BufferC const *find_vertex_buffer(const std::string &name) const;
+
 	VkIndexType index_type{};
 
 	std::uint32_t index_offset = 0;
@@ -67,10 +76,22 @@ class SubMesh : public Component
 
 	std::uint32_t vertex_indices = 0;
 
+	/// Index of the first index of the submesh in the shared index buffer
+	std::uint32_t first_index = 0;
+
+	/// Index of the first vertex of the submesh in the shared vertex buffers
+	std::int32_t vertex_offset = 0;
+
 	std::unordered_map<std::string, vkb::core::BufferC> vertex_buffers;
 
 	std::unique_ptr<vkb::core::BufferC> index_buffer;
 
+	/// Vertex buffers shared by all the submeshes of a scene loaded with packed geometry, by attribute name
+	std::unordered_map<std::string, std::shared_ptr<vkb::core::BufferC>> shared_vertex_buffers;
+
+	/// Index buffer shared by all the submeshes of a scene loaded with packed geometry
+	std::shared_ptr<vkb::core::BufferC> shared_index_buffer;
+
 	void set_attribute(const std::string &name, const VertexAttribute &attribute);
 
 	bool get_attribute(const std::string &name, VertexAttribute &attribute) const;
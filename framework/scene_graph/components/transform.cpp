@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2025, Arm Limited and Contributors
+/* Copyright (c) 2018-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -102,7 +102,18 @@ glm::mat4 Transform::get_world_matrix()
 
 void Transform::invalidate_world_matrix()
 {
+	// A dirty node only ever has dirty descendants, so there is nothing left to propagate
+	if (update_world_matrix)
+	{
+		return;
+	}
+
 	update_world_matrix = true;
+
+	for (auto child : node.get_children())
+	{
+		child->get_transform().invalidate_world_matrix();
+	}
 }
 
 void Transform::update_world_transform()
@@ -118,8 +129,7 @@ void Transform::update_world_transform()
 
 	if (parent)
 	{
-		auto &transform = parent->get_component<Transform>();
-		world_matrix    = transform.get_world_matrix() * world_matrix;
+		world_matrix = parent->get_transform().get_world_matrix() * world_matrix;
 	}
 
 	update_world_matrix = false;
@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2025, Arm Limited and Contributors
+/* Copyright (c) 2018-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -40,6 +40,8 @@ using NodeC = Node<vkb::BindingType::C>;
 
 namespace sg
 {
+class TransformHierarchy;
+
 class Transform : public Component
 {
   public:
@@ -73,10 +75,13 @@ class Transform : public Component
 	 * @brief Marks the world transform invalid if any of
 	 *        the local transform are changed or the parent
 	 *        world transform has changed.
+	 *        The world transforms of all descendants are invalidated as well.
 	 */
 	void invalidate_world_matrix();
 
   private:
+	friend class TransformHierarchy;
+
 	vkb::scene_graph::NodeC &node;
 
 	glm::vec3 translation = glm::vec3(0.0, 0.0, 0.0);
@@ -26,6 +26,7 @@
 #include "scene_graph/components/sub_mesh.h"
 #include "scene_graph/node.h"
 #include "scene_graph/scripts/animation.h"
+#include "scene_graph/transform_hierarchy.h"
 
 namespace vkb
 {
@@ -60,6 +61,18 @@ class Scene
 	void set_nodes(std::vector<std::unique_ptr<vkb::scene_graph::Node<bindingType>>> &&nodes);
 	void set_root_node(vkb::scene_graph::Node<bindingType> &node);
 
+	/**
+	 * @brief Marks the flattened transform hierarchy out of date
+	 *        Must be called when nodes are attached to or detached from the tree without going through the scene
+	 */
+	void invalidate_transform_hierarchy();
+
+	/**
+	 * @brief Recomputes the world matrices of all transforms changed since the last call
+	 *        The tree is flattened again first if its structure has changed
+	 */
+	void update_world_transforms();
+
   private:
 	template <typename T>
 	std::type_index get_type_index() const;
@@ -71,6 +84,8 @@ class Scene
 	std::string                                                                           name;
 	std::vector<std::unique_ptr<vkb::scene_graph::NodeCpp>>                               nodes;        // List of all the nodes
 	vkb::scene_graph::NodeCpp                                                            *root = nullptr;
+	vkb::sg::TransformHierarchy                                                           transform_hierarchy;
+	bool                                                                                  transform_hierarchy_valid = false;
 };
 
 using SceneC   = Scene<vkb::BindingType::C>;
@@ -94,6 +109,7 @@ inline void Scene<bindingType>::add_child(vkb::scene_graph::Node<bindingType> &c
 	{
 		root->add_child(reinterpret_cast<vkb::scene_graph::NodeCpp &>(child));
 	}
+	transform_hierarchy_valid = false;
 }
 
 template <vkb::BindingType bindingType>
@@ -123,6 +139,7 @@ inline void Scene<bindingType>::add_node(std::unique_ptr<vkb::scene_graph::Node<
 	{
 		nodes.push_back(std::unique_ptr<vkb::scene_graph::NodeCpp>(reinterpret_cast<vkb::scene_graph::NodeCpp *>(n.release())));
 	}
+	transform_hierarchy_valid = false;
 }
 
 template <vkb::BindingType bindingType>
@@ -293,6 +310,7 @@ inline void Scene<bindingType>::set_nodes(std::vector<std::unique_ptr<vkb::scene
 			nodes.push_back(std::unique_ptr<vkb::scene_graph::NodeCpp>(reinterpret_cast<vkb::scene_graph::NodeCpp *>(node.release())));
 		}
 	}
+	transform_hierarchy_valid = false;
 }
 
 template <vkb::BindingType bindingType>
@@ -306,6 +324,30 @@ inline void Scene<bindingType>::set_root_node(vkb::scene_graph::Node<bindingType
 	{
 		root = reinterpret_cast<vkb::scene_graph::NodeCpp *>(&node);
 	}
+	transform_hierarchy_valid = false;
+}
+
+template <vkb::BindingType bindingType>
+inline void Scene<bindingType>::invalidate_transform_hierarchy()
+{
+	transform_hierarchy_valid = false;
+}
+
+template <vkb::BindingType bindingType>
+inline void Scene<bindingType>::update_world_transforms()
+{
+	if (!root)
+	{
+		return;
+	}
+
+	if (!transform_hierarchy_valid)
+	{
+		transform_hierarchy.build(reinterpret_cast<vkb::scene_graph::NodeC &>(*root));
+		transform_hierarchy_valid = true;
+	}
+
+	transform_hierarchy.update();
 }
 
 }        // namespace scene_graph
@@ -1,4 +1,4 @@
-/* Copyright (c) 2020-2025, Arm Limited and Contributors
+/* Copyright (c) 2020-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -17,6 +17,10 @@
 
 #include "animation.h"
 
+#include <algorithm>
+
+#include "common/helpers.h"
+#include "common/job_system.h"
 #include "scene_graph/node.h"
 
 namespace vkb
@@ -29,13 +33,29 @@ Animation::Animation(const std::string &name) :
 }
 
 Animation::Animation(const Animation &other) :
-    channels{other.channels}
+    tracks{other.tracks},
+    key_times{other.key_times},
+    key_values{other.key_values},
+    sampled_values(other.tracks.size()),
+    sampled(other.tracks.size())
 {
 }
 
 void Animation::add_channel(vkb::scene_graph::NodeC &node, const AnimationTarget &target, const AnimationSampler &sampler)
 {
-	channels.push_back({node, target, sampler});
+	Track track{.transform   = &node.get_transform(),
+	            .target      = target,
+	            .type        = sampler.type,
+	            .first_key   = to_u32(key_times.size()),
+	            .key_count   = to_u32(sampler.inputs.size()),
+	            .first_value = to_u32(key_values.size())};
+
+	key_times.insert(key_times.end(), sampler.inputs.begin(), sampler.inputs.end());
+	key_values.insert(key_values.end(), sampler.outputs.begin(), sampler.outputs.end());
+
+	tracks.push_back(track);
+	sampled_values.emplace_back();
+	sampled.push_back(0);
 }
 
 void Animation::update(float delta_time)
@@ -46,123 +66,130 @@ void Animation::update(float delta_time)
 		current_time -= end_time;
 	}
 
-	for (auto &channel : channels)
+	if (tracks.size() <= parallel_batch_size)
+	{
+		sample_range(0, tracks.size());
+	}
+	else
+	{
+		size_t batch_count = (tracks.size() + parallel_batch_size - 1) / parallel_batch_size;
+
+		JobSystem::get().parallel_for(batch_count, [this](size_t batch) {
+			size_t begin = batch * parallel_batch_size;
+			sample_range(begin, std::min(begin + parallel_batch_size, tracks.size()));
+		});
+	}
+
+	// Several tracks may animate the same transform, so the results are written from this thread only
+	for (size_t i = 0; i < tracks.size(); ++i)
 	{
-		for (size_t i = 0; i < channel.sampler.inputs.size() - 1; ++i)
+		if (!sampled[i])
 		{
-			if ((current_time >= channel.sampler.inputs[i]) && (current_time <= channel.sampler.inputs[i + 1]))
+			continue;
+		}
+
+		auto &value = sampled_values[i];
+
+		switch (tracks[i].target)
+		{
+			case Translation:
 			{
-				float time = (current_time - channel.sampler.inputs[i]) / (channel.sampler.inputs[i + 1] - channel.sampler.inputs[i]);
-
-				auto &transform = channel.node.get_transform();
-
-				if (channel.sampler.type == AnimationType::Linear)
-				{
-					switch (channel.target)
-					{
-						case Translation:
-						{
-							transform.set_translation(glm::vec3(glm::mix(channel.sampler.outputs[i],
-							                                             channel.sampler.outputs[i + 1],
-							                                             time)));
-							break;
-						}
-						case Rotation:
-						{
-							glm::quat q1;
-							q1.x = channel.sampler.outputs[i].x;
-							q1.y = channel.sampler.outputs[i].y;
-							q1.z = channel.sampler.outputs[i].z;
-							q1.w = channel.sampler.outputs[i].w;
-
-							glm::quat q2;
-							q2.x = channel.sampler.outputs[i + 1].x;
-							q2.y = channel.sampler.outputs[i + 1].y;
-							q2.z = channel.sampler.outputs[i + 1].z;
-							q2.w = channel.sampler.outputs[i + 1].w;
-
-							transform.set_rotation(glm::normalize(glm::slerp(q1, q2, time)));
-							break;
-						}
-
-						case Scale:
-						{
-							transform.set_scale(glm::vec3(glm::mix(channel.sampler.outputs[i],
-							                                       channel.sampler.outputs[i + 1],
-							                                       time)));
-						}
-					}
-				}
-				else if (channel.sampler.type == AnimationType::Step)
-				{
-					switch (channel.target)
-					{
-						case Translation:
-						{
-							transform.set_translation(glm::vec3(channel.sampler.outputs[i]));
-							break;
-						}
-						case Rotation:
-						{
-							glm::quat q1;
-							q1.x = channel.sampler.outputs[i].x;
-							q1.y = channel.sampler.outputs[i].y;
-							q1.z = channel.sampler.outputs[i].z;
-							q1.w = channel.sampler.outputs[i].w;
-
-							transform.set_rotation(glm::normalize(q1));
-							break;
-						}
-
-						case Scale:
-						{
-							transform.set_scale(glm::vec3(channel.sampler.outputs[i]));
-						}
-					}
-				}
-				else if (channel.sampler.type == AnimationType::CubicSpline)
-				{
-					float delta = channel.sampler.inputs[i + 1] - channel.sampler.inputs[i];
-
-					glm::vec4 p0 = channel.sampler.outputs[i * 3 + 1];              // Starting point
-					glm::vec4 p1 = channel.sampler.outputs[(i + 1) * 3 + 1];        // Ending point
-
-					glm::vec4 m0 = delta * channel.sampler.outputs[i * 3 + 2];              // Delta time * out tangent
-					glm::vec4 m1 = delta * channel.sampler.outputs[(i + 1) * 3 + 0];        // Delta time * in tangent of next point
-
-					// This equation is taken from the GLTF 2.0 specification Appendix C (https://github.com/KhronosGroup/glTF/tree/main/specification/2.0#appendix-c-spline-interpolation)
-					glm::vec4 result = (2.0f * glm::pow(time, 3.0f) - 3.0f * glm::pow(time, 2.0f) + 1.0f) * p0 + (glm::pow(time, 3.0f) - 2.0f * glm::pow(time, 2.0f) + time) * m0 + (-2.0f * glm::pow(time, 3.0f) + 3.0f * glm::pow(time, 2.0f)) * p1 + (glm::pow(time, 3.0f) - glm::pow(time, 2.0f)) * m1;
-
-					auto &transform = channel.node.get_transform();
-
-					switch (channel.target)
-					{
-						case Translation:
-						{
-							transform.set_translation(glm::vec3(result));
-							break;
-						}
-						case Rotation:
-						{
-							glm::quat q1;
-							q1.x = result.x;
-							q1.y = result.y;
-							q1.z = result.z;
-							q1.w = result.w;
-
-							transform.set_rotation(glm::normalize(q1));
-							break;
-						}
-
-						case Scale:
-						{
-							transform.set_scale(glm::vec3(result));
-						}
-					}
-				}
+				tracks[i].transform->set_translation(glm::vec3(value));
+				break;
 			}
+			case Rotation:
+			{
+				tracks[i].transform->set_rotation(glm::normalize(glm::quat(value.w, value.x, value.y, value.z)));
+				break;
+			}
+			case Scale:
+			{
+				tracks[i].transform->set_scale(glm::vec3(value));
+				break;
+			}
+		}
+	}
+}
+
+void Animation::sample_range(size_t begin, size_t end)
+{
+	for (size_t i = begin; i < end; ++i)
+	{
+		sampled[i] = sample(tracks[i], sampled_values[i]);
+	}
+}
+
+bool Animation::sample(Track &track, glm::vec4 &value)
+{
+	if (track.key_count < 2)
+	{
+		return false;
+	}
+
+	const float     *times  = key_times.data() + track.first_key;
+	const glm::vec4 *values = key_values.data() + track.first_value;
+	uint32_t         last   = track.key_count - 1;
+
+	if ((current_time < times[0]) || (current_time > times[last]))
+	{
+		return false;
+	}
+
+	// Active key is i, such that times[i] <= current_time <= times[i + 1]
+	uint32_t i = track.cursor;
+
+	if ((i >= last) || (current_time < times[i]) || ((current_time > times[i + 1]) && ((i + 1 == last) || (current_time > times[i + 2]))))
+	{
+		// The animation looped or skipped more than a key, find the key again
+		i = to_u32(std::upper_bound(times, times + track.key_count, current_time) - times);
+		i = std::clamp(i, 1u, last) - 1;
+	}
+	else if (current_time > times[i + 1])
+	{
+		++i;
+	}
+
+	track.cursor = i;
+
+	float time = (current_time - times[i]) / (times[i + 1] - times[i]);
+
+	if (track.type == AnimationType::Linear)
+	{
+		if (track.target == Rotation)
+		{
+			glm::quat q1(values[i].w, values[i].x, values[i].y, values[i].z);
+			glm::quat q2(values[i + 1].w, values[i + 1].x, values[i + 1].y, values[i + 1].z);
+
+			glm::quat q = glm::slerp(q1, q2, time);
+			value       = glm::vec4(q.x, q.y, q.z, q.w);
+		}
+		else
+		{
+			value = glm::mix(values[i], values[i + 1], time);
 		}
 	}
+	else if (track.type == AnimationType::Step)
+	{
+		value = values[i];
+	}
+	else if (track.type == AnimationType::CubicSpline)
+	{
+		float delta = times[i + 1] - times[i];
+
+		glm::vec4 p0 = values[i * 3 + 1];              // Starting point
+		glm::vec4 p1 = values[(i + 1) * 3 + 1];        // Ending point
+
+		glm::vec4 m0 = delta * values[i * 3 + 2];              // Delta time * out tangent
+		glm::vec4 m1 = delta * values[(i + 1) * 3 + 0];        // Delta time * in tangent of next point
+
+		float time_2 = time * time;
+		float time_3 = time_2 * time;
+
+		// This equation is taken from the GLTF 2.0 specification Appendix C (https://github.com/KhronosGroup/glTF/tree/main/specification/2.0#appendix-c-spline-interpolation)
+		value = (2.0f * time_3 - 3.0f * time_2 + 1.0f) * p0 + (time_3 - 2.0f * time_2 + time) * m0 + (-2.0f * time_3 + 3.0f * time_2) * p1 + (time_3 - time_2) * m1;
+	}
+
+	return true;
 }
 
 void Animation::update_times(float new_start_time, float new_end_time)
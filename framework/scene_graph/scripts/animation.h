@@ -1,4 +1,4 @@
-/* Copyright (c) 2020-2025, Arm Limited and Contributors
+/* Copyright (c) 2020-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
@@ -62,6 +63,14 @@ struct AnimationChannel
 	AnimationSampler sampler;
 };
 
+/**
+ * @brief Animates the transforms of nodes from keyframes.
+ *
+ * The keyframes of all channels are stored back to back in shared arrays of times and values, and each channel
+ * keeps a cursor on the key it found during the previous update. As time moves forward by less than a key per
+ * frame, finding the active key usually costs a comparison or two, with a binary search when the animation loops
+ * or jumps. Channels are sampled in parallel batches on the job system, then the results are written to the transforms.
+ */
 class Animation : public Script
 {
   public:
@@ -76,7 +85,50 @@ class Animation : public Script
 	void add_channel(vkb::scene_graph::NodeC &node, const AnimationTarget &target, const AnimationSampler &sampler);
 
   private:
-	std::vector<AnimationChannel> channels;
+	/// Channels are only split across threads for animations with more channels than this
+	static constexpr size_t parallel_batch_size = 256;
+
+	/// A channel, with the keys of its sampler stored in key_times and key_values
+	struct Track
+	{
+		Transform *transform;
+
+		AnimationTarget target;
+
+		AnimationType type;
+
+		uint32_t first_key;
+
+		uint32_t key_count;
+
+		/// First value of the sampler in key_values, cubic splines have three values per key
+		uint32_t first_value;
+
+		/// Key at which the current time was found by the last update
+		uint32_t cursor{0};
+	};
+
+	/**
+	 * @brief Samples a track at the current time, moving its cursor to the active key
+	 * @return False if the current time is outside of the keys of the track
+	 */
+	bool sample(Track &track, glm::vec4 &value);
+
+	void sample_range(size_t begin, size_t end);
+
+	std::vector<Track> tracks;
+
+	/// Times of the keys of all tracks
+	std::vector<float> key_times;
+
+	/// Values of the keys of all tracks, rotations are stored as (x, y, z, w)
+	std::vector<glm::vec4> key_values;
+
+	/// Value of each track sampled by the current update
+	std::vector<glm::vec4> sampled_values;
+
+	/// Whether each track was sampled by the current update
+	std::vector<uint8_t> sampled;
 
 	float current_time{0.0f};
 
@@ -0,0 +1,142 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "transform_hierarchy.h"
+
+#include <algorithm>
+
+#include "common/job_system.h"
+#include "scene_graph/components/transform.h"
+#include "scene_graph/node.h"
+
+namespace vkb
+{
+namespace sg
+{
+void TransformHierarchy::build(vkb::scene_graph::NodeC &root)
+{
+	clear();
+
+	transforms.push_back(&root.get_transform());
+	parents.push_back(no_parent);
+	level_offsets.push_back(0);
+
+	// Breadth first traversal, one level at a time
+	size_t level_begin = 0;
+	while (level_begin < transforms.size())
+	{
+		size_t level_end = transforms.size();
+
+		for (size_t i = level_begin; i < level_end; ++i)
+		{
+			for (auto child : transforms[i]->get_node().get_children())
+			{
+				transforms.push_back(&child->get_transform());
+				parents.push_back(static_cast<uint32_t>(i));
+			}
+		}
+
+		level_offsets.push_back(transforms.size());
+		level_begin = level_end;
+	}
+
+	local_matrices.resize(transforms.size(), glm::mat4(1.0f));
+	world_matrices.resize(transforms.size(), glm::mat4(1.0f));
+
+	// Everything is computed on the first update
+	dirty.resize(transforms.size(), 0);
+	for (auto transform : transforms)
+	{
+		transform->update_world_matrix = true;
+	}
+}
+
+void TransformHierarchy::clear()
+{
+	transforms.clear();
+	parents.clear();
+	level_offsets.clear();
+	local_matrices.clear();
+	world_matrices.clear();
+	dirty.clear();
+}
+
+void TransformHierarchy::update()
+{
+	for (size_t level = 0; level + 1 < level_offsets.size(); ++level)
+	{
+		size_t begin = level_offsets[level];
+		size_t end   = level_offsets[level + 1];
+
+		if (end - begin <= parallel_batch_size)
+		{
+			update_range(begin, end);
+			continue;
+		}
+
+		size_t batch_count = (end - begin + parallel_batch_size - 1) / parallel_batch_size;
+
+		JobSystem::get().parallel_for(batch_count, [this, begin, end](size_t batch) {
+			size_t batch_begin = begin + batch * parallel_batch_size;
+			update_range(batch_begin, std::min(batch_begin + parallel_batch_size, end));
+		});
+	}
+}
+
+size_t TransformHierarchy::size() const
+{
+	return transforms.size();
+}
+
+void TransformHierarchy::update_range(size_t begin, size_t end)
+{
+	for (size_t i = begin; i < end; ++i)
+	{
+		auto    *transform = transforms[i];
+		uint32_t parent    = parents[i];
+
+		bool parent_dirty = parent != no_parent && dirty[parent];
+
+		dirty[i] = transform->update_world_matrix || parent_dirty;
+
+		if (!dirty[i])
+		{
+			continue;
+		}
+
+		local_matrices[i] = transform->get_matrix();
+
+		if (parent == no_parent)
+		{
+			world_matrices[i] = local_matrices[i];
+		}
+		else if (parent_dirty)
+		{
+			world_matrices[i] = world_matrices[parent] * local_matrices[i];
+		}
+		else
+		{
+			// A clean parent may have been updated lazily through Transform::get_world_matrix(), so its stored matrix is the reference
+			world_matrices[i] = transforms[parent]->world_matrix * local_matrices[i];
+		}
+
+		transform->world_matrix        = world_matrices[i];
+		transform->update_world_matrix = false;
+	}
+}
+}        // namespace sg
+}        // namespace vkb
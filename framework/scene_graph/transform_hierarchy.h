@@ -0,0 +1,94 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "common/glm_common.h"
+#include "common/vk_common.h"
+
+namespace vkb
+{
+namespace scene_graph
+{
+template <vkb::BindingType bindingType>
+class Node;
+using NodeC = Node<vkb::BindingType::C>;
+}        // namespace scene_graph
+
+namespace sg
+{
+class Transform;
+
+/**
+ * @brief Flat view of the transforms of a node tree, used to update all world matrices in one pass.
+ *
+ * The transforms are stored breadth first, so that each depth level of the tree is a contiguous range
+ * and every parent comes before its children. Local and world matrices live in arrays indexed the same way.
+ * An update walks the levels in order: a node is recomputed if it or its parent is dirty, reading the world
+ * matrix of its parent from the previous level. Nodes of a level do not depend on each other, so large levels
+ * are split across the job system.
+ *
+ * The flat view has to be built again whenever nodes are added to or removed from the tree.
+ */
+class TransformHierarchy
+{
+  public:
+	/**
+	 * @brief Flattens the tree below a root node
+	 * @param root The root node of the tree, included in the hierarchy
+	 */
+	void build(vkb::scene_graph::NodeC &root);
+
+	void clear();
+
+	/**
+	 * @brief Computes the world matrices of all dirty transforms and of their descendants
+	 *        The results are written back to the transforms, so Transform::get_world_matrix() returns them without recomputing
+	 */
+	void update();
+
+	/// @return The number of transforms in the hierarchy
+	size_t size() const;
+
+  private:
+	static constexpr uint32_t no_parent = ~0u;
+
+	/// Nodes are only split across threads for levels bigger than this
+	static constexpr size_t parallel_batch_size = 512;
+
+	void update_range(size_t begin, size_t end);
+
+	std::vector<Transform *> transforms;
+
+	/// Index of the parent of each transform, no_parent for the root
+	std::vector<uint32_t> parents;
+
+	/// Start of each depth level, followed by the total size
+	std::vector<size_t> level_offsets;
+
+	std::vector<glm::mat4> local_matrices;
+
+	std::vector<glm::mat4> world_matrices;
+
+	/// Whether the world matrix of a transform was recomputed by the last update
+	std::vector<uint8_t> dirty;
+};
+}        // namespace sg
+}        // namespace vkb
@@ -0,0 +1,69 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "culling_stats_provider.h"
+
+#include "rendering/render_context.h"
+
+namespace vkb
+{
+CullingStatsProvider::CullingStatsProvider(std::set<StatIndex> &requested_stats, vkb::rendering::CullingStats &culling_stats) :
+    culling_stats{culling_stats},
+    prev_visible{culling_stats.visible.load(std::memory_order_relaxed)},
+    prev_culled{culling_stats.culled.load(std::memory_order_relaxed)}
+{
+	for (auto index : {StatIndex::visible_draws, StatIndex::culled_draws})
+	{
+		if (requested_stats.erase(index) > 0)
+		{
+			supported_stats.insert(index);
+		}
+	}
+}
+
+bool CullingStatsProvider::is_available(StatIndex index) const
+{
+	return supported_stats.count(index) > 0;
+}
+
+StatsProvider::Counters CullingStatsProvider::sample(float /*delta_time*/)
+{
+	uint64_t visible = culling_stats.visible.load(std::memory_order_relaxed);
+	uint64_t culled  = culling_stats.culled.load(std::memory_order_relaxed);
+
+	Counters res;
+	for (auto index : supported_stats)
+	{
+		switch (index)
+		{
+			case StatIndex::visible_draws:
+				res[index].result = static_cast<double>(visible - prev_visible);
+				break;
+			case StatIndex::culled_draws:
+				res[index].result = static_cast<double>(culled - prev_culled);
+				break;
+			default:
+				break;
+		}
+	}
+
+	prev_visible = visible;
+	prev_culled  = culled;
+
+	return res;
+}
+}        // namespace vkb
@@ -0,0 +1,80 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "resource_cache_stats_provider.h"
+
+#include "hpp_resource_cache.h"
+
+namespace vkb
+{
+ResourceCacheStatsProvider::ResourceCacheStatsProvider(std::set<StatIndex> &requested_stats, HPPResourceCache &resource_cache) :
+    resource_cache{resource_cache}
+{
+	for (auto index : {StatIndex::resource_cache_hit_ratio, StatIndex::resource_cache_objects, StatIndex::resource_cache_bytes, StatIndex::pipeline_compile_queue})
+	{
+		if (requested_stats.erase(index) > 0)
+		{
+			supported_stats.insert(index);
+		}
+	}
+}
+
+bool ResourceCacheStatsProvider::is_available(StatIndex index) const
+{
+	return supported_stats.count(index) > 0;
+}
+
+StatsProvider::Counters ResourceCacheStatsProvider::sample(float /*delta_time*/)
+{
+	ResourceCacheStats stats = resource_cache.get_stats();
+
+	uint64_t hits     = stats.hits - prev_hits;
+	uint64_t requests = hits + stats.misses - prev_misses;
+
+	// Keep the previous ratio over samples without any request
+	if (requests > 0)
+	{
+		hit_ratio = static_cast<double>(hits) / static_cast<double>(requests);
+	}
+
+	prev_hits   = stats.hits;
+	prev_misses = stats.misses;
+
+	Counters res;
+	for (auto index : supported_stats)
+	{
+		switch (index)
+		{
+			case StatIndex::resource_cache_hit_ratio:
+				res[index].result = hit_ratio;
+				break;
+			case StatIndex::resource_cache_objects:
+				res[index].result = static_cast<double>(stats.live_count);
+				break;
+			case StatIndex::resource_cache_bytes:
+				res[index].result = static_cast<double>(stats.bytes);
+				break;
+			case StatIndex::pipeline_compile_queue:
+				res[index].result = static_cast<double>(stats.pending_pipelines);
+				break;
+			default:
+				break;
+		}
+	}
+	return res;
+}
+}        // namespace vkb
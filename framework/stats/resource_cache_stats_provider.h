@@ -0,0 +1,64 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "stats_provider.h"
+#include <set>
+
+namespace vkb
+{
+class HPPResourceCache;
+
+/**
+ * @brief Supplies the stats of the resource cache of a device: hit ratio, number of cached objects and their host memory
+ */
+class ResourceCacheStatsProvider : public StatsProvider
+{
+  public:
+	/**
+	 * @brief Constructs a ResourceCacheStatsProvider
+	 * @param requested_stats Set of stats to be collected. Supported stats will be removed from the set.
+	 * @param resource_cache The resource cache to sample
+	 */
+	ResourceCacheStatsProvider(std::set<StatIndex> &requested_stats, HPPResourceCache &resource_cache);
+
+	/**
+	 * @brief Checks if this provider can supply the given enabled stat
+	 * @param index The stat index
+	 * @return True if the stat is available, false otherwise
+	 */
+	bool is_available(StatIndex index) const override;
+
+	/**
+	 * @brief Retrieve a new sample set
+	 * @param delta_time Time since last sample
+	 */
+	Counters sample(float delta_time) override;
+
+  private:
+	HPPResourceCache &resource_cache;
+
+	std::set<StatIndex> supported_stats;
+
+	/// Counters at the previous sample, the hit ratio is computed over the requests made since then
+	uint64_t prev_hits{0};
+	uint64_t prev_misses{0};
+
+	double hit_ratio{1.0};
+};
+}        // namespace vkb
@@ -22,7 +22,9 @@
 #include <future>
 
 #include "core/util/profiling.hpp"
+#include "stats/culling_stats_provider.h"
 #include "stats/frame_time_stats_provider.h"
+#include "stats/resource_cache_stats_provider.h"
 #include "stats/stats_common.h"
 #include "stats/stats_provider.h"
 #include "stats/vulkan_stats_provider.h"
@@ -243,6 +245,18 @@ static inline char const *to_string(StatIndex index)
 			return "External Read Bytes (MiB/s)";
 		case StatIndex::gpu_ext_write_bytes:
 			return "External Write Bytes (MiB/s)";
+		case StatIndex::resource_cache_hit_ratio:
+			return "Resource Cache Hit Ratio (%)";
+		case StatIndex::resource_cache_objects:
+			return "Resource Cache Objects";
+		case StatIndex::resource_cache_bytes:
+			return "Resource Cache Memory (KiB)";
+		case StatIndex::pipeline_compile_queue:
+			return "Pipelines Being Built";
+		case StatIndex::visible_draws:
+			return "Visible Draws";
+		case StatIndex::culled_draws:
+			return "Culled Draws";
 		default:
 			return nullptr;
 	}
@@ -499,6 +513,8 @@ inline void Stats<bindingType>::request_stats(const std::set<StatIndex> &wanted_
 	// All supported stats will be removed from the given 'stats' set by the provider's constructor
 	// so subsequent providers only see requests for stats that aren't already supported.
 	providers.emplace_back(std::make_unique<vkb::FrameTimeStatsProvider>(stats));
+	providers.emplace_back(std::make_unique<vkb::ResourceCacheStatsProvider>(stats, render_context.get_device().get_resource_cache()));
+	providers.emplace_back(std::make_unique<vkb::CullingStatsProvider>(stats, render_context.get_culling_stats()));
 #ifdef VK_USE_PLATFORM_ANDROID_KHR
 	providers.emplace_back(std::make_unique<HWCPipeStatsProvider>(stats));
 #endif
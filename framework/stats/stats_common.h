@@ -63,6 +63,14 @@ enum class StatIndex
 	gpu_ext_read_bytes,
 	gpu_ext_write_bytes,
 	gpu_tex_cycles,
+
+	resource_cache_hit_ratio,
+	resource_cache_objects,
+	resource_cache_bytes,
+	pipeline_compile_queue,
+
+	visible_draws,
+	culled_draws,
 };
 
 struct StatIndexHash
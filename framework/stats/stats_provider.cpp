@@ -1,4 +1,4 @@
-/* Copyright (c) 2020-2023, Broadcom Inc. and Contributors
+/* Copyright (c) 2020-2026, Broadcom Inc. and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -54,6 +54,14 @@ std::map<StatIndex, StatGraphData> StatsProvider::default_graph_map{
     {StatIndex::gpu_ext_write_stalls,  {"External Write Stalls",                       "{:4.1f} M/s",   static_cast<float>(1e-6)}},
     {StatIndex::gpu_ext_read_bytes,    {"External Read Bytes",                         "{:4.1f} MiB/s", 1.0f / (1024.0f * 1024.0f)}},
     {StatIndex::gpu_ext_write_bytes,   {"External Write Bytes",                        "{:4.1f} MiB/s", 1.0f / (1024.0f * 1024.0f)}},
+
+    {StatIndex::resource_cache_hit_ratio, {"Resource Cache Hit Ratio",                  "{:3.1f}%",      100.0f,                       true,     100.0f}},
+    {StatIndex::resource_cache_objects,   {"Resource Cache Objects",                    "{:4.0f}"}},
+    {StatIndex::resource_cache_bytes,     {"Resource Cache Memory",                     "{:4.1f} KiB",   1.0f / 1024.0f}},
+    {StatIndex::pipeline_compile_queue,   {"Pipeline Compile Queue",                    "{:4.0f}"}},
+
+    {StatIndex::visible_draws,            {"Visible Draws",                             "{:4.0f}"}},
+    {StatIndex::culled_draws,             {"Culled Draws",                              "{:4.0f}"}},
     // clang-format on
 };
 
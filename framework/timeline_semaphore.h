@@ -0,0 +1,91 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <limits>
+
+#include "common/helpers.h"
+#include "common/vk_common.h"
+
+namespace vkb
+{
+namespace core
+{
+template <vkb::BindingType bindingType>
+class Device;
+using DeviceC = Device<vkb::BindingType::C>;
+}        // namespace core
+
+/**
+ * @brief A timeline semaphore tracking the submissions to one queue.
+ *
+ * Each submission signals a new value, greater than all the values signaled before. Work is known to be
+ * complete once the semaphore reached the value of its submission, so frames and resources are retired
+ * by comparing values instead of waiting on and resetting a fence per submission.
+ * Requires the timelineSemaphore feature of Vulkan 1.2 or VK_KHR_timeline_semaphore.
+ */
+class TimelineSemaphore
+{
+  public:
+	TimelineSemaphore(vkb::core::DeviceC &device);
+
+	TimelineSemaphore(const TimelineSemaphore &) = delete;
+
+	TimelineSemaphore(TimelineSemaphore &&other) = delete;
+
+	~TimelineSemaphore();
+
+	TimelineSemaphore &operator=(const TimelineSemaphore &) = delete;
+
+	TimelineSemaphore &operator=(TimelineSemaphore &&) = delete;
+
+	VkSemaphore get_handle() const;
+
+	/**
+	 * @brief Reserves the value to be signaled by the next submission
+	 * @return A value greater than all the values requested before
+	 */
+	uint64_t request_value();
+
+	/// @return The last value returned by request_value()
+	uint64_t get_last_value() const;
+
+	/**
+	 * @brief Checks without blocking whether the GPU has signaled a value
+	 * @param value A value returned by request_value()
+	 */
+	bool is_signaled(uint64_t value);
+
+	/**
+	 * @brief Waits for the GPU to signal a value
+	 * @param value A value returned by request_value()
+	 * @param timeout Time to wait in nanoseconds
+	 */
+	VkResult wait(uint64_t value, uint64_t timeout = std::numeric_limits<uint64_t>::max());
+
+  private:
+	vkb::core::DeviceC &device;
+
+	VkSemaphore handle{VK_NULL_HANDLE};
+
+	uint64_t last_value{0};
+
+	/// Value the GPU was last seen to have signaled, avoids querying the semaphore for values known to be complete
+	uint64_t signaled_value{0};
+};
+}        // namespace vkb
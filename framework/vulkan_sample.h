@@ -276,8 +276,9 @@ class VulkanSample : public vkb::Application
 	 * @brief Loads the scene
 	 *
 	 * @param path The path of the glTF file
+	 * @param packed_geometry If true, the geometry of all submeshes is packed into shared buffers, see GLTFLoader::set_packed_geometry
 	 */
-	void load_scene(const std::string &path);
+	void load_scene(const std::string &path, bool packed_geometry = false);
 
 	/**
 	 * @brief Additional sample initialization
@@ -685,7 +686,25 @@ inline void VulkanSample<bindingType>::draw_renderpass_impl(vkb::core::CommandBu
 
 	if (gui)
 	{
-		gui->draw(command_buffer);
+		if (command_buffer.get_subpass_contents() == vk::SubpassContents::eSecondaryCommandBuffers)
+		{
+			// The last subpass was recorded in parallel by the render pipeline, so the GUI must be executed from a secondary command buffer too
+			auto &command_pool = command_buffer.get_command_pool();
+			auto &queue        = command_buffer.get_device().get_queue(command_pool.get_queue_family_index(), 0);
+			auto  gui_command_buffer =
+			    command_pool.get_render_frame()->get_command_pool(queue, command_pool.get_reset_mode()).request_command_buffer(vk::CommandBufferLevel::eSecondary);
+
+			gui_command_buffer->begin(vk::CommandBufferUsageFlagBits::eOneTimeSubmit | vk::CommandBufferUsageFlagBits::eRenderPassContinue, &command_buffer);
+			set_viewport_and_scissor_impl(*gui_command_buffer, render_target.get_extent());
+			gui->draw(*gui_command_buffer);
+			gui_command_buffer->end();
+
+			command_buffer.execute_commands(*gui_command_buffer);
+		}
+		else
+		{
+			gui->draw(command_buffer);
+		}
 	}
 
 	command_buffer.get_handle().endRenderPass();
@@ -1186,9 +1205,13 @@ inline void VulkanSample<bindingType>::input_event(const InputEvent &input_event
 }
 
 template <vkb::BindingType bindingType>
-inline void VulkanSample<bindingType>::load_scene(const std::string &path)
+inline void VulkanSample<bindingType>::load_scene(const std::string &path, bool packed_geometry)
 {
 	vkb::HPPGLTFLoader loader(*device);
+	loader.set_packed_geometry(packed_geometry);
+
+	// Benchmark runs load the same scenes over and over, so they keep the decoded images on disk
+	loader.set_decoded_image_cache(lock_simulation_speed);
 
 	scene = loader.read_scene_from_file(path);
 
@@ -1762,6 +1785,9 @@ inline void VulkanSample<bindingType>::update_scene(float delta_time)
 				animation->update(delta_time);
 			}
 		}
+
+		// Update world matrices of all moved nodes in one pass
+		scene->update_world_transforms();
 	}
 }
 
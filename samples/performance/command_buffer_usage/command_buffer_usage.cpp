@@ -20,6 +20,7 @@
 #include <algorithm>
 #include <numeric>
 
+#include "common/job_system.h"
 #include "core/debug.h"
 #include "core/device.h"
 #include "core/pipeline_layout.h"
@@ -352,20 +353,14 @@ void CommandBufferUsage::ForwardSubpassSecondary::draw(vkb::core::CommandBufferC
 	std::vector<std::shared_ptr<vkb::core::CommandBufferC>> secondary_command_buffers;
 	avg_draws_per_buffer = (state.secondary_cmd_buf_count > 0) ? static_cast<float>(opaque_submeshes) / state.secondary_cmd_buf_count : 0;
 
-	if (state.thread_count != thread_pool.size())
-	{
-		thread_pool.resize(state.thread_count);
-	}
-
 	if (use_secondary_command_buffers)
 	{
-		std::vector<std::future<std::shared_ptr<vkb::core::CommandBufferC>>> secondary_cmd_buf_futures;
-
 		// Save the number of draws left over, these will be distributed among the first buffers
 		uint32_t draws_per_buffer = vkb::to_u32(std::floor(avg_draws_per_buffer));
 		uint32_t remainder_draws  = opaque_submeshes % state.secondary_cmd_buf_count;
 		uint32_t mesh_start       = 0;
 
+		std::vector<std::pair<uint32_t, uint32_t>> mesh_ranges;
 		for (uint32_t cb_count = 0; cb_count < state.secondary_cmd_buf_count; cb_count++)
 		{
 			// Latter command buffers may contain fewer draws
@@ -376,32 +371,30 @@ void CommandBufferUsage::ForwardSubpassSecondary::draw(vkb::core::CommandBufferC
 				remainder_draws--;
 			}
 
-			if (state.multi_threading)
-			{
-				auto fut = thread_pool.push(std::bind(&CommandBufferUsage::ForwardSubpassSecondary::record_draw_secondary,
-				                                      this,
-				                                      std::ref(primary_command_buffer),
-				                                      std::cref(sorted_opaque_nodes),
-				                                      mesh_start,
-				                                      mesh_end,
-				                                      cb_count,
-				                                      std::placeholders::_1));
-
-				secondary_cmd_buf_futures.push_back(std::move(fut));
-			}
-			else
-			{
-				secondary_command_buffers.push_back(record_draw_secondary(primary_command_buffer, sorted_opaque_nodes, mesh_start, mesh_end, cb_count));
-			}
+			mesh_ranges.emplace_back(mesh_start, mesh_end);
 
 			mesh_start = mesh_end;
 		}
 
+		secondary_command_buffers.resize(state.secondary_cmd_buf_count);
+
 		if (state.multi_threading)
 		{
-			for (auto &fut : secondary_cmd_buf_futures)
+			// Each job records every thread_count-th command buffer with the resources of its own thread index,
+			// so the jobs never share a command pool even if the JobSystem runs them on the same worker
+			vkb::JobSystem::get().parallel_for(state.thread_count, [&](size_t thread_index) {
+				for (size_t cb_count = thread_index; cb_count < mesh_ranges.size(); cb_count += state.thread_count)
+				{
+					secondary_command_buffers[cb_count] = record_draw_secondary(
+					    primary_command_buffer, sorted_opaque_nodes, mesh_ranges[cb_count].first, mesh_ranges[cb_count].second, vkb::to_u32(cb_count), thread_index);
+				}
+			});
+		}
+		else
+		{
+			for (uint32_t cb_count = 0; cb_count < state.secondary_cmd_buf_count; cb_count++)
 			{
-				secondary_command_buffers.push_back(fut.get());
+				secondary_command_buffers[cb_count] = record_draw_secondary(primary_command_buffer, sorted_opaque_nodes, mesh_ranges[cb_count].first, mesh_ranges[cb_count].second, cb_count);
 			}
 		}
 	}
@@ -26,86 +26,6 @@
 #include "scene_graph/components/perspective_camera.h"
 #include "vulkan_sample.h"
 
-class ThreadPool
-{
-  public:
-	explicit ThreadPool() :
-	    stop_flag(false)
-	{}
-
-	~ThreadPool()
-	{
-		shutdown();
-	}
-
-	template <class F, class... Args>
-	auto push(F &&f, Args &&...args) -> std::future<std::invoke_result_t<F, Args..., size_t>>
-	{
-		using return_type                 = std::invoke_result_t<F, Args..., size_t>;
-		auto                     task_ptr = std::make_shared<std::packaged_task<return_type(size_t)>>(std::bind(std::forward<F>(f), std::forward<Args>(args)..., std::placeholders::_1));
-		std::future<return_type> res      = task_ptr->get_future();
-		{
-			std::unique_lock<std::mutex> lock(queue_mutex);
-			tasks.emplace([task_ptr](size_t thread_index) { (*task_ptr)(thread_index); });
-		}
-		condition.notify_one();
-		return res;
-	}
-
-	void resize(size_t thread_count)
-	{
-		if (thread_count != workers.size())
-		{
-			shutdown();
-
-			for (size_t i = 0; i < thread_count; ++i)
-			{
-				workers.emplace_back([this, i] {
-					size_t thread_index = i;
-					while (true)
-					{
-						std::function<void(size_t)> task;
-						{
-							std::unique_lock<std::mutex> lock(queue_mutex);
-							condition.wait(lock, [this] { return stop_flag || !tasks.empty(); });
-							if (stop_flag && tasks.empty())
-								return;
-							task = std::move(tasks.front());
-							tasks.pop();
-						}
-						task(thread_index);
-					}
-				});
-			}
-		}
-	}
-
-	void shutdown()
-	{
-		{
-			std::unique_lock<std::mutex> lock(queue_mutex);
-			stop_flag = true;
-		}
-		condition.notify_all();
-		for (auto &worker : workers)
-			worker.join();
-		workers.clear();
-		stop_flag = false;
-	}
-
-	size_t size() const
-	{
-		return workers.size();
-	}
-
-  private:
-	std::vector<std::thread>                workers;
-	std::queue<std::function<void(size_t)>> tasks;
-	std::mutex                              queue_mutex;
-	std::condition_variable                 condition;
-	std::atomic<bool>                       stop_flag;
-};
-
 /**
  * @brief Sample showing the use of secondary command buffers for
  *        multi-threaded recording, as well as the different
@@ -205,8 +125,6 @@ class CommandBufferUsage : public vkb::VulkanSampleC
 		ForwardSubpassSecondaryState state{};
 
 		float avg_draws_per_buffer{0};
-
-		ThreadPool thread_pool;
 	};
 
   private:
@@ -288,6 +288,9 @@ std::unique_ptr<vkb::VulkanSampleC> create_constant_data()
 
 void ConstantData::ConstantDataSubpass::prepare()
 {
+	// The pipeline layout depends on the selected method, so the draw records are compiled again
+	invalidate_draw_records();
+
 	// Build all shader variance upfront
 	auto &device = get_render_context().get_device();
 
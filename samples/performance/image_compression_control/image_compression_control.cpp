@@ -50,6 +50,14 @@ void ImageCompressionControlSample::request_gpu_features(vkb::core::PhysicalDevi
 	{
 		REQUEST_OPTIONAL_FEATURE(gpu, VkPhysicalDeviceImageCompressionControlSwapchainFeaturesEXT, imageCompressionControlSwapchain);
 	}
+
+	synchronization2_supported = REQUEST_OPTIONAL_FEATURE(gpu, VkPhysicalDeviceVulkan13Features, synchronization2);
+}
+
+uint32_t ImageCompressionControlSample::get_api_version() const
+{
+	// The postprocessing pipeline records its barriers with vkCmdPipelineBarrier2 if synchronization2 is supported
+	return VK_API_VERSION_1_3;
 }
 
 void ImageCompressionControlSample::request_instance_extensions(std::unordered_map<std::string, vkb::RequestMode> &requested_extensions) const
@@ -81,11 +89,6 @@ bool ImageCompressionControlSample::prepare(const vkb::ApplicationOptions &optio
 	render_pipeline->set_load_store(scene_load_store);
 	set_render_pipeline(std::move(render_pipeline));
 
-	// Post-processing pass (chromatic aberration)
-	vkb::ShaderSource postprocessing_vs("postprocessing/postprocessing.vert.spv");
-	postprocessing_pipeline = std::make_unique<vkb::PostProcessingPipeline>(get_render_context(), std::move(postprocessing_vs));
-	postprocessing_pipeline->add_pass().add_subpass(vkb::ShaderSource("postprocessing/chromatic_aberration.frag.spv"));
-
 	// Trigger recreation of Swapchain and render targets, with initial compression parameters
 	update_render_targets();
 
@@ -452,13 +455,44 @@ void ImageCompressionControlSample::render(vkb::core::CommandBufferC &command_bu
 	 *    reduces bandwidth but may hide the bandwidth benefits of compression,
 	 *    the focus of this sample.
 	 */
+	auto &render_target = get_render_context().get_active_frame().get_render_target();
+	if (!postprocessing_pipeline || postprocessing_render_target->get_extent().width != render_target.get_extent().width ||
+	    postprocessing_render_target->get_extent().height != render_target.get_extent().height)
+	{
+		create_postprocessing_pipeline(render_target.get_extent());
+	}
+
 	auto &postprocessing_pass = postprocessing_pipeline->get_pass(0);
 	postprocessing_pass.set_uniform_data(sin(elapsed_time));
 
+	// The chromatic aberration pass renders to the transient target, so the color output of the scene is sampled explicitly
 	auto &postprocessing_subpass = postprocessing_pass.get_subpass(0);
-	postprocessing_subpass.bind_sampled_image("color_sampler", static_cast<int>(Attachments::Color));
+	postprocessing_subpass.bind_sampled_image("color_sampler", vkb::core::SampledImage(static_cast<uint32_t>(Attachments::Color), &render_target));
 
-	postprocessing_pipeline->draw(command_buffer, get_render_context().get_active_frame().get_render_target());
+	postprocessing_pipeline->draw(command_buffer, render_target);
+}
+
+void ImageCompressionControlSample::create_postprocessing_pipeline(VkExtent2D extent)
+{
+	// The transient render target of a previous pipeline may still be in use
+	get_device().wait_idle();
+
+	vkb::ShaderSource postprocessing_vs("postprocessing/postprocessing.vert.spv");
+	postprocessing_pipeline = std::make_unique<vkb::PostProcessingPipeline>(get_render_context(), std::move(postprocessing_vs));
+	postprocessing_pipeline->set_synchronization2(synchronization2_supported);
+
+	// The output of the chromatic aberration pass is only read by the vignette pass
+	postprocessing_render_target = &postprocessing_pipeline->add_transient_render_target(extent, {color_image_info.format}, 0, 1);
+
+	// Post-processing pass (chromatic aberration)
+	postprocessing_pipeline->add_pass()
+	    .set_render_target(postprocessing_render_target)
+	    .add_subpass(vkb::ShaderSource("postprocessing/chromatic_aberration.frag.spv"));
+
+	// Post-processing pass (vignette), rendering to the Swapchain
+	postprocessing_pipeline->add_pass()
+	    .add_subpass(vkb::ShaderSource("postprocessing/vignette.frag.spv"))
+	    .bind_sampled_image("color_sampler", vkb::core::SampledImage(0, postprocessing_render_target));
 }
 
 namespace
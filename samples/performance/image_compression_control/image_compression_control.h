@@ -51,6 +51,8 @@ class ImageCompressionControlSample : public vkb::VulkanSampleC
 	void draw_gui() override;
 
   protected:
+	uint32_t get_api_version() const override;
+
 	void request_instance_extensions(std::unordered_map<std::string, vkb::RequestMode> &requested_extensions) const override;
 
   private:
@@ -75,9 +77,28 @@ class ImageCompressionControlSample : public vkb::VulkanSampleC
 	 * to the output of the forward rendering pass. Since this color output needs to
 	 * be saved to main memory, it is a simple use case for compressing the image and
 	 * saving bandwidth and memory footprint, as illustrated in the sample.
+	 * A second pass darkens the corners of the image. The image between both passes is
+	 * a transient render target of the pipeline, so it shares its memory with the other
+	 * transient targets of the pipeline.
 	 */
 	std::unique_ptr<vkb::PostProcessingPipeline> postprocessing_pipeline{};
 
+	/**
+	 * @brief Creates the postprocessing pipeline and its transient render target
+	 * @param extent The extent of the Swapchain images
+	 */
+	void create_postprocessing_pipeline(VkExtent2D extent);
+
+	/**
+	 * @brief Image between the chromatic aberration and the vignette passes
+	 */
+	vkb::rendering::RenderTargetC *postprocessing_render_target{nullptr};
+
+	/**
+	 * @brief Whether the barriers of the postprocessing passes are recorded with synchronization2
+	 */
+	bool synchronization2_supported{false};
+
 	/**
 	 * @brief Load/store operations of the forward rendering pass attachments
 	 * Used to specify that the color output must be stored to main memory.
@@ -37,6 +37,8 @@ MultithreadingRenderPasses::MultithreadingRenderPasses()
 	config.insert<vkb::IntSetting>(1, multithreading_mode, 1);
 
 	config.insert<vkb::IntSetting>(2, multithreading_mode, 2);
+
+	config.insert<vkb::IntSetting>(3, multithreading_mode, 3);
 }
 
 void MultithreadingRenderPasses::request_gpu_features(vkb::core::PhysicalDeviceC &gpu)
@@ -88,9 +90,25 @@ bool MultithreadingRenderPasses::prepare(const vkb::ApplicationOptions &options)
 	return true;
 }
 
+void MultithreadingRenderPasses::create_render_context()
+{
+	// Headless benchmark runs have nothing to present, so they render to a ring of offscreen frames
+	// which keeps several frames in flight without a swapchain
+	if (lock_simulation_speed && window->get_window_mode() == vkb::Window::Mode::Headless)
+	{
+		auto render_context = std::make_unique<vkb::rendering::RenderContextC>(get_device(), VK_NULL_HANDLE, *window);
+		render_context->set_offscreen_frame_count(OFFSCREEN_FRAME_COUNT);
+		set_render_context(std::move(render_context));
+	}
+	else
+	{
+		VulkanSample::create_render_context();
+	}
+}
+
 void MultithreadingRenderPasses::prepare_render_context()
 {
-	get_render_context().prepare(2);
+	get_render_context().prepare(RECORDING_THREAD_COUNT);
 }
 
 std::unique_ptr<vkb::rendering::RenderTargetC> MultithreadingRenderPasses::create_shadow_render_target(uint32_t size)
@@ -162,7 +180,7 @@ void MultithreadingRenderPasses::update(float delta_time)
 void MultithreadingRenderPasses::draw_gui()
 {
 	const bool landscape = reinterpret_cast<vkb::sg::PerspectiveCamera *>(camera)->get_aspect_ratio() > 1.0f;
-	uint32_t   lines     = landscape ? 2 : 4;
+	uint32_t   lines     = landscape ? 2 : 5;
 
 	get_gui().show_options_window(
 	    [this, landscape]() {
@@ -181,6 +199,11 @@ void MultithreadingRenderPasses::draw_gui()
 			    ImGui::SameLine();
 		    }
 		    ImGui::RadioButton("Secondary Buffers", &multithreading_mode, static_cast<int>(MultithreadingMode::SecondaryCommandBuffers));
+		    if (landscape)
+		    {
+			    ImGui::SameLine();
+		    }
+		    ImGui::RadioButton("Parallel Subpasses", &multithreading_mode, static_cast<int>(MultithreadingMode::ParallelSubpasses));
 	    },
 	    lines);
 }
@@ -193,9 +216,14 @@ std::vector<std::shared_ptr<vkb::core::CommandBufferC>>
 
 	std::vector<std::shared_ptr<vkb::core::CommandBufferC>> command_buffers;
 
-	// Resources are requested from pools for thread #1 in shadow pass if multithreading is used
-	auto use_multithreading = multithreading_mode != static_cast<int>(MultithreadingMode::None);
-	shadow_subpass->set_thread_index(use_multithreading ? 1 : 0);
+	// Resources are requested from pools for thread #1 in shadow pass if it is recorded in its own command buffer
+	auto use_separate_command_buffers = multithreading_mode == static_cast<int>(MultithreadingMode::PrimaryCommandBuffers) ||
+	                                    multithreading_mode == static_cast<int>(MultithreadingMode::SecondaryCommandBuffers);
+	shadow_subpass->set_thread_index(use_separate_command_buffers ? 1 : 0);
+
+	// The draws of the shadow pass are split into secondary command buffers recorded in parallel by the job system,
+	// each one using the pools of the thread of its index. The main pass draws the GUI inline after its subpass, so it is not split.
+	shadow_render_pipeline->set_parallel_recording(multithreading_mode == static_cast<int>(MultithreadingMode::ParallelSubpasses));
 
 	switch (multithreading_mode)
 	{
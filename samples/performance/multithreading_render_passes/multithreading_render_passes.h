@@ -41,6 +41,7 @@ class MultithreadingRenderPasses : public vkb::VulkanSampleC
 		None                    = 0,
 		PrimaryCommandBuffers   = 1,
 		SecondaryCommandBuffers = 2,
+		ParallelSubpasses       = 3,
 	};
 
 	MultithreadingRenderPasses();
@@ -104,6 +105,8 @@ class MultithreadingRenderPasses : public vkb::VulkanSampleC
 	};
 
   private:
+	virtual void create_render_context() override;
+
 	virtual void prepare_render_context() override;
 
 	std::unique_ptr<vkb::rendering::RenderTargetC> create_shadow_render_target(uint32_t size);
@@ -120,6 +123,17 @@ class MultithreadingRenderPasses : public vkb::VulkanSampleC
 
 	const uint32_t SHADOWMAP_RESOLUTION{1024};
 
+	/**
+	 * @brief Number of threads the render frames have resource pools for
+	 *        The draws of the shadow pass are split into at most as many secondary command buffers
+	 */
+	const size_t RECORDING_THREAD_COUNT{4};
+
+	/**
+	 * @brief Number of offscreen render frames in flight in headless benchmark runs
+	 */
+	const uint32_t OFFSCREEN_FRAME_COUNT{3};
+
 	std::vector<std::unique_ptr<vkb::rendering::RenderTargetC>> shadow_render_targets;
 
 	/**
@@ -20,8 +20,7 @@
 #include <imgui_internal.h>
 
 #include "core/device.h"
-#include "core/util/logging.hpp"
-#include "filesystem/legacy.h"
+#include "filesystem/filesystem.hpp"
 #include "gui.h"
 #include "platform/window.h"
 
@@ -29,6 +28,14 @@
 #include "scene_graph/node.h"
 #include "stats/stats.h"
 
+namespace
+{
+vkb::filesystem::Path get_pipeline_cache_path()
+{
+	return vkb::filesystem::get()->temp_directory() / "pipeline_cache.data";
+}
+}        // namespace
+
 PipelineCache::PipelineCache()
 {
 	auto &config = get_configuration();
@@ -39,40 +46,42 @@ PipelineCache::PipelineCache()
 
 PipelineCache::~PipelineCache()
 {
-	if (pipeline_cache != VK_NULL_HANDLE)
+	if (has_device())
 	{
-		/* Get size of pipeline cache */
-		size_t   size{};
-		VkResult result = vkGetPipelineCacheData(get_device().get_handle(), pipeline_cache, &size, nullptr);
-		if (result == VK_SUCCESS && size > 0)
-		{
-			/* Get data of pipeline cache */
-			std::vector<uint8_t> data(size);
-			result = vkGetPipelineCacheData(get_device().get_handle(), pipeline_cache, &size, data.data());
-			if (result == VK_SUCCESS && size > 0)
-			{
-				if (size < data.size())
-				{
-					data.resize(size);
-				}
-
-				/* Write pipeline cache data to a file in binary format */
-				vkb::fs::write_temp(data, "pipeline_cache.data");
-			}
-		}
+		vkb::ResourceCache &resource_cache = get_device().get_resource_cache();
 
-		if (result != VK_SUCCESS || size == 0)
+		if (enable_pipeline_cache)
 		{
-			LOGE("Detected Vulkan error: {}, pipeline cache not saved.", vkb::to_string(result));
+			// Write pipeline cache data to a file in binary format, once the pipelines being built are done
+			resource_cache.save_pipeline_cache(get_pipeline_cache_path());
 		}
 
-		/* Destroy Vulkan pipeline cache */
-		vkDestroyPipelineCache(get_device().get_handle(), pipeline_cache, nullptr);
+		resource_cache.serialize_to_file(vkb::filesystem::get()->temp_directory() / "cache.data");
 	}
+}
 
-	if (has_device())
+PipelineCache::ForwardSubpassFallback::ForwardSubpassFallback(vkb::rendering::RenderContextC &render_context,
+                                                              vkb::ShaderSource             &&vertex_source,
+                                                              vkb::ShaderSource             &&fragment_source,
+                                                              vkb::scene_graph::SceneC       &scene,
+                                                              vkb::sg::Camera                &camera) :
+    vkb::rendering::subpasses::ForwardSubpassC{render_context, std::move(vertex_source), std::move(fragment_source), scene, camera}
+{
+}
+
+void PipelineCache::ForwardSubpassFallback::draw_submesh_command(vkb::core::CommandBufferC &command_buffer, vkb::sg::SubMesh &sub_mesh)
+{
+	vkb::rendering::subpasses::ForwardSubpassC::draw_submesh_command(command_buffer, sub_mesh);
+
+	// The render pass is only known by the pipeline state once a draw has been recorded with it
+	vkb::ResourceCache &resource_cache = get_render_context().get_device().get_resource_cache();
+
+	if (resource_cache.find_fallback_pipeline(command_buffer.get_pipeline_state()) == VK_NULL_HANDLE)
 	{
-		vkb::fs::write_temp(get_device().get_resource_cache().serialize(), "cache.data");
+		// The first draw of a pipeline layout is skipped while its pipeline is queued,
+		// building it here lets the next draws of that layout fall back to it
+		auto pipeline_state = command_buffer.get_pipeline_state();
+		resource_cache.register_fallback_pipeline(pipeline_state);
 	}
 }
 
@@ -83,44 +92,13 @@ bool PipelineCache::prepare(const vkb::ApplicationOptions &options)
 		return false;
 	}
 
-	/* Try to read pipeline cache file if exists */
-	std::vector<uint8_t> pipeline_data;
-
-	try
-	{
-		pipeline_data = vkb::fs::read_temp("pipeline_cache.data");
-	}
-	catch (std::runtime_error &ex)
-	{
-		LOGW("No pipeline cache found. {}", ex.what());
-	}
-
-	/* Add initial pipeline cache data from the cached file */
-	VkPipelineCacheCreateInfo create_info{VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO};
-	create_info.initialDataSize = pipeline_data.size();
-	create_info.pInitialData    = pipeline_data.data();
-
-	/* Create Vulkan pipeline cache */
-	VK_CHECK(vkCreatePipelineCache(get_device().get_handle(), &create_info, nullptr, &pipeline_cache));
-
 	vkb::ResourceCache &resource_cache = get_device().get_resource_cache();
 
-	// Use pipeline cache to store pipelines
-	resource_cache.set_pipeline_cache(pipeline_cache);
-
-	std::vector<uint8_t> data_cache;
-
-	try
-	{
-		data_cache = vkb::fs::read_temp("cache.data");
-	}
-	catch (std::runtime_error &ex)
-	{
-		LOGW("No data cache found. {}", ex.what());
-	}
+	/* Create the Vulkan pipeline cache used to store pipelines, with the data of a previous run if it exists */
+	resource_cache.load_pipeline_cache(get_pipeline_cache_path());
 
 	// Build all pipelines from a previous run
-	resource_cache.warmup(data_cache);
+	resource_cache.warmup_from_file(vkb::filesystem::get()->temp_directory() / "cache.data");
 
 	get_stats().request_stats({vkb::StatIndex::frame_times});
 
@@ -138,7 +116,7 @@ bool PipelineCache::prepare(const vkb::ApplicationOptions &options)
 
 	vkb::ShaderSource vert_shader("base.vert.spv");
 	vkb::ShaderSource frag_shader("base.frag.spv");
-	auto              scene_subpass = std::make_unique<vkb::rendering::subpasses::ForwardSubpassC>(get_render_context(), std::move(vert_shader), std::move(frag_shader), get_scene(), *camera);
+	auto              scene_subpass = std::make_unique<ForwardSubpassFallback>(get_render_context(), std::move(vert_shader), std::move(frag_shader), get_scene(), *camera);
 
 	auto render_pipeline = std::make_unique<vkb::rendering::RenderPipelineC>();
 	render_pipeline->add_subpass(std::move(scene_subpass));
@@ -158,12 +136,13 @@ void PipelineCache::draw_gui()
 
 			    if (enable_pipeline_cache)
 			    {
-				    // Use pipeline cache to store pipelines
-				    resource_cache.set_pipeline_cache(pipeline_cache);
+				    // Use pipeline cache to store pipelines, starting from the data saved when it was disabled
+				    resource_cache.load_pipeline_cache(get_pipeline_cache_path());
 			    }
 			    else
 			    {
-				    // Don't use a pipeline cache
+				    // Don't use a pipeline cache, the resource cache destroys the one it owns so its data is saved first
+				    resource_cache.save_pipeline_cache(get_pipeline_cache_path());
 				    resource_cache.set_pipeline_cache(VK_NULL_HANDLE);
 			    }
 		    }
@@ -185,8 +164,18 @@ void PipelineCache::draw_gui()
 		    {
 			    ImGui::Text("Pipeline rebuild frame time: N/A");
 		    }
+
+		    if (ImGui::Checkbox("Async compilation", &enable_async_compilation))
+		    {
+			    // Draws whose pipeline is being built use the fallback pipeline of their layout instead of waiting
+			    get_device().get_resource_cache().set_async_pipeline_compilation(enable_async_compilation);
+		    }
+
+		    ImGui::SameLine();
+
+		    ImGui::Text("Pipelines being built: %zu", get_device().get_resource_cache().get_pipeline_compile_queue_depth());
 	    },
-	    /* lines = */ 2);
+	    /* lines = */ 3);
 }
 
 void PipelineCache::update(float delta_time)
@@ -20,6 +20,7 @@
 #include "common/utils.h"
 #include "common/vk_common.h"
 #include "rendering/render_pipeline.h"
+#include "rendering/subpasses/forward_subpass.h"
 #include "scene_graph/components/camera.h"
 #include "vulkan_sample.h"
 
@@ -37,15 +38,32 @@ class PipelineCache : public vkb::VulkanSampleC
 
 	virtual void update(float delta_time) override;
 
+	/**
+	 * @brief This subpass registers the first pipeline built for each pipeline layout as a fallback,
+	 *        which the draws of that layout use while their own pipelines are compiled asynchronously
+	 */
+	class ForwardSubpassFallback : public vkb::rendering::subpasses::ForwardSubpassC
+	{
+	  public:
+		ForwardSubpassFallback(vkb::rendering::RenderContextC &render_context,
+		                       vkb::ShaderSource             &&vertex_source,
+		                       vkb::ShaderSource             &&fragment_source,
+		                       vkb::scene_graph::SceneC       &scene,
+		                       vkb::sg::Camera                &camera);
+
+	  private:
+		virtual void draw_submesh_command(vkb::core::CommandBufferC &command_buffer, vkb::sg::SubMesh &sub_mesh) override;
+	};
+
   private:
 	vkb::sg::Camera *camera{nullptr};
 
-	VkPipelineCache pipeline_cache{VK_NULL_HANDLE};
-
 	ImVec2 button_size{150, 30};
 
 	bool enable_pipeline_cache{true};
 
+	bool enable_async_compilation{false};
+
 	bool record_frame_time_next_frame{false};
 
 	float rebuild_pipelines_frame_time_ms{0.0f};
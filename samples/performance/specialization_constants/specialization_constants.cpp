@@ -67,6 +67,8 @@ bool SpecializationConstants::prepare(const vkb::ApplicationOptions &options)
 
 void SpecializationConstants::ForwardSubpassCustomLights::prepare()
 {
+	invalidate_draw_records();
+
 	auto &device = get_render_context().get_device();
 	for (auto &mesh : get_meshes())
 	{
@@ -23,7 +23,9 @@
 #include "rendering/pipeline_state.h"
 #include "rendering/render_context.h"
 #include "rendering/render_pipeline.h"
+#include "rendering/subpasses/clustered_lighting_subpass.h"
 #include "rendering/subpasses/geometry_subpass.h"
+#include "rendering/subpasses/indirect_geometry_subpass.h"
 #include "rendering/subpasses/lighting_subpass.h"
 #include "scene_graph/node.h"
 
@@ -52,6 +54,25 @@ Subpasses::Subpasses()
 	config.insert<vkb::IntSetting>(3, configs[Config::GBufferSize].value, 1);
 }
 
+uint32_t Subpasses::get_api_version() const
+{
+	// The indirect draws with a count read from a buffer use the Vulkan 1.2 entry point
+	return VK_API_VERSION_1_2;
+}
+
+void Subpasses::request_gpu_features(vkb::core::PhysicalDeviceC &gpu)
+{
+	auto &features = gpu.get_features();
+
+	if (features.multiDrawIndirect && features.drawIndirectFirstInstance)
+	{
+		gpu.get_mutable_requested_features().multiDrawIndirect         = VK_TRUE;
+		gpu.get_mutable_requested_features().drawIndirectFirstInstance = VK_TRUE;
+
+		gpu_culling_supported = REQUEST_OPTIONAL_FEATURE(gpu, VkPhysicalDeviceVulkan12Features, drawIndirectCount);
+	}
+}
+
 std::unique_ptr<vkb::rendering::RenderTargetC> Subpasses::create_render_target(vkb::core::Image &&swapchain_image)
 {
 	auto &device = swapchain_image.get_device();
@@ -113,7 +134,14 @@ bool Subpasses::prepare(const vkb::ApplicationOptions &options)
 	std::set<VkImageUsageFlagBits> usage = {VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT};
 	get_render_context().update_swapchain(usage);
 
-	load_scene("scenes/sponza/Sponza01.gltf");
+	if (!gpu_culling_supported)
+	{
+		LOGW("Indirect draw features not supported, the geometry is culled on the CPU only");
+		configs[Config::GeometryCulling].options = {"CPU"};
+	}
+
+	// Packed geometry lets the indirect geometry subpass draw many submeshes with a single indirect draw
+	load_scene("scenes/sponza/Sponza01.gltf", true);
 
 	get_scene().clear_components<vkb::sg::Light>();
 
@@ -199,6 +227,38 @@ void Subpasses::update(float delta_time)
 		}
 	}
 
+	// Check whether the user switched between CPU and GPU culling of the geometry
+	if (configs[Config::GeometryCulling].value != last_geometry_culling)
+	{
+		LOGI("Changing geometry culling");
+		last_geometry_culling = configs[Config::GeometryCulling].value;
+
+		// Reset frames, as their command buffers may still use the current subpasses
+		for (auto &frame : get_render_context().get_render_frames())
+		{
+			frame->reset();
+		}
+
+		render_pipeline          = create_one_renderpass_two_subpasses();
+		geometry_render_pipeline = create_geometry_renderpass();
+	}
+
+	// Check whether the user switched between shading all lights and shading the lights of each cluster
+	if (configs[Config::Lighting].value != last_lighting)
+	{
+		LOGI("Changing lighting");
+		last_lighting = configs[Config::Lighting].value;
+
+		// Reset frames, as their command buffers may still use the current subpasses
+		for (auto &frame : get_render_context().get_render_frames())
+		{
+			frame->reset();
+		}
+
+		render_pipeline          = create_one_renderpass_two_subpasses();
+		lighting_render_pipeline = create_lighting_renderpass();
+	}
+
 	// Check whether the user switched the attachment or the G-buffer option
 	if (configs[Config::TransientAttachments].value != last_transient_attachment ||
 	    configs[Config::GBufferSize].value != last_g_buffer_size)
@@ -297,25 +357,66 @@ void Subpasses::draw_gui()
 	    /* lines = */ vkb::to_u32(lines));
 }
 
-std::unique_ptr<vkb::rendering::RenderPipelineC> Subpasses::create_one_renderpass_two_subpasses()
+std::unique_ptr<vkb::rendering::SubpassC> Subpasses::create_geometry_subpass()
 {
-	// Geometry subpass
-	auto geometry_vs   = vkb::ShaderSource{"deferred/geometry.vert.spv"};
-	auto geometry_fs   = vkb::ShaderSource{"deferred/geometry.frag.spv"};
-	auto scene_subpass = std::make_unique<vkb::rendering::subpasses::GeometrySubpassC>(
-	    get_render_context(), std::move(geometry_vs), std::move(geometry_fs), get_scene(), *camera);
+	auto geometry_fs = vkb::ShaderSource{"deferred/geometry.frag.spv"};
+
+	std::unique_ptr<vkb::rendering::SubpassC> scene_subpass;
+	if (configs[Config::GeometryCulling].value == 0 || !gpu_culling_supported)
+	{
+		auto geometry_vs = vkb::ShaderSource{"deferred/geometry.vert.spv"};
+		scene_subpass    = std::make_unique<vkb::rendering::subpasses::GeometrySubpassC>(
+            get_render_context(), std::move(geometry_vs), std::move(geometry_fs), get_scene(), *camera);
+	}
+	else
+	{
+		// The instances are culled by a compute pass, which writes the indirect draws of the subpass
+		auto geometry_vs      = vkb::ShaderSource{"indirect_geometry/geometry.vert.spv"};
+		auto indirect_subpass = std::make_unique<vkb::rendering::subpasses::IndirectGeometrySubpassC>(
+		    get_render_context(), std::move(geometry_vs), std::move(geometry_fs), get_scene(), *camera);
+
+		// Only the visible draws of each batch are read by the GPU
+		indirect_subpass->set_draw_indirect_count(true);
+		scene_subpass = std::move(indirect_subpass);
+	}
 
 	// Outputs are depth, albedo, and normal
 	scene_subpass->set_output_attachments({1, 2, 3});
 
-	// Lighting subpass
-	auto lighting_vs      = vkb::ShaderSource{"deferred/lighting.vert.spv"};
-	auto lighting_fs      = vkb::ShaderSource{"deferred/lighting.frag.spv"};
-	auto lighting_subpass = std::make_unique<vkb::LightingSubpass>(get_render_context(), std::move(lighting_vs), std::move(lighting_fs), *camera, get_scene());
+	return scene_subpass;
+}
+
+std::unique_ptr<vkb::rendering::SubpassC> Subpasses::create_lighting_subpass()
+{
+	auto lighting_vs = vkb::ShaderSource{"deferred/lighting.vert.spv"};
+
+	std::unique_ptr<vkb::rendering::SubpassC> lighting_subpass;
+	if (configs[Config::Lighting].value == 0)
+	{
+		auto lighting_fs = vkb::ShaderSource{"deferred/lighting.frag.spv"};
+		lighting_subpass = std::make_unique<vkb::LightingSubpass>(get_render_context(), std::move(lighting_vs), std::move(lighting_fs), *camera, get_scene());
+	}
+	else
+	{
+		// The lights are assigned to clusters by a compute pass, each pixel is only shaded by the lights of its cluster
+		auto lighting_fs = vkb::ShaderSource{"deferred/clustered_lighting.frag.spv"};
+		lighting_subpass = std::make_unique<vkb::ClusteredLightingSubpass>(get_render_context(), std::move(lighting_vs), std::move(lighting_fs), *camera, get_scene());
+	}
 
 	// Inputs are depth, albedo, and normal from the geometry subpass
 	lighting_subpass->set_input_attachments({1, 2, 3});
 
+	return lighting_subpass;
+}
+
+std::unique_ptr<vkb::rendering::RenderPipelineC> Subpasses::create_one_renderpass_two_subpasses()
+{
+	// Geometry subpass
+	auto scene_subpass = create_geometry_subpass();
+
+	// Lighting subpass
+	auto lighting_subpass = create_lighting_subpass();
+
 	// Create subpasses pipeline
 	std::vector<std::unique_ptr<vkb::rendering::SubpassC>> subpasses{};
 	subpasses.push_back(std::move(scene_subpass));
@@ -333,13 +434,7 @@ std::unique_ptr<vkb::rendering::RenderPipelineC> Subpasses::create_one_renderpas
 std::unique_ptr<vkb::rendering::RenderPipelineC> Subpasses::create_geometry_renderpass()
 {
 	// Geometry subpass
-	auto geometry_vs   = vkb::ShaderSource{"deferred/geometry.vert.spv"};
-	auto geometry_fs   = vkb::ShaderSource{"deferred/geometry.frag.spv"};
-	auto scene_subpass = std::make_unique<vkb::rendering::subpasses::GeometrySubpassC>(
-	    get_render_context(), std::move(geometry_vs), std::move(geometry_fs), get_scene(), *camera);
-
-	// Outputs are depth, albedo, and normal
-	scene_subpass->set_output_attachments({1, 2, 3});
+	auto scene_subpass = create_geometry_subpass();
 
 	// Create geometry pipeline
 	std::vector<std::unique_ptr<vkb::rendering::SubpassC>> scene_subpasses{};
@@ -357,12 +452,8 @@ std::unique_ptr<vkb::rendering::RenderPipelineC> Subpasses::create_geometry_rend
 std::unique_ptr<vkb::rendering::RenderPipelineC> Subpasses::create_lighting_renderpass()
 {
 	// Lighting subpass
-	auto lighting_vs      = vkb::ShaderSource{"deferred/lighting.vert.spv"};
-	auto lighting_fs      = vkb::ShaderSource{"deferred/lighting.frag.spv"};
-	auto lighting_subpass = std::make_unique<vkb::LightingSubpass>(get_render_context(), std::move(lighting_vs), std::move(lighting_fs), *camera, get_scene());
+	auto lighting_subpass = create_lighting_subpass();
 
-	// Inputs are depth, albedo, and normal from the geometry subpass
-	lighting_subpass->set_input_attachments({1, 2, 3});
 	// Create lighting pipeline
 	std::vector<std::unique_ptr<vkb::rendering::SubpassC>> lighting_subpasses{};
 	lighting_subpasses.push_back(std::move(lighting_subpass));
@@ -404,13 +495,38 @@ void draw_pipeline(vkb::core::CommandBufferC       &command_buffer,
 	command_buffer.end_render_pass();
 }
 
+/**
+ * @brief Records the compute passes of the subpasses of a pipeline, i.e. the GPU culling of the geometry
+ *        and the culling of the clustered lights, if they are used
+ *        They must be recorded before the render pass of the pipeline begins
+ */
+void record_compute_passes(vkb::core::CommandBufferC &command_buffer, vkb::rendering::RenderPipelineC &render_pipeline)
+{
+	for (auto &subpass : render_pipeline.get_subpasses())
+	{
+		if (auto indirect_subpass = dynamic_cast<vkb::rendering::subpasses::IndirectGeometrySubpassC *>(subpass.get()))
+		{
+			indirect_subpass->record_culling(command_buffer);
+		}
+		else if (auto clustered_subpass = dynamic_cast<vkb::ClusteredLightingSubpass *>(subpass.get()))
+		{
+			clustered_subpass->record_light_culling(command_buffer);
+		}
+	}
+}
+
 void Subpasses::draw_subpasses(vkb::core::CommandBufferC &command_buffer, vkb::rendering::RenderTargetC &render_target)
 {
+	record_compute_passes(command_buffer, *render_pipeline);
+
 	draw_pipeline(command_buffer, render_target, *render_pipeline, &get_gui());
 }
 
 void Subpasses::draw_renderpasses(vkb::core::CommandBufferC &command_buffer, vkb::rendering::RenderTargetC &render_target)
 {
+	record_compute_passes(command_buffer, *geometry_render_pipeline);
+	record_compute_passes(command_buffer, *lighting_render_pipeline);
+
 	// First render pass (no gui)
 	draw_pipeline(command_buffer, render_target, *geometry_render_pipeline);
 
@@ -47,6 +47,13 @@ class Subpasses : public vkb::VulkanSampleC
 	void draw_gui() override;
 
   private:
+	virtual uint32_t get_api_version() const override;
+
+	/**
+	 * @brief Requests the features needed to cull and draw the geometry on the GPU, see IndirectGeometrySubpass
+	 */
+	virtual void request_gpu_features(vkb::core::PhysicalDeviceC &gpu) override;
+
 	virtual void prepare_render_context() override;
 
 	/**
@@ -55,6 +62,16 @@ class Subpasses : public vkb::VulkanSampleC
 	 */
 	virtual void draw_renderpass(vkb::core::CommandBufferC &command_buffer, vkb::rendering::RenderTargetC &render_target) override;
 
+	/**
+	 * @return A geometry subpass drawing the scene from the CPU, or culling and drawing it on the GPU, based on the sample selection
+	 */
+	std::unique_ptr<vkb::rendering::SubpassC> create_geometry_subpass();
+
+	/**
+	 * @return A lighting subpass iterating over all the lights, or over the lights of the cluster of each pixel, based on the sample selection
+	 */
+	std::unique_ptr<vkb::rendering::SubpassC> create_lighting_subpass();
+
 	/**
 	 * @return A good pipeline
 	 */
@@ -106,7 +123,9 @@ class Subpasses : public vkb::VulkanSampleC
 		{
 			RenderTechnique,
 			TransientAttachments,
-			GBufferSize
+			GBufferSize,
+			GeometryCulling,
+			Lighting
 		} type;
 
 		/// Used as label by the GUI
@@ -122,6 +141,11 @@ class Subpasses : public vkb::VulkanSampleC
 	uint16_t last_render_technique{0};
 	uint16_t last_transient_attachment{0};
 	uint16_t last_g_buffer_size{0};
+	uint16_t last_geometry_culling{0};
+	uint16_t last_lighting{0};
+
+	/// Whether the multiDrawIndirect, drawIndirectFirstInstance and drawIndirectCount features are enabled, otherwise the geometry is culled on the CPU
+	bool gpu_culling_supported{false};
 
 	VkFormat          albedo_format{VK_FORMAT_R8G8B8A8_UNORM};
 	VkFormat          normal_format{VK_FORMAT_A2B10G10R10_UNORM_PACK32};
@@ -139,6 +163,14 @@ class Subpasses : public vkb::VulkanSampleC
 	    {/* config      = */ Config::GBufferSize,
 	     /* description = */ "G-Buffer size",
 	     /* options     = */ {"128-bit", "More"},
+	     /* value       = */ 0},
+	    {/* config      = */ Config::GeometryCulling,
+	     /* description = */ "Geometry culling",
+	     /* options     = */ {"CPU", "GPU"},
+	     /* value       = */ 0},
+	    {/* config      = */ Config::Lighting,
+	     /* description = */ "Lighting",
+	     /* options     = */ {"All lights", "Clustered"},
 	     /* value       = */ 0}};
 };
 
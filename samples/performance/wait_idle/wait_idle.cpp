@@ -29,8 +29,20 @@ WaitIdle::WaitIdle()
 {
 	auto &config = get_configuration();
 
-	config.insert<vkb::IntSetting>(0, wait_idle_enabled, 0);
-	config.insert<vkb::IntSetting>(1, wait_idle_enabled, 1);
+	config.insert<vkb::IntSetting>(0, sync_mode, Fences);
+	config.insert<vkb::IntSetting>(1, sync_mode, WaitIdle);
+	config.insert<vkb::IntSetting>(2, sync_mode, TimelineSemaphores);
+}
+
+uint32_t WaitIdle::get_api_version() const
+{
+	// The timeline semaphores of the framework use the Vulkan 1.2 entry points
+	return VK_API_VERSION_1_2;
+}
+
+void WaitIdle::request_gpu_features(vkb::core::PhysicalDeviceC &gpu)
+{
+	timeline_semaphore_supported = REQUEST_OPTIONAL_FEATURE(gpu, VkPhysicalDeviceVulkan12Features, timelineSemaphore);
 }
 
 bool WaitIdle::prepare(const vkb::ApplicationOptions &options)
@@ -64,11 +76,11 @@ bool WaitIdle::prepare(const vkb::ApplicationOptions &options)
 
 void WaitIdle::create_render_context()
 {
-	set_render_context(std::make_unique<CustomRenderContext>(get_device(), get_surface(), *window, wait_idle_enabled));
+	set_render_context(std::make_unique<CustomRenderContext>(get_device(), get_surface(), *window, sync_mode, timeline_semaphore_supported));
 }
 
-WaitIdle::CustomRenderContext::CustomRenderContext(vkb::core::DeviceC &device, VkSurfaceKHR surface, const vkb::Window &window, int &wait_idle_enabled) :
-    RenderContext(device, surface, window), wait_idle_enabled(wait_idle_enabled)
+WaitIdle::CustomRenderContext::CustomRenderContext(vkb::core::DeviceC &device, VkSurfaceKHR surface, const vkb::Window &window, int &sync_mode, bool timeline_semaphore_supported) :
+    RenderContext(device, surface, window), sync_mode(sync_mode), timeline_semaphore_supported(timeline_semaphore_supported)
 {}
 
 void WaitIdle::CustomRenderContext::wait_frame()
@@ -76,30 +88,42 @@ void WaitIdle::CustomRenderContext::wait_frame()
 	// POI
 	//
 	// If wait idle is enabled, wait using vkDeviceWaitIdle
+	// Otherwise the frame waits for its fences, or for the values its submissions signaled on the timeline semaphores
 
 	vkb::rendering::RenderFrameC &frame = get_active_frame();
 
-	if (wait_idle_enabled)
+	if (sync_mode == WaitIdle)
 	{
 		get_device().wait_idle();
 	}
 
 	frame.reset();
+
+	// Devices without timeline semaphores keep using fences
+	set_timeline_semaphore_sync(sync_mode == TimelineSemaphores && timeline_semaphore_supported);
 }
 
 void WaitIdle::draw_gui()
 {
 	bool     landscape = camera->get_aspect_ratio() > 1.0f;
-	uint32_t lines     = landscape ? 1 : 2;
+	uint32_t lines     = landscape ? 1 : (timeline_semaphore_supported ? 3 : 2);
 
 	get_gui().show_options_window(
 	    /* body = */ [&]() {
-		    ImGui::RadioButton("Wait Idle", &wait_idle_enabled, 1);
+		    ImGui::RadioButton("Wait Idle", &sync_mode, WaitIdle);
 		    if (landscape)
 		    {
 			    ImGui::SameLine();
 		    }
-		    ImGui::RadioButton("Fences", &wait_idle_enabled, 0);
+		    ImGui::RadioButton("Fences", &sync_mode, Fences);
+		    if (timeline_semaphore_supported)
+		    {
+			    if (landscape)
+			    {
+				    ImGui::SameLine();
+			    }
+			    ImGui::RadioButton("Timeline semaphores", &sync_mode, TimelineSemaphores);
+		    }
 	    },
 	    /* lines = */ lines);
 }
@@ -31,19 +31,31 @@ class WaitIdle : public vkb::VulkanSampleC
 
 	virtual bool prepare(const vkb::ApplicationOptions &options) override;
 
+	/**
+	 * @brief The ways of waiting for a frame which the sample compares
+	 */
+	enum SyncMode : int
+	{
+		Fences             = 0,
+		WaitIdle           = 1,
+		TimelineSemaphores = 2
+	};
+
 	/**
 	 * @brief This RenderContext is responsible containing the scene's RenderFrames
-	 *		  It implements a custom wait_frame function which alternates between waiting with WaitIdle or Fences
+	 *		  It implements a custom wait_frame function which alternates between waiting with WaitIdle, Fences or Timeline semaphores
 	 */
 	class CustomRenderContext : public vkb::rendering::RenderContextC
 	{
 	  public:
-		CustomRenderContext(vkb::core::DeviceC &device, VkSurfaceKHR surface, const vkb::Window &window, int &wait_idle_enabled);
+		CustomRenderContext(vkb::core::DeviceC &device, VkSurfaceKHR surface, const vkb::Window &window, int &sync_mode, bool timeline_semaphore_supported);
 
 		virtual void wait_frame() override;
 
 	  private:
-		int &wait_idle_enabled;
+		int &sync_mode;
+
+		bool timeline_semaphore_supported;
 	};
 
 	virtual void create_render_context() override;
@@ -51,9 +63,15 @@ class WaitIdle : public vkb::VulkanSampleC
   private:
 	vkb::sg::PerspectiveCamera *camera{nullptr};
 
+	virtual uint32_t get_api_version() const override;
+
+	virtual void request_gpu_features(vkb::core::PhysicalDeviceC &gpu) override;
+
 	virtual void draw_gui() override;
 
-	int wait_idle_enabled{0};
+	int sync_mode{Fences};
+
+	bool timeline_semaphore_supported{false};
 };
 
 std::unique_ptr<vkb::VulkanSampleC> create_wait_idle();
@@ -0,0 +1,121 @@
+#version 450
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+precision highp float;
+
+// Lighting pass of ClusteredLightingSubpass, applying only the lights assigned to the cluster of each pixel
+// by deferred/cluster_lights.comp
+
+layout(input_attachment_index = 0, binding = 0) uniform subpassInput i_depth;
+layout(input_attachment_index = 1, binding = 1) uniform subpassInput i_albedo;
+layout(input_attachment_index = 2, binding = 2) uniform subpassInput i_normal;
+
+layout(location = 0) in vec2 in_uv;
+layout(location = 0) out vec4 o_color;
+
+#include "lighting.h"
+
+layout(set = 0, binding = 3) uniform ClusterUniform
+{
+	mat4  inv_view_proj;
+	mat4  view;
+	mat4  inv_proj;
+	vec2  inv_resolution;
+	vec2  depth_range;
+	uvec4 grid;
+	uvec4 light_counts;
+}
+cluster_uniform;
+
+layout(std430, set = 0, binding = 4) readonly buffer Lights
+{
+	Light lights[];
+};
+
+layout(std430, set = 0, binding = 5) readonly buffer ClusterLightCounts
+{
+	uint cluster_light_counts[];
+};
+
+layout(std430, set = 0, binding = 6) readonly buffer ClusterLightIndices
+{
+	uint cluster_light_indices[];
+};
+
+// Fades the lights out towards their range, so that culling them outside of it leaves no visible edge
+float range_window(Light light, vec3 pos)
+{
+	float range = light.direction.w;
+	if (range <= 0.0)
+	{
+		return 1.0;
+	}
+	float ratio = length(light.position.xyz - pos) / range;
+	float fade  = clamp(1.0 - ratio * ratio * ratio * ratio, 0.0, 1.0);
+	return fade * fade;
+}
+
+uint get_cluster(vec3 pos)
+{
+	uvec4 grid     = cluster_uniform.grid;
+	float near     = cluster_uniform.depth_range.x;
+	float far      = cluster_uniform.depth_range.y;
+	float distance = -(cluster_uniform.view * vec4(pos, 1.0)).z;
+
+	uvec2 tile  = min(uvec2(gl_FragCoord.xy) / grid.w, grid.xy - 1u);
+	uint  slice = uint(clamp(log(max(distance, near) / near) / log(far / near) * float(grid.z), 0.0, float(grid.z - 1u)));
+
+	return tile.x + grid.x * (tile.y + grid.y * slice);
+}
+
+void main()
+{
+	// Retrieve position from depth
+	vec4       clip    = vec4(in_uv * 2.0 - 1.0, subpassLoad(i_depth).x, 1.0);
+	highp vec4 world_w = cluster_uniform.inv_view_proj * clip;
+	highp vec3 pos     = world_w.xyz / world_w.w;
+	vec4       albedo  = subpassLoad(i_albedo);
+	// Transform from [0,1] to [-1,1]
+	vec3 normal = subpassLoad(i_normal).xyz;
+	normal      = normalize(2.0 * normal - 1.0);
+	// Calculate lighting
+	vec3 L = vec3(0.0);
+	for (uint i = 0U; i < cluster_uniform.light_counts.x; ++i)
+	{
+		L += apply_directional_light(lights[i], normal);
+	}
+	uint cluster     = get_cluster(pos);
+	uint first_index = cluster * cluster_uniform.light_counts.w;
+	uint count       = cluster_light_counts[cluster];
+	for (uint i = 0U; i < count; ++i)
+	{
+		uint  light_index = cluster_light_indices[first_index + i];
+		Light light       = lights[light_index];
+		// Point lights are stored before spot lights
+		if (light_index < cluster_uniform.light_counts.y)
+		{
+			L += apply_point_light(light, pos, normal) * range_window(light, pos);
+		}
+		else
+		{
+			L += apply_spot_light(light, pos, normal) * range_window(light, pos);
+		}
+	}
+	vec3 ambient_color = vec3(0.2) * albedo.xyz;
+
+	o_color = vec4(ambient_color + L * albedo.xyz, 1.0);
+}
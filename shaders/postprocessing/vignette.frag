@@ -0,0 +1,36 @@
+#version 450
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+precision highp float;
+
+layout(set = 0, binding = 1) uniform sampler2D color_sampler;
+
+layout(location = 0) in vec2 in_uv;
+
+layout(location = 0) out vec4 o_color;
+
+#define INNER_RADIUS 0.45
+#define OUTER_RADIUS 0.85
+
+void main(void)
+{
+	const vec2 center_coord = vec2(0.5);
+	const float vignette    = 1.0 - smoothstep(INNER_RADIUS, OUTER_RADIUS, length(in_uv - center_coord));
+
+	o_color = vec4(texture(color_sampler, in_uv).rgb * vignette, 1.0);
+}